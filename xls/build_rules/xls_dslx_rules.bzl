@@ -109,6 +109,7 @@ def _get_dslx_test_cmdline(ctx, src, all_srcs, append_cmd_line_args = True):
         "enable_warnings",
         "max_ticks",
         "format_preference",
+        "quickcheck_jobs",
     )
 
     dslx_test_args = dict(_dslx_test_args)
@@ -304,10 +305,12 @@ xls_dslx_test_common_attrs = {
     ),
     "evaluator": attr.string(
         default = "dslx-interpreter",
-        values = ["dslx-interpreter", "ir-jit", "ir-interpreter"],
+        values = ["dslx-interpreter", "ir-jit", "ir-jit-with-fallback", "ir-interpreter"],
         doc = "What type of evaluator to use. 'ir-jit' will execute the tests faster " +
-              "but has higher startup time and less helpful failure messages. Options: " +
-              '["dslx-interpreter" (default), "ir-jit", "ir-interpreter"]. Note: The ' +
+              "but has higher startup time. 'ir-jit-with-fallback' is 'ir-jit' but runs " +
+              "tests that cannot be converted to IR in the DSLX interpreter. Options: " +
+              '["dslx-interpreter" (default), "ir-jit", "ir-jit-with-fallback", ' +
+              '"ir-interpreter"]. Note: The ' +
               "'compare' dslx_test_arg is only available with the default 'dslx-interpreter' " +
               "evaluator.",
     ),
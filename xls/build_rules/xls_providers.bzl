@@ -125,6 +125,12 @@ CODEGEN_FIELDS = {
                                 "omit these assertions.",
     "register_merge_strategy": "The strategy to use for merging registers. Either " +
                                "'IdentityOnly' or 'None'",
+    "retime_registers": "If true, retime pipeline registers across logic to " +
+                        "reduce the number of register bits without lengthening " +
+                        "the critical path.",
+    "codegen_threads": "Number of threads used to emit the Verilog of the " +
+                       "blocks in parallel (default 1). Only emission is " +
+                       "parallel. Zero uses one thread per available CPU.",
     "emit_sv_types": "Whether or not to honor the #[sv_type(NAME)] annotations in the source DSLX.",
     "codegen_version": "Version of codegen to use (0=default).",
     "fifo_module": "If provided, instantiates the provided module where (positive " +
@@ -189,6 +195,13 @@ SCHEDULING_FIELDS = {
                                            "be worth adding up to 1024 flops. Only relevant if " +
                                            "using the SDC scheduler with --worst_case_throughput " +
                                            "set to a value != 1.",
+    "area_objective_model": "If set, the SDC scheduler minimizes the estimated area of " +
+                            "the pipeline registers (and of data held in flight on " +
+                            "channels between synchronous procs) using this area model, " +
+                            "rather than only their bit count. e.g., `asap7`.",
+    "area_objective_weight": "Weight of the area terms (in square microns) relative to " +
+                             "the register bit-count terms in the scheduling objective. " +
+                             "Only relevant if --area_objective_model is set.",
     "additional_input_delay_ps": "The additional delay added to each input. Note that " +
                                  "flow-controlled channel operations all have inputs and " +
                                  "outputs, so this delay is added to sends and receives.",
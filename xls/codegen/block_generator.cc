@@ -18,6 +18,7 @@
 #include <array>
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <optional>
 #include <random>
 #include <string>
@@ -36,6 +37,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
+#include "absl/synchronization/mutex.h"
 #include "absl/types/span.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_residual_data.pb.h"
@@ -52,6 +54,7 @@
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/block.h"
 #include "xls/ir/format_preference.h"
@@ -1109,6 +1112,113 @@ absl::Status DfsVisitBlocks(Block* block, absl::flat_hash_set<Block*>& visited,
   return absl::OkStatus();
 }
 
+// The output of generating a single block into its own VerilogFile.
+struct GeneratedBlock {
+  bool done = false;
+  absl::Status status;
+  // Text emitted by a worker thread which has not yet been written to the
+  // output sink.
+  std::string pending_text;
+  // Line information for the block. Line numbers are relative to the start of
+  // the block. Only populated if a line map is requested in which case `file`
+  // is kept alive as it owns the nodes referred to by `line_info`.
+  LineInfo line_info;
+  std::unique_ptr<VerilogFile> file;
+  CodegenResidualData residual_data;
+};
+
+// A sink used by worker threads which hands the text of a block over to the
+// thread writing the output in chunks of (at least) `kChunkSize` bytes.
+class PendingTextVastSink final : public VastSink {
+ public:
+  PendingTextVastSink(absl::Mutex& mutex, GeneratedBlock& block)
+      : mutex_(mutex), block_(block) {}
+
+  void Write(std::string_view text) final {
+    absl::StrAppend(&buffer_, text);
+    if (buffer_.size() >= kChunkSize) {
+      Flush();
+    }
+  }
+
+  void Flush() {
+    absl::MutexLock lock(&mutex_);
+    absl::StrAppend(&block_.pending_text, buffer_);
+    buffer_.clear();
+  }
+
+ private:
+  static constexpr int64_t kChunkSize = 64 * 1024;
+
+  absl::Mutex& mutex_;
+  GeneratedBlock& block_;
+  std::string buffer_;
+};
+
+// A sink which forwards text to `sink` and counts the lines written.
+class LineCountingVastSink final : public VastSink {
+ public:
+  explicit LineCountingVastSink(VastSink& sink) : sink_(sink) {}
+
+  void Write(std::string_view text) final {
+    line_count_ += absl::c_count(text, '\n');
+    sink_.Write(text);
+  }
+
+  int64_t line_count() const { return line_count_; }
+
+ private:
+  VastSink& sink_;
+  int64_t line_count_ = 0;
+};
+
+absl::Status GenerateBlock(Block* block, const CodegenOptions& options,
+                           bool generate_line_info, bool generate_residual_data,
+                           VastSink& sink, GeneratedBlock& result) {
+  auto file = std::make_unique<VerilogFile>(options.use_system_verilog()
+                                                ? FileType::kSystemVerilog
+                                                : FileType::kVerilog);
+  XLS_RETURN_IF_ERROR(BlockGenerator::Generate(
+      block, file.get(), options,
+      generate_residual_data ? &result.residual_data : nullptr));
+  file->EmitTo(sink, generate_line_info ? &result.line_info : nullptr);
+  if (generate_line_info) {
+    result.file = std::move(file);
+  }
+  return absl::OkStatus();
+}
+
+// Adds the mappings from source locations to Verilog lines in `line_info` to
+// `verilog_line_map`. The Verilog lines are offset by `line_offset`.
+absl::Status AddLineMappings(Block* top, const LineInfo& line_info,
+                             int64_t line_offset,
+                             VerilogLineMap* verilog_line_map) {
+  for (const VastNode* vast_node : line_info.nodes()) {
+    std::optional<std::vector<LineSpan>> spans =
+        line_info.LookupNode(vast_node);
+    if (!spans.has_value()) {
+      return absl::InternalError("Unbalanced calls to LineInfo::{Start, End}");
+    }
+    for (const LineSpan& span : spans.value()) {
+      SourceInfo info = vast_node->loc();
+      for (const SourceLocation& loc : info.locations) {
+        int64_t line = static_cast<int32_t>(loc.lineno());
+        VerilogLineMapping* mapping = verilog_line_map->add_mapping();
+        mapping->set_source_file(
+            top->package()->GetFilename(loc.fileno()).value_or(""));
+        mapping->mutable_source_span()->set_line_start(line);
+        mapping->mutable_source_span()->set_line_end(line);
+        mapping->set_verilog_file("");  // to be updated later on
+        mapping->mutable_verilog_span()->set_line_start(span.StartLine() +
+                                                        line_offset);
+        mapping->mutable_verilog_span()->set_line_end(span.EndLine() +
+                                                      line_offset);
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
 // Return the blocks instantiated by the given top-level block. This includes
 // blocks transitively instantiated. In the returned vector, an instantiated
 // block will always appear before the instantiating block (DFS post order).
@@ -1121,9 +1231,9 @@ absl::StatusOr<std::vector<Block*>> GatherInstantiatedBlocks(Block* top) {
 
 }  // namespace
 
-absl::StatusOr<std::string> GenerateVerilog(
-    Block* top, const CodegenOptions& options, VerilogLineMap* verilog_line_map,
-    CodegenResidualData* output_residual_data) {
+absl::Status GenerateVerilog(Block* top, const CodegenOptions& options,
+                             VastSink& sink, VerilogLineMap* verilog_line_map,
+                             CodegenResidualData* output_residual_data) {
   VLOG(2) << absl::StreamFormat(
       "Generating Verilog for packge with with top level block `%s`:",
       top->name());
@@ -1131,43 +1241,127 @@ absl::StatusOr<std::string> GenerateVerilog(
 
   XLS_ASSIGN_OR_RETURN(std::vector<Block*> blocks,
                        GatherInstantiatedBlocks(top));
-  VerilogFile file(options.use_system_verilog() ? FileType::kSystemVerilog
-                                                : FileType::kVerilog);
-  for (Block* block : blocks) {
-    XLS_RETURN_IF_ERROR(
-        BlockGenerator::Generate(block, &file, options, output_residual_data));
-    if (block != blocks.back()) {
-      file.Add(file.Make<BlankLine>(SourceInfo()));
-      file.Add(file.Make<BlankLine>(SourceInfo()));
+
+  // Blocks only read the IR and each is generated into its own VerilogFile, so
+  // the blocks are generated and emitted in parallel. The text of each block is
+  // streamed to the sink in the (deterministic) order of `blocks` as it is
+  // emitted, so the output is identical to generating the blocks serially.
+  // Workers only run `thread_count` blocks ahead of the block being written to
+  // bound the amount of text held in memory.
+  int64_t thread_count = options.codegen_threads() > 0
+                             ? options.codegen_threads()
+                             : std::max(AvailableCPUs(), 1);
+  thread_count = std::min(thread_count, static_cast<int64_t>(blocks.size()));
+  std::vector<GeneratedBlock> generated(blocks.size());
+  absl::Mutex mutex;
+  int64_t next_block = 0;
+  int64_t next_to_write = 0;
+  bool cancelled = false;
+  auto can_claim = [&]() {
+    return cancelled || next_block >= blocks.size() ||
+           next_block < next_to_write + thread_count;
+  };
+  auto worker = [&]() {
+    while (true) {
+      int64_t i;
+      {
+        absl::MutexLock lock(&mutex);
+        mutex.Await(absl::Condition(&can_claim));
+        if (cancelled || next_block >= blocks.size()) {
+          return;
+        }
+        i = next_block++;
+      }
+      PendingTextVastSink pending_sink(mutex, generated[i]);
+      absl::Status status = GenerateBlock(
+          blocks[i], options, verilog_line_map != nullptr,
+          output_residual_data != nullptr, pending_sink, generated[i]);
+      pending_sink.Flush();
+      absl::MutexLock lock(&mutex);
+      generated[i].status = std::move(status);
+      generated[i].done = true;
+    }
+  };
+
+  std::vector<std::unique_ptr<Thread>> threads;
+  if (thread_count > 1) {
+    threads.reserve(thread_count);
+    for (int64_t i = 0; i < thread_count; ++i) {
+      threads.push_back(std::make_unique<Thread>(worker));
     }
   }
 
-  LineInfo line_info;
-  std::string text = file.Emit(&line_info);
-  if (verilog_line_map != nullptr) {
-    for (const VastNode* vast_node : line_info.nodes()) {
-      std::optional<std::vector<LineSpan>> spans =
-          line_info.LookupNode(vast_node);
-      if (!spans.has_value()) {
-        return absl::InternalError(
-            "Unbalanced calls to LineInfo::{Start, End}");
-      }
-      for (const LineSpan& span : spans.value()) {
-        SourceInfo info = vast_node->loc();
-        for (const SourceLocation& loc : info.locations) {
-          int64_t line = static_cast<int32_t>(loc.lineno());
-          VerilogLineMapping* mapping = verilog_line_map->add_mapping();
-          mapping->set_source_file(
-              top->package()->GetFilename(loc.fileno()).value_or(""));
-          mapping->mutable_source_span()->set_line_start(line);
-          mapping->mutable_source_span()->set_line_end(line);
-          mapping->set_verilog_file("");  // to be updated later on
-          mapping->mutable_verilog_span()->set_line_start(span.StartLine());
-          mapping->mutable_verilog_span()->set_line_end(span.EndLine());
+  absl::Status status = absl::OkStatus();
+  LineCountingVastSink output(sink);
+  for (int64_t i = 0; i < blocks.size(); ++i) {
+    GeneratedBlock& block = generated[i];
+    int64_t line_offset = output.line_count();
+    if (threads.empty()) {
+      status = GenerateBlock(blocks[i], options, verilog_line_map != nullptr,
+                             output_residual_data != nullptr, output, block);
+    } else {
+      // Forward the text of the block as the worker produces it.
+      auto has_text = [&block]() {
+        return block.done || !block.pending_text.empty();
+      };
+      bool done = false;
+      while (!done) {
+        std::string text;
+        {
+          absl::MutexLock lock(&mutex);
+          mutex.Await(absl::Condition(&has_text));
+          text.swap(block.pending_text);
+          done = block.done;
+          if (done) {
+            status = block.status;
+          }
         }
+        output.Write(text);
+      }
+    }
+    if (!status.ok()) {
+      break;
+    }
+    if (i + 1 != blocks.size()) {
+      // Separate modules with two blank lines.
+      output.Write("\n\n");
+    }
+    if (verilog_line_map != nullptr) {
+      status = AddLineMappings(top, block.line_info, line_offset,
+                               verilog_line_map);
+      if (!status.ok()) {
+        break;
+      }
+    }
+    if (output_residual_data != nullptr) {
+      for (BlockResidualData& block_data :
+           *block.residual_data.mutable_blocks()) {
+        *output_residual_data->add_blocks() = std::move(block_data);
       }
     }
+
+    // Release the block eagerly and let the workers move on to the next one.
+    absl::MutexLock lock(&mutex);
+    block = GeneratedBlock{.done = true};
+    ++next_to_write;
+  }
+  {
+    absl::MutexLock lock(&mutex);
+    cancelled = true;
   }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+  return status;
+}
+
+absl::StatusOr<std::string> GenerateVerilog(
+    Block* top, const CodegenOptions& options, VerilogLineMap* verilog_line_map,
+    CodegenResidualData* output_residual_data) {
+  StringVastSink sink;
+  XLS_RETURN_IF_ERROR(GenerateVerilog(top, options, sink, verilog_line_map,
+                                      output_residual_data));
+  std::string text = std::move(sink).Release();
 
   VLOG(2) << "Verilog output:";
   XLS_VLOG_LINES(2, text);
@@ -17,9 +17,11 @@
 
 #include <string>
 
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_residual_data.pb.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/ir/block.h"
 
@@ -31,11 +33,26 @@ namespace verilog {
 // block as well as module definitions for any instantiated blocks. Line map
 // and residual data will be written out if the corressponding pointers are not
 // null.
+//
+// The Verilog of independent blocks is emitted in parallel on up to
+// `options.codegen_threads()` threads (one by default). The output does not
+// depend on the number of threads used: modules are always emitted in a fixed
+// order with each instantiated block emitted before the blocks that
+// instantiate it.
 absl::StatusOr<std::string> GenerateVerilog(
     Block* top, const CodegenOptions& options,
     VerilogLineMap* verilog_line_map = nullptr,
     CodegenResidualData* output_residual_data = nullptr);
 
+// As above, but writes the (System)Verilog text to `sink` as it is emitted
+// instead of returning it. The text of the generated file is never held in
+// memory in its entirety, which reduces peak memory for large designs. If an
+// error is returned `sink` may have received a partial output.
+absl::Status GenerateVerilog(
+    Block* top, const CodegenOptions& options, VastSink& sink,
+    VerilogLineMap* verilog_line_map = nullptr,
+    CodegenResidualData* output_residual_data = nullptr);
+
 }  // namespace verilog
 }  // namespace xls
 
@@ -41,11 +41,13 @@
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_pass.h"
 #include "xls/codegen/codegen_pass_pipeline.h"
+#include "xls/codegen/codegen_residual_data.pb.h"
 #include "xls/codegen/codegen_result.h"
 #include "xls/codegen/module_signature.h"
 #include "xls/codegen/op_override.h"
 #include "xls/codegen/signature_generator.h"
 #include "xls/codegen/test_fifos.h"
+#include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/status/matchers.h"
 #include "xls/common/status/ret_check.h"
@@ -90,6 +92,7 @@ namespace verilog {
 namespace {
 
 using ::absl_testing::StatusIs;
+using ::testing::ElementsAreArray;
 using ::testing::HasSubstr;
 
 constexpr char kTestName[] = "block_generator_test";
@@ -1187,6 +1190,75 @@ TEST_P(BlockGeneratorTest, MultiplyInstantiatedBlock) {
   XLS_ASSERT_OK(tb->Run());
 }
 
+TEST_P(BlockGeneratorTest, ManyInstantiatedBlocksEmittedInOrder) {
+  // Enough blocks that they are generated concurrently. The output must not
+  // depend on the order in which the blocks finish generating.
+  constexpr int64_t kBlockCount = 16;
+  Package package(TestBaseName());
+  Type* u32 = package.GetBitsType(32);
+
+  BlockBuilder bb("my_block", &package);
+  BValue x = bb.InputPort("x", u32);
+  BValue y = bb.InputPort("y", u32);
+  std::vector<std::string> expected_block_names;
+  for (int64_t i = 0; i < kBlockCount; ++i) {
+    std::string name = absl::StrCat("subtractor", i);
+    XLS_ASSERT_OK_AND_ASSIGN(Block * sub_block,
+                             MakeSubtractBlock(name, &package));
+    XLS_ASSERT_OK_AND_ASSIGN(
+        xls::Instantiation * instantiation,
+        bb.block()->AddBlockInstantiation(absl::StrCat("sub", i), sub_block));
+    bb.InstantiationInput(instantiation, "a", x);
+    bb.InstantiationInput(instantiation, "b", y);
+    bb.OutputPort(absl::StrCat("out", i),
+                  bb.InstantiationOutput(instantiation, "result"));
+    expected_block_names.push_back(name);
+  }
+  expected_block_names.push_back("my_block");
+  XLS_ASSERT_OK_AND_ASSIGN(Block * block, bb.Build());
+
+  CodegenResidualData residual_data;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::string verilog,
+      GenerateVerilog(block, codegen_options(), /*verilog_line_map=*/nullptr,
+                      &residual_data));
+
+  std::vector<std::string> block_names;
+  for (const BlockResidualData& block_data : residual_data.blocks()) {
+    block_names.push_back(block_data.block_name());
+  }
+  EXPECT_THAT(block_names, ElementsAreArray(expected_block_names));
+
+  // Modules appear in the text in the same order as the residual data.
+  std::string::size_type last_position = 0;
+  for (const std::string& name : expected_block_names) {
+    std::string::size_type position =
+        verilog.find(absl::StrCat("module ", name, "("));
+    ASSERT_NE(position, std::string::npos) << name;
+    EXPECT_GE(position, last_position) << name;
+    last_position = position;
+  }
+
+  // The output, including the line map, is the same for any number of
+  // threads, from serial generation to more threads than blocks.
+  CodegenOptions options = codegen_options();
+  VerilogLineMap serial_line_map;
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::string serial_verilog,
+      GenerateVerilog(block, options.codegen_threads(1), &serial_line_map));
+  EXPECT_EQ(serial_verilog, verilog);
+  for (int64_t threads : {0, 2, 3, 64}) {
+    VerilogLineMap line_map;
+    XLS_ASSERT_OK_AND_ASSIGN(
+        std::string again,
+        GenerateVerilog(block, options.codegen_threads(threads), &line_map));
+    EXPECT_EQ(again, verilog) << threads;
+    EXPECT_EQ(line_map.SerializeAsString(),
+              serial_line_map.SerializeAsString())
+        << threads;
+  }
+}
+
 TEST_P(BlockGeneratorTest, InstantiatedBlockWithArrayPorts) {
   Package package(TestBaseName());
   Type* u32 = package.GetBitsType(32);
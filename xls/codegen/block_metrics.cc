@@ -25,7 +25,9 @@
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
+#include "xls/codegen/codegen_pass.h"
 #include "xls/codegen/xls_metrics.pb.h"
+#include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/block.h"
@@ -369,4 +371,19 @@ absl::StatusOr<BlockMetricsProto> GenerateBlockMetrics(
   return proto;
 }
 
+absl::StatusOr<BlockMetricsProto> GenerateTopBlockMetrics(
+    CodegenContext& context, const DelayEstimator* delay_estimator) {
+  XLS_RET_CHECK_NE(context.top_block(), nullptr);
+  XLS_ASSIGN_OR_RETURN(BlockMetricsProto proto,
+                       GenerateBlockMetrics(context.top_block(),
+                                            delay_estimator));
+  if (std::optional<int64_t> flop_count_before_retiming =
+          context.GetMetadataForBlock(context.top_block())
+              .flop_count_before_retiming;
+      flop_count_before_retiming.has_value()) {
+    proto.set_flop_count_before_retiming(*flop_count_before_retiming);
+  }
+  return proto;
+}
+
 }  // namespace xls::verilog
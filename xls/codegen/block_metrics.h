@@ -17,6 +17,7 @@
 
 
 #include "absl/status/statusor.h"
+#include "xls/codegen/codegen_pass.h"
 #include "xls/codegen/xls_metrics.pb.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/block.h"
@@ -30,6 +31,12 @@ namespace xls::verilog {
 absl::StatusOr<BlockMetricsProto> GenerateBlockMetrics(
     Block* block, const DelayEstimator* delay_estimator = nullptr);
 
+// As above, for the top block of `context`. Also includes the metrics recorded
+// in the block's codegen metadata by the codegen passes (e.g., the number of
+// register bits before retiming).
+absl::StatusOr<BlockMetricsProto> GenerateTopBlockMetrics(
+    CodegenContext& context, const DelayEstimator* delay_estimator = nullptr);
+
 }  // namespace xls::verilog
 
 #endif  // XLS_CODEGEN_BLOCK_METRICS_H_
@@ -222,6 +222,16 @@ CodegenOptions& CodegenOptions::register_merge_strategy(
   return *this;
 }
 
+CodegenOptions& CodegenOptions::retime_registers(bool value) {
+  retime_registers_ = value;
+  return *this;
+}
+
+CodegenOptions& CodegenOptions::codegen_threads(int64_t value) {
+  codegen_threads_ = value;
+  return *this;
+}
+
 CodegenOptions& CodegenOptions::add_invariant_assertions(bool value) {
   add_invariant_assertions_ = value;
   return *this;
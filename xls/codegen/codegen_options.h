@@ -269,6 +269,19 @@ class CodegenOptions {
     return register_merge_strategy_;
   }
 
+  // Whether to retime pipeline registers across logic to reduce the number of
+  // register bits. Registers are only moved if the move does not lengthen the
+  // critical path as measured by the delay estimator given to codegen.
+  CodegenOptions& retime_registers(bool value);
+  bool retime_registers() const { return retime_registers_; }
+
+  // The number of threads used to emit the Verilog for the blocks of a design
+  // in parallel. Only emission is parallel; the IR is lowered to blocks
+  // serially beforehand. The default of one emits the blocks serially on the
+  // calling thread; zero uses one thread per available CPU.
+  CodegenOptions& codegen_threads(int64_t value);
+  int64_t codegen_threads() const { return codegen_threads_; }
+
   int64_t max_trace_verbosity() const { return max_trace_verbosity_; }
   CodegenOptions& set_max_trace_verbosity(int64_t value) {
     max_trace_verbosity_ = value;
@@ -396,6 +409,8 @@ class CodegenOptions {
   int64_t max_trace_verbosity_ = 0;
   RegisterMergeStrategy register_merge_strategy_ =
       RegisterMergeStrategy::kDefault;
+  bool retime_registers_ = false;
+  int64_t codegen_threads_ = 1;
   std::optional<PackageInterfaceProto> package_interface_;
   std::vector<std::string> includes_;
   bool emit_sv_types_ = true;
@@ -302,6 +302,10 @@ struct CodegenMetadata {
   // If absent all stages should be considered potentially concurrently active
   // with one another.
   std::optional<ConcurrentStageGroups> concurrent_stages;
+
+  // Number of register bits in the block before registers were retimed. Only
+  // set if retiming changed the block.
+  std::optional<int64_t> flop_count_before_retiming;
 };
 
 // Mutable context data structure operated on by codegen passes.
@@ -33,6 +33,7 @@
 #include "xls/codegen/ram_rewrite_pass.h"
 #include "xls/codegen/register_combining_pass.h"
 #include "xls/codegen/register_legalization_pass.h"
+#include "xls/codegen/register_retiming_pass.h"
 #include "xls/codegen/side_effect_condition_pass.h"
 #include "xls/codegen/signature_generation_pass.h"
 #include "xls/codegen/trace_verbosity_pass.h"
@@ -98,6 +99,10 @@ std::unique_ptr<CodegenCompoundPass> CreateCodegenPassPipeline(
   // Deduplicate registers across mutually exclusive stages.
   top->Add<RegisterCombiningPass>();
 
+  // Move pipeline registers across logic where doing so reduces register bits
+  // without lengthening the critical path.
+  top->Add<RegisterRetimingPass>();
+
   // Remove any identity ops which might have been added earlier in the
   // pipeline.
   top->Add<CodegenWrapperPass>(std::make_unique<IdentityRemovalPass>(),
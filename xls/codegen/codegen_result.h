@@ -27,6 +27,8 @@ namespace xls::verilog {
 
 // Data structure gathering together all the artifacts created by codegen.
 struct CodegenResult {
+  // The generated Verilog. Empty if codegen was given a `VastSink`, in which
+  // case the text went to the sink instead.
   std::string verilog_text;
   VerilogLineMap verilog_line_map;
   ModuleSignature signature;
@@ -15,7 +15,7 @@
 #include "xls/codegen/combinational_generator.h"
 
 #include <optional>
-#include <string>
+#include <utility>
 
 #include "absl/status/statusor.h"
 #include "xls/codegen/block_conversion.h"
@@ -27,6 +27,7 @@
 #include "xls/codegen/codegen_residual_data.pb.h"
 #include "xls/codegen/codegen_result.h"
 #include "xls/codegen/module_signature.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/codegen/xls_metrics.pb.h"
 #include "xls/common/status/ret_check.h"
@@ -41,7 +42,7 @@ namespace verilog {
 
 absl::StatusOr<CodegenResult> GenerateCombinationalModule(
     FunctionBase* module, const CodegenOptions& options,
-    const DelayEstimator* delay_estimator) {
+    const DelayEstimator* delay_estimator, VastSink* verilog_sink) {
   XLS_ASSIGN_OR_RETURN(CodegenContext context,
                        FunctionBaseToCombinationalBlock(module, options));
 
@@ -61,9 +62,11 @@ absl::StatusOr<CodegenResult> GenerateCombinationalModule(
   XLS_RET_CHECK(context.top_block()->GetSignature().has_value());
   VerilogLineMap verilog_line_map;
   CodegenResidualData residual_data;
-  XLS_ASSIGN_OR_RETURN(std::string verilog,
-                       GenerateVerilog(context.top_block(), options,
-                                       &verilog_line_map, &residual_data));
+  StringVastSink string_sink;
+  XLS_RETURN_IF_ERROR(GenerateVerilog(
+      context.top_block(), options,
+      verilog_sink != nullptr ? *verilog_sink : string_sink, &verilog_line_map,
+      &residual_data));
 
   XLS_ASSIGN_OR_RETURN(
       ModuleSignature signature,
@@ -76,7 +79,7 @@ absl::StatusOr<CodegenResult> GenerateCombinationalModule(
 
   // TODO: google/xls#1323 - add all block signatures to ModuleGeneratorResult,
   // not just top.
-  return CodegenResult{.verilog_text = verilog,
+  return CodegenResult{.verilog_text = std::move(string_sink).Release(),
                        .verilog_line_map = verilog_line_map,
                        .signature = signature,
                        .block_metrics = metrics,
@@ -18,6 +18,7 @@
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_result.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/node.h"
 
@@ -28,9 +29,12 @@ namespace verilog {
 // use_system_verilog is true the generated module will be SystemVerilog
 // otherwise it will be Verilog. This adds a proc to the package which
 // represents the combinational module. This proc is used for code generation.
+// If `verilog_sink` is provided the Verilog text is written to it as it is
+// generated rather than returned in the `verilog_text` field of the result.
 absl::StatusOr<CodegenResult> GenerateCombinationalModule(
     FunctionBase* module, const CodegenOptions& options,
-    const DelayEstimator* delay_estimator = nullptr);
+    const DelayEstimator* delay_estimator = nullptr,
+    VastSink* verilog_sink = nullptr);
 
 }  // namespace verilog
 }  // namespace xls
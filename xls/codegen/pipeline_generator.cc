@@ -16,7 +16,6 @@
 
 #include <memory>
 #include <optional>
-#include <string>
 #include <utility>
 
 #include "absl/algorithm/container.h"
@@ -32,6 +31,7 @@
 #include "xls/codegen/codegen_residual_data.pb.h"
 #include "xls/codegen/codegen_result.h"
 #include "xls/codegen/module_signature.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/codegen/xls_metrics.pb.h"
 #include "xls/common/logging/log_lines.h"
@@ -49,7 +49,8 @@ namespace verilog {
 
 absl::StatusOr<CodegenResult> ToPipelineModuleText(
     const PipelineSchedule& schedule, FunctionBase* module,
-    const CodegenOptions& options, const DelayEstimator* delay_estimator) {
+    const CodegenOptions& options, const DelayEstimator* delay_estimator,
+    VastSink* verilog_sink) {
   VLOG(2) << "Generating pipelined module for module:";
   XLS_VLOG_LINES(2, module->DumpIr());
   XLS_VLOG_LINES(2, schedule.ToString());
@@ -84,24 +85,24 @@ absl::StatusOr<CodegenResult> ToPipelineModuleText(
 
   VerilogLineMap verilog_line_map;
   CodegenResidualData residual_data;
-  XLS_ASSIGN_OR_RETURN(
-      std::string verilog,
-      GenerateVerilog(context.top_block(), pass_options.codegen_options,
-                      &verilog_line_map, &residual_data));
+  StringVastSink string_sink;
+  XLS_RETURN_IF_ERROR(GenerateVerilog(
+      context.top_block(), pass_options.codegen_options,
+      verilog_sink != nullptr ? *verilog_sink : string_sink, &verilog_line_map,
+      &residual_data));
 
   XLS_ASSIGN_OR_RETURN(
       ModuleSignature signature,
       ModuleSignature::FromProto(*context.top_block()->GetSignature()));
 
   XlsMetricsProto metrics;
-  XLS_ASSIGN_OR_RETURN(
-      *metrics.mutable_block_metrics(),
-      GenerateBlockMetrics(context.top_block(), delay_estimator));
+  XLS_ASSIGN_OR_RETURN(*metrics.mutable_block_metrics(),
+                       GenerateTopBlockMetrics(context, delay_estimator));
 
   // TODO: google/xls#1323 - add all block signatures to ModuleGeneratorResult,
   // not just top.
   return CodegenResult{
-      .verilog_text = verilog,
+      .verilog_text = std::move(string_sink).Release(),
       .verilog_line_map = verilog_line_map,
       .signature = signature,
       .block_metrics = metrics,
@@ -112,7 +113,8 @@ absl::StatusOr<CodegenResult> ToPipelineModuleText(
 
 absl::StatusOr<CodegenResult> ToPipelineModuleText(
     const PackageSchedule& package_schedule, Package* package,
-    const CodegenOptions& options, const DelayEstimator* delay_estimator) {
+    const CodegenOptions& options, const DelayEstimator* delay_estimator,
+    VastSink* verilog_sink) {
   VLOG(2) << "Generating pipelined module for module:";
   XLS_VLOG_LINES(2, package->DumpIr());
   if (VLOG_IS_ON(2)) {
@@ -153,23 +155,24 @@ absl::StatusOr<CodegenResult> ToPipelineModuleText(
                 context.top_block()->GetSignature().has_value());
   VerilogLineMap verilog_line_map;
   CodegenResidualData residual_data;
-  XLS_ASSIGN_OR_RETURN(std::string verilog,
-                       GenerateVerilog(context.top_block(), options,
-                                       &verilog_line_map, &residual_data));
+  StringVastSink string_sink;
+  XLS_RETURN_IF_ERROR(GenerateVerilog(
+      context.top_block(), options,
+      verilog_sink != nullptr ? *verilog_sink : string_sink, &verilog_line_map,
+      &residual_data));
 
   XLS_ASSIGN_OR_RETURN(
       ModuleSignature signature,
       ModuleSignature::FromProto(*context.top_block()->GetSignature()));
 
   XlsMetricsProto metrics;
-  XLS_ASSIGN_OR_RETURN(
-      *metrics.mutable_block_metrics(),
-      GenerateBlockMetrics(context.top_block(), delay_estimator));
+  XLS_ASSIGN_OR_RETURN(*metrics.mutable_block_metrics(),
+                       GenerateTopBlockMetrics(context, delay_estimator));
 
   // TODO: google/xls#1323 - add all block signatures to ModuleGeneratorResult,
   // not just top.
   return CodegenResult{
-      .verilog_text = verilog,
+      .verilog_text = std::move(string_sink).Release(),
       .verilog_line_map = std::move(verilog_line_map),
       .signature = signature,
       .block_metrics = metrics,
@@ -18,6 +18,7 @@
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_result.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/package.h"
@@ -39,20 +40,25 @@ inline CodegenOptions BuildPipelineOptions() {
 // schedule. The module is pipelined with a latency and initiation interval
 // given in the signature.
 // If a delay estimator is provided, the signature also includes delay
-// information about the pipeline stages.
+// information about the pipeline stages. If `verilog_sink` is provided the
+// Verilog text is written to it as it is generated rather than returned in the
+// `verilog_text` field of the result.
 absl::StatusOr<CodegenResult> ToPipelineModuleText(
     const PipelineSchedule& schedule, FunctionBase* module,
     const CodegenOptions& options = BuildPipelineOptions(),
-    const DelayEstimator* delay_estimator = nullptr);
+    const DelayEstimator* delay_estimator = nullptr,
+    VastSink* verilog_sink = nullptr);
 
 // Emits the given package as a verilog module which follows the given
 // schedules. Modules are pipelined with a latency and initiation interval
 // given in the signature. If a delay estimator is provided, the signature also
-// includes delay information about the pipeline stages.
+// includes delay information about the pipeline stages. If `verilog_sink` is
+// provided the Verilog text is written to it rather than returned.
 absl::StatusOr<CodegenResult> ToPipelineModuleText(
     const PackageSchedule& package_schedule, Package* package,
     const CodegenOptions& options = BuildPipelineOptions(),
-    const DelayEstimator* delay_estimator = nullptr);
+    const DelayEstimator* delay_estimator = nullptr,
+    VastSink* verilog_sink = nullptr);
 
 }  // namespace verilog
 }  // namespace xls
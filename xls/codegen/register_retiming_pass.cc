@@ -0,0 +1,354 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/codegen/register_retiming_pass.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "xls/codegen/codegen_pass.h"
+#include "xls/codegen/conversion_utils.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/estimators/delay_model/delay_estimator.h"
+#include "xls/ir/block.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/register.h"
+#include "xls/ir/topo_sort.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls::verilog {
+namespace {
+
+int64_t NodeDelay(Node* node, const DelayEstimator& delay_estimator) {
+  absl::StatusOr<int64_t> delay = delay_estimator.GetOperationDelayInPs(node);
+  return delay.ok() ? *delay : 0;
+}
+
+// Returns the arrival time of each node: the longest combinational delay from
+// a register output or input port through the node. The delay of a
+// RegisterRead is the clk-to-q delay (as in block metrics).
+absl::flat_hash_map<Node*, int64_t> ComputeArrivalTimes(
+    Block* block, const DelayEstimator& delay_estimator) {
+  absl::flat_hash_map<Node*, int64_t> arrival;
+  for (Node* node : TopoSort(block)) {
+    int64_t start = 0;
+    if (!node->Is<RegisterRead>()) {
+      for (Node* operand : node->operands()) {
+        start = std::max(start, arrival.at(operand));
+      }
+    }
+    arrival[node] = start + NodeDelay(node, delay_estimator);
+  }
+  return arrival;
+}
+
+// Returns the nodes referred to by the metadata other than through the
+// node-to-stage map. These are never retimed as doing so would remove them.
+absl::flat_hash_set<Node*> GetPinnedNodes(const StreamingIOPipeline& pipeline) {
+  absl::flat_hash_set<Node*> pinned;
+  auto add = [&](const std::optional<Node*>& node) {
+    if (node.has_value()) {
+      pinned.insert(*node);
+    }
+  };
+  for (const std::vector<StreamingInput>& inputs : pipeline.inputs) {
+    for (const StreamingInput& input : inputs) {
+      add(input.GetSignalData());
+      add(input.GetSignalValid());
+      add(input.GetPredicate());
+    }
+  }
+  for (const std::vector<StreamingOutput>& outputs : pipeline.outputs) {
+    for (const StreamingOutput& output : outputs) {
+      add(output.GetData());
+      add(output.GetPredicate());
+    }
+  }
+  for (const std::optional<StateRegister>& state : pipeline.state_registers) {
+    if (!state.has_value()) {
+      continue;
+    }
+    add(state->read_predicate);
+    for (const StateRegister::NextValue& next_value : state->next_values) {
+      add(next_value.value);
+      add(next_value.predicate);
+    }
+  }
+  for (const auto* signals :
+       {&pipeline.pipeline_valid, &pipeline.stage_valid, &pipeline.stage_done}) {
+    for (const std::optional<Node*>& node : *signals) {
+      add(node);
+    }
+  }
+  return pinned;
+}
+
+bool IsRetimable(Node* node) {
+  if (OpIsSideEffecting(node->op())) {
+    return false;
+  }
+  switch (node->op()) {
+    case Op::kLiteral:
+    case Op::kGate:
+    case Op::kInputPort:
+    case Op::kOutputPort:
+    case Op::kRegisterRead:
+    case Op::kRegisterWrite:
+    case Op::kInstantiationInput:
+    case Op::kInstantiationOutput:
+      return false;
+    default:
+      break;
+  }
+  return node->GetType()->IsBits() && node->GetType()->GetFlatBitCount() > 0;
+}
+
+class BlockRetimer {
+ public:
+  BlockRetimer(Block* block, CodegenMetadata& metadata,
+               const DelayEstimator& delay_estimator,
+               std::optional<int64_t> clock_period_ps)
+      : block_(block),
+        pipeline_(metadata.streaming_io_and_pipeline),
+        delay_estimator_(delay_estimator),
+        arrival_(ComputeArrivalTimes(block, delay_estimator)),
+        pinned_(GetPinnedNodes(pipeline_)) {
+    // Never lengthen the existing critical path, but use any slack up to the
+    // scheduled clock period.
+    for (const auto& [_, arrival] : arrival_) {
+      max_delay_ps_ = std::max(max_delay_ps_, arrival);
+    }
+    if (clock_period_ps.has_value()) {
+      max_delay_ps_ = std::max(max_delay_ps_, *clock_period_ps);
+    }
+  }
+
+  absl::StatusOr<bool> Run() {
+    bool changed = false;
+    for (Stage stage = 0; stage < pipeline_.pipeline_registers.size();
+         ++stage) {
+      XLS_ASSIGN_OR_RETURN(bool stage_changed, RunOnStage(stage));
+      changed = changed || stage_changed;
+    }
+    return changed;
+  }
+
+ private:
+  // Retimes nodes in stage `stage + 1` across the pipeline registers of
+  // `stage`. Nodes are visited in topological order so chains of retimable
+  // nodes are moved in a single sweep.
+  absl::StatusOr<bool> RunOnStage(Stage stage) {
+    stage_registers_.clear();
+    for (const PipelineRegister& pr : pipeline_.pipeline_registers[stage]) {
+      stage_registers_.emplace(pr.reg, pr);
+    }
+    bool changed = false;
+    for (Node* node : TopoSort(block_)) {
+      if (removed_.contains(node)) {
+        continue;
+      }
+      XLS_ASSIGN_OR_RETURN(bool moved, MaybeRetime(node, stage));
+      changed = changed || moved;
+    }
+    return changed;
+  }
+
+  absl::StatusOr<bool> MaybeRetime(Node* node, Stage stage) {
+    auto stage_it = pipeline_.node_to_stage_map.find(node);
+    if (stage_it == pipeline_.node_to_stage_map.end() ||
+        stage_it->second != stage + 1 || !IsRetimable(node) ||
+        pinned_.contains(node)) {
+      return false;
+    }
+
+    std::vector<Node*> new_operands;
+    std::vector<PipelineRegister> operand_registers;
+    std::optional<Node*> load_enable;
+    int64_t data_arrival = 0;
+    for (Node* operand : node->operands()) {
+      if (operand->Is<Literal>()) {
+        new_operands.push_back(operand);
+        continue;
+      }
+      if (!operand->Is<RegisterRead>()) {
+        return false;
+      }
+      auto reg_it =
+          stage_registers_.find(operand->As<RegisterRead>()->GetRegister());
+      if (reg_it == stage_registers_.end()) {
+        return false;
+      }
+      const PipelineRegister& pr = reg_it->second;
+      if (pr.reg->reset_value().has_value() ||
+          pr.reg_write->reset().has_value()) {
+        return false;
+      }
+      if (operand_registers.empty()) {
+        load_enable = pr.reg_write->load_enable();
+      } else if (pr.reg_write->load_enable() != load_enable) {
+        return false;
+      }
+      new_operands.push_back(pr.reg_write->data());
+      data_arrival = std::max(data_arrival, arrival_.at(pr.reg_write->data()));
+      if (!absl::c_any_of(operand_registers, [&](const PipelineRegister& r) {
+            return r.reg == pr.reg;
+          })) {
+        operand_registers.push_back(pr);
+      }
+    }
+    if (operand_registers.empty()) {
+      return false;
+    }
+
+    // Registers which become dead once the node is retimed.
+    std::vector<PipelineRegister> freed_registers;
+    int64_t freed_bits = 0;
+    for (const PipelineRegister& pr : operand_registers) {
+      if (absl::c_all_of(pr.reg_read->users(),
+                         [&](Node* user) { return user == node; })) {
+        freed_registers.push_back(pr);
+        freed_bits += pr.reg->type()->GetFlatBitCount();
+      }
+    }
+    if (freed_bits <= node->GetType()->GetFlatBitCount()) {
+      return false;
+    }
+    int64_t new_arrival = data_arrival + NodeDelay(node, delay_estimator_);
+    if (new_arrival > max_delay_ps_) {
+      VLOG(3) << "Not retiming " << node->GetName() << ": arrival "
+              << new_arrival << "ps exceeds " << max_delay_ps_ << "ps";
+      return false;
+    }
+
+    VLOG(2) << "Retiming " << node->GetName() << " into stage " << stage
+            << " saving " << freed_bits - node->GetType()->GetFlatBitCount()
+            << " register bits";
+    XLS_ASSIGN_OR_RETURN(Node * moved, node->Clone(new_operands));
+    XLS_ASSIGN_OR_RETURN(
+        Register * reg,
+        block_->AddRegister(PipelineSignalName(node->GetName(), stage),
+                            node->GetType()));
+    XLS_ASSIGN_OR_RETURN(RegisterWrite * reg_write,
+                         block_->MakeNode<RegisterWrite>(
+                             node->loc(), moved, load_enable,
+                             /*reset=*/std::nullopt, reg));
+    XLS_ASSIGN_OR_RETURN(RegisterRead * reg_read,
+                         block_->MakeNode<RegisterRead>(node->loc(), reg));
+    XLS_RETURN_IF_ERROR(node->ReplaceUsesWith(reg_read));
+
+    PipelineRegister new_register{
+        .reg = reg, .reg_write = reg_write, .reg_read = reg_read};
+    pipeline_.pipeline_registers[stage].push_back(new_register);
+    stage_registers_.emplace(reg, new_register);
+    pipeline_.node_to_stage_map[moved] = stage;
+    pipeline_.node_to_stage_map[reg_write] = stage;
+    pipeline_.node_to_stage_map[reg_read] = stage + 1;
+    arrival_[moved] = new_arrival;
+    arrival_[reg_write] = new_arrival;
+    arrival_[reg_read] = NodeDelay(reg_read, delay_estimator_);
+
+    XLS_RETURN_IF_ERROR(RemoveNode(node));
+    for (const PipelineRegister& pr : freed_registers) {
+      XLS_RETURN_IF_ERROR(RemoveNode(pr.reg_read));
+      XLS_RETURN_IF_ERROR(RemoveNode(pr.reg_write));
+      std::erase_if(pipeline_.pipeline_registers[stage],
+                    [&](const PipelineRegister& r) { return r.reg == pr.reg; });
+      stage_registers_.erase(pr.reg);
+      XLS_RETURN_IF_ERROR(block_->RemoveRegister(pr.reg));
+    }
+    return true;
+  }
+
+  absl::Status RemoveNode(Node* node) {
+    pipeline_.node_to_stage_map.erase(node);
+    arrival_.erase(node);
+    removed_.insert(node);
+    return block_->RemoveNode(node);
+  }
+
+  Block* block_;
+  StreamingIOPipeline& pipeline_;
+  const DelayEstimator& delay_estimator_;
+  absl::flat_hash_map<Node*, int64_t> arrival_;
+  absl::flat_hash_set<Node*> pinned_;
+  int64_t max_delay_ps_ = 0;
+
+  // The pipeline registers of the stage currently being retimed.
+  absl::flat_hash_map<Register*, PipelineRegister> stage_registers_;
+
+  // Nodes removed from the block. Used to skip stale entries of a topological
+  // sort computed before the removal.
+  absl::flat_hash_set<Node*> removed_;
+};
+
+int64_t RegisterBitCount(Block* block) {
+  int64_t bits = 0;
+  for (Register* reg : block->GetRegisters()) {
+    bits += reg->type()->GetFlatBitCount();
+  }
+  return bits;
+}
+
+}  // namespace
+
+absl::StatusOr<bool> RegisterRetimingPass::RunInternal(
+    Package* package, const CodegenPassOptions& options, PassResults* results,
+    CodegenContext& context) const {
+  if (!options.codegen_options.retime_registers()) {
+    return false;
+  }
+  if (options.delay_estimator == nullptr) {
+    VLOG(2) << "Not retiming registers: no delay estimator given.";
+    return false;
+  }
+  std::optional<int64_t> clock_period_ps;
+  if (options.schedule.has_value()) {
+    clock_period_ps = options.schedule->min_clock_period_ps();
+  }
+
+  bool changed = false;
+  for (auto& [block, metadata] : context.metadata()) {
+    if (metadata.streaming_io_and_pipeline.pipeline_registers.empty()) {
+      continue;
+    }
+    int64_t bits_before = RegisterBitCount(block);
+    BlockRetimer retimer(block, metadata, *options.delay_estimator,
+                         clock_period_ps);
+    XLS_ASSIGN_OR_RETURN(bool block_changed, retimer.Run());
+    if (block_changed) {
+      if (!metadata.flop_count_before_retiming.has_value()) {
+        metadata.flop_count_before_retiming = bits_before;
+      }
+      VLOG(2) << "Retiming reduced register bits of block " << block->name()
+              << " from " << bits_before << " to " << RegisterBitCount(block);
+    }
+    changed = changed || block_changed;
+  }
+  if (changed) {
+    context.GcMetadata();
+  }
+  return changed;
+}
+
+}  // namespace xls::verilog
@@ -0,0 +1,60 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_CODEGEN_REGISTER_RETIMING_PASS_H_
+#define XLS_CODEGEN_REGISTER_RETIMING_PASS_H_
+
+#include "absl/status/statusor.h"
+#include "xls/codegen/codegen_pass.h"
+#include "xls/ir/package.h"
+#include "xls/passes/pass_base.h"
+
+namespace xls::verilog {
+
+// Retimes pipeline registers forward across logic to reduce the number of
+// register bits.
+//
+// A node whose operands are all pipeline registers written in the previous
+// stage (or literals) is moved into the previous stage and a single register
+// holding its value replaces the operand registers. For example, two 32-bit
+// registers feeding a comparison become one 1-bit register. This is the
+// forward-retiming move of Leiserson-Saxe retiming restricted to moves which
+// reduce register bits.
+//
+// A move is only made if:
+//  * the operand registers share a load enable (i.e., the same pipeline
+//    valid/ready control) and have no reset value, so the retimed register is
+//    loaded identically and reset behavior is unchanged, and
+//  * the longest path into the new register, measured with the delay
+//    estimator, does not exceed the block's existing critical path (or the
+//    scheduled clock period, if larger).
+//
+// Enabled by CodegenOptions::retime_registers and requires a delay estimator.
+// The register bit count prior to retiming is recorded in the block metadata.
+class RegisterRetimingPass : public CodegenPass {
+ public:
+  RegisterRetimingPass()
+      : CodegenPass("register_retiming",
+                    "Retime pipeline registers to reduce register bits") {}
+  ~RegisterRetimingPass() override = default;
+
+  absl::StatusOr<bool> RunInternal(Package* package,
+                                   const CodegenPassOptions& options,
+                                   PassResults* results,
+                                   CodegenContext& context) const override;
+};
+
+}  // namespace xls::verilog
+
+#endif  // XLS_CODEGEN_REGISTER_RETIMING_PASS_H_
@@ -0,0 +1,196 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/codegen/register_retiming_pass.h"
+
+#include <cstdint>
+#include <optional>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status_matchers.h"
+#include "absl/status/statusor.h"
+#include "xls/codegen/block_conversion.h"
+#include "xls/codegen/codegen_options.h"
+#include "xls/codegen/codegen_pass.h"
+#include "xls/common/status/matchers.h"
+#include "xls/estimators/delay_model/delay_estimator.h"
+#include "xls/estimators/delay_model/delay_estimators.h"
+#include "xls/ir/block.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_matcher.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/package.h"
+#include "xls/ir/register.h"
+#include "xls/passes/pass_base.h"
+#include "xls/scheduling/pipeline_schedule.h"
+
+namespace m = xls::op_matchers;
+namespace xls::verilog {
+namespace {
+
+using ::absl_testing::IsOkAndHolds;
+
+class RegisterRetimingPassTest : public IrTestBase {
+ public:
+  absl::StatusOr<bool> Run(Package* package, CodegenContext& context) {
+    XLS_ASSIGN_OR_RETURN(DelayEstimator * delay_estimator,
+                         GetDelayEstimator("unit"));
+    RegisterRetimingPass pass;
+    PassResults results;
+    return pass.Run(package,
+                    CodegenPassOptions{
+                        .codegen_options = Options(),
+                        .delay_estimator = delay_estimator,
+                    },
+                    &results, context);
+  }
+
+  static CodegenOptions Options() {
+    return CodegenOptions().clock_name("clk").retime_registers(true);
+  }
+
+  static int64_t RegisterBits(Block* block) {
+    int64_t bits = 0;
+    for (Register* reg : block->GetRegisters()) {
+      bits += reg->type()->GetFlatBitCount();
+    }
+    return bits;
+  }
+};
+
+TEST_F(RegisterRetimingPassTest, RetimesComparisonAcrossRegisters) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  BValue eq = fb.Eq(x, y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(eq));
+  PipelineSchedule schedule(f, {{x.node(), 0}, {y.node(), 0}, {eq.node(), 1}},
+                            2);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenContext context,
+      FunctionBaseToPipelinedBlock(schedule, Options(), f));
+  Block* block = context.top_block();
+  ASSERT_EQ(RegisterBits(block), 64);
+
+  EXPECT_THAT(Run(p.get(), context), IsOkAndHolds(true));
+
+  // The two 32-bit operand registers are replaced by a 1-bit register holding
+  // the comparison result computed in stage 0.
+  EXPECT_EQ(RegisterBits(block), 1);
+  XLS_ASSERT_OK_AND_ASSIGN(Node * out, block->GetOutputPort("out"));
+  EXPECT_THAT(out, m::OutputPort(m::RegisterRead()));
+  ASSERT_EQ(block->GetRegisters().size(), 1);
+  Register* reg = block->GetRegisters().front();
+  XLS_ASSERT_OK_AND_ASSIGN(RegisterWrite * reg_write,
+                           block->GetUniqueRegisterWrite(reg));
+  EXPECT_THAT(reg_write->data(), m::Eq(m::InputPort("x"), m::InputPort("y")));
+  EXPECT_EQ(context.GetMetadataForBlock(block).flop_count_before_retiming,
+            64);
+}
+
+TEST_F(RegisterRetimingPassTest, DoesNotRetimeWhenRegisterBitsIncrease) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  BValue concat = fb.Concat({x, y});
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(concat));
+  PipelineSchedule schedule(
+      f, {{x.node(), 0}, {y.node(), 0}, {concat.node(), 1}}, 2);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      CodegenContext context,
+      FunctionBaseToPipelinedBlock(schedule, Options(), f));
+
+  EXPECT_THAT(Run(p.get(), context), IsOkAndHolds(false));
+  EXPECT_EQ(RegisterBits(context.top_block()), 64);
+  EXPECT_FALSE(context.GetMetadataForBlock(context.top_block())
+                   .flop_count_before_retiming.has_value());
+}
+
+TEST_F(RegisterRetimingPassTest, RetimesValidControlledPipeline) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  BValue eq = fb.Eq(x, y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(eq));
+  PipelineSchedule schedule(f, {{x.node(), 0}, {y.node(), 0}, {eq.node(), 1}},
+                            2);
+  // The valid signal drives the load enable of the data registers. Only the
+  // valid register is reset.
+  CodegenOptions options = Options()
+                               .valid_control("in_valid", "out_valid")
+                               .reset("rst", /*asynchronous=*/false,
+                                      /*active_low=*/false,
+                                      /*reset_data_path=*/false);
+  XLS_ASSERT_OK_AND_ASSIGN(CodegenContext context,
+                           FunctionBaseToPipelinedBlock(schedule, options, f));
+  Block* block = context.top_block();
+  StreamingIOPipeline& pipeline =
+      context.GetMetadataForBlock(block).streaming_io_and_pipeline;
+  ASSERT_EQ(pipeline.pipeline_registers.size(), 1);
+  ASSERT_EQ(pipeline.pipeline_registers[0].size(), 2);
+  std::optional<Node*> load_enable =
+      pipeline.pipeline_registers[0].front().reg_write->load_enable();
+  ASSERT_TRUE(load_enable.has_value());
+  ASSERT_EQ(RegisterBits(block), 65);
+
+  EXPECT_THAT(Run(p.get(), context), IsOkAndHolds(true));
+
+  // The comparison is registered with the same load enable as the operands it
+  // replaces, and the valid pipeline is untouched.
+  EXPECT_EQ(RegisterBits(block), 2);
+  ASSERT_EQ(pipeline.pipeline_registers[0].size(), 1);
+  const PipelineRegister& retimed = pipeline.pipeline_registers[0].front();
+  EXPECT_THAT(retimed.reg_write->data(),
+              m::Eq(m::InputPort("x"), m::InputPort("y")));
+  EXPECT_EQ(retimed.reg_write->load_enable(), load_enable);
+  EXPECT_FALSE(retimed.reg_write->reset().has_value());
+  XLS_ASSERT_OK_AND_ASSIGN(Node * out_valid, block->GetOutputPort("out_valid"));
+  EXPECT_THAT(out_valid, m::OutputPort(m::RegisterRead("p0_valid")));
+  EXPECT_EQ(context.GetMetadataForBlock(block).flop_count_before_retiming,
+            65);
+}
+
+TEST_F(RegisterRetimingPassTest, DoesNotRetimeRegistersWithReset) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(32));
+  BValue y = fb.Param("y", p->GetBitsType(32));
+  BValue eq = fb.Eq(x, y);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(eq));
+  PipelineSchedule schedule(f, {{x.node(), 0}, {y.node(), 0}, {eq.node(), 1}},
+                            2);
+  // Resetting the data path gives the operand registers a reset, so moving
+  // them would change the value observed while in reset.
+  CodegenOptions options = Options()
+                               .valid_control("in_valid", "out_valid")
+                               .reset("rst", /*asynchronous=*/false,
+                                      /*active_low=*/false,
+                                      /*reset_data_path=*/true);
+  XLS_ASSERT_OK_AND_ASSIGN(CodegenContext context,
+                           FunctionBaseToPipelinedBlock(schedule, options, f));
+
+  EXPECT_THAT(Run(p.get(), context), IsOkAndHolds(false));
+  EXPECT_EQ(RegisterBits(context.top_block()), 65);
+  EXPECT_FALSE(context.GetMetadataForBlock(context.top_block())
+                   .flop_count_before_retiming.has_value());
+}
+
+}  // namespace
+}  // namespace xls::verilog
@@ -15,7 +15,7 @@
 #include "xls/codegen/unified_generator.h"
 
 #include <algorithm>
-#include <string>
+#include <utility>
 #include <vector>
 
 #include "absl/log/log.h"
@@ -30,6 +30,7 @@
 #include "xls/codegen/codegen_result.h"
 #include "xls/codegen/module_signature.h"
 #include "xls/codegen/passes_ng/stage_conversion_pass_pipeline.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/codegen/xls_metrics.pb.h"
 #include "xls/common/logging/log_lines.h"
@@ -80,7 +81,8 @@ absl::StatusOr<CodegenContext> CreateCodegenContextAndAssociateSchedules(
 
 absl::StatusOr<CodegenResult> GenerateModuleText(
     const PackageSchedule& package_schedule, Package* package,
-    const CodegenOptions& options, const DelayEstimator* delay_estimator) {
+    const CodegenOptions& options, const DelayEstimator* delay_estimator,
+    VastSink* verilog_sink) {
   VLOG(2) << "Generating module for package:";
   XLS_VLOG_LINES(2, package->DumpIr());
   if (VLOG_IS_ON(2)) {
@@ -146,10 +148,11 @@ absl::StatusOr<CodegenResult> GenerateModuleText(
   // VAST Generation: Block to Verilog codegen pass.
   VerilogLineMap verilog_line_map;
   CodegenResidualData residual_data;
-  XLS_ASSIGN_OR_RETURN(
-      std::string verilog,
-      GenerateVerilog(codegen_context.top_block(), pass_options.codegen_options,
-                      &verilog_line_map, &residual_data));
+  StringVastSink string_sink;
+  XLS_RETURN_IF_ERROR(GenerateVerilog(
+      codegen_context.top_block(), pass_options.codegen_options,
+      verilog_sink != nullptr ? *verilog_sink : string_sink, &verilog_line_map,
+      &residual_data));
 
   XLS_ASSIGN_OR_RETURN(
       ModuleSignature signature,
@@ -158,11 +161,11 @@ absl::StatusOr<CodegenResult> GenerateModuleText(
   XlsMetricsProto metrics;
   XLS_ASSIGN_OR_RETURN(
       *metrics.mutable_block_metrics(),
-      GenerateBlockMetrics(codegen_context.top_block(), delay_estimator));
+      GenerateTopBlockMetrics(codegen_context, delay_estimator));
 
   // TODO: google/xls#1323 - add all block signatures to ModuleGeneratorResult,
   // not just top.
-  return CodegenResult{.verilog_text = verilog,
+  return CodegenResult{.verilog_text = std::move(string_sink).Release(),
                        .verilog_line_map = verilog_line_map,
                        .signature = signature,
                        .block_metrics = metrics,
@@ -15,6 +15,7 @@
 #include "xls/codegen/vast/vast.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <optional>
 #include <ostream>
@@ -345,6 +346,30 @@ std::optional<std::vector<LineSpan>> LineInfo::LookupNode(
   return spans_.at(node).completed_spans;
 }
 
+void IndentingVastSink::Write(std::string_view text) {
+  while (!text.empty()) {
+    size_t newline = text.find('\n');
+    std::string_view line = text.substr(0, newline);
+    if (!line.empty()) {
+      if (at_line_start_) {
+        sink_.Write(indent_);
+        at_line_start_ = false;
+      }
+      sink_.Write(line);
+      wrote_anything_ = true;
+    }
+    if (newline == std::string_view::npos) {
+      return;
+    }
+    // Like `xls::Indent`, drop any leading empty lines.
+    if (wrote_anything_) {
+      sink_.Write("\n");
+    }
+    at_line_start_ = true;
+    text.remove_prefix(newline + 1);
+  }
+}
+
 std::string SanitizeVerilogIdentifier(std::string_view name,
                                       bool system_verilog) {
   if (name.empty()) {
@@ -465,16 +490,17 @@ UnpackedArrayType* VerilogFile::UnpackedArrayType(
 }
 
 std::string VerilogFile::Emit(LineInfo* line_info) const {
-  auto file_member_str = [=](const FileMember& member) -> std::string {
-    return absl::visit([=](auto* m) { return m->Emit(line_info); }, member);
-  };
+  StringVastSink sink;
+  EmitTo(sink, line_info);
+  return std::move(sink).Release();
+}
 
-  std::string out;
+void VerilogFile::EmitTo(VastSink& sink, LineInfo* line_info) const {
   for (const FileMember& member : members_) {
-    absl::StrAppend(&out, file_member_str(member), "\n");
+    absl::visit([&](auto* m) { m->EmitTo(sink, line_info); }, member);
+    sink.Write("\n");
     LineInfoIncrease(line_info, 1);
   }
-  return out;
 }
 
 LocalParamItemRef* LocalParam::AddItem(std::string_view name, Expression* value,
@@ -1086,57 +1112,60 @@ GenvarDef::GenvarDef(std::string_view name, VerilogFile* file,
                      const SourceInfo& loc)
     : Def(name, DataKind::kGenvar, file->IntegerType(loc), file, loc) {}
 
-namespace {
-
-// "Match" statement for emitting a ModuleMember.
-std::string EmitModuleMember(LineInfo* line_info, const ModuleMember& member) {
-  return absl::visit([=](auto* d) { return d->Emit(line_info); }, member);
-}
-
-// Visitor for emitting a VerilogPackageMember.
-std::string EmitVerilogPackageMember(LineInfo* line_info,
-                                     const VerilogPackageMember& member) {
-  return absl::visit([=](auto* d) { return d->Emit(line_info); }, member);
+std::string ModuleSection::Emit(LineInfo* line_info) const {
+  StringVastSink sink;
+  EmitTo(sink, line_info);
+  return std::move(sink).Release();
 }
 
-}  // namespace
-
-std::string ModuleSection::Emit(LineInfo* line_info) const {
+void ModuleSection::EmitTo(VastSink& sink, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
-  std::vector<std::string> elements;
+  bool emitted_any = false;
   for (const ModuleMember& member : members_) {
     if (std::holds_alternative<ModuleSection*>(member)) {
       if (std::get<ModuleSection*>(member)->members_.empty()) {
         continue;
       }
     }
-    elements.push_back(EmitModuleMember(line_info, member));
+    if (emitted_any) {
+      sink.Write("\n");
+    }
+    absl::visit([&](auto* d) { d->EmitTo(sink, line_info); }, member);
+    emitted_any = true;
     LineInfoIncrease(line_info, 1);
   }
-  if (!elements.empty()) {
+  if (emitted_any) {
     LineInfoIncrease(line_info, -1);
   }
   LineInfoEnd(line_info, this);
-  return absl::StrJoin(elements, "\n");
 }
 
 std::string VerilogPackageSection::Emit(LineInfo* line_info) const {
+  StringVastSink sink;
+  EmitTo(sink, line_info);
+  return std::move(sink).Release();
+}
+
+void VerilogPackageSection::EmitTo(VastSink& sink, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
-  std::vector<std::string> elements;
+  bool emitted_any = false;
   for (const VerilogPackageMember& member : members_) {
     if (std::holds_alternative<VerilogPackageSection*>(member)) {
       if (std::get<VerilogPackageSection*>(member)->members_.empty()) {
         continue;
       }
     }
-    elements.push_back(EmitVerilogPackageMember(line_info, member));
+    if (emitted_any) {
+      sink.Write("\n");
+    }
+    absl::visit([&](auto* d) { d->EmitTo(sink, line_info); }, member);
+    emitted_any = true;
     LineInfoIncrease(line_info, 1);
   }
-  if (!elements.empty()) {
+  if (emitted_any) {
     LineInfoIncrease(line_info, -1);
   }
   LineInfoEnd(line_info, this);
-  return absl::StrJoin(elements, "\n");
 }
 
 std::string ContinuousAssignment::Emit(LineInfo* line_info) const {
@@ -1275,46 +1304,64 @@ std::string SystemFunctionCall::Emit(LineInfo* line_info) const {
 }
 
 std::string Module::Emit(LineInfo* line_info) const {
+  StringVastSink sink;
+  EmitTo(sink, line_info);
+  return std::move(sink).Release();
+}
+
+void Module::EmitTo(VastSink& sink, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
-  std::string result = absl::StrCat("module ", name_);
+  sink.Write(absl::StrCat("module ", name_));
   if (ports_.empty()) {
-    absl::StrAppend(&result, ";\n");
+    sink.Write(";\n");
     LineInfoIncrease(line_info, 1);
   } else {
-    absl::StrAppend(&result, "(\n  ");
+    sink.Write("(\n  ");
     LineInfoIncrease(line_info, 1);
-    absl::StrAppend(
-        &result,
-        absl::StrJoin(ports_, ",\n  ",
-                      [=](std::string* out, const ModulePort& port) {
-                        std::string wire_str = port.wire->EmitNoSemi(line_info);
-                        CHECK(CannotStripWhitespace(wire_str));
-                        absl::StrAppendFormat(
-                            out, "%s %s", ToString(port.direction), wire_str);
-                        LineInfoIncrease(line_info, 1);
-                      }));
-    absl::StrAppend(&result, "\n);\n");
+    for (int64_t i = 0; i < ports_.size(); ++i) {
+      const ModulePort& port = ports_[i];
+      if (i != 0) {
+        sink.Write(",\n  ");
+      }
+      std::string wire_str = port.wire->EmitNoSemi(line_info);
+      CHECK(CannotStripWhitespace(wire_str));
+      sink.Write(absl::StrFormat("%s %s", ToString(port.direction), wire_str));
+      LineInfoIncrease(line_info, 1);
+    }
+    sink.Write("\n);\n");
     LineInfoIncrease(line_info, 1);
   }
-  absl::StrAppend(&result, Indent(top_.Emit(line_info)), "\n");
+  {
+    IndentingVastSink indented_sink(sink);
+    top_.EmitTo(indented_sink, line_info);
+  }
+  sink.Write("\n");
   LineInfoIncrease(line_info, 1);
-  absl::StrAppend(&result, "endmodule");
+  sink.Write("endmodule");
   LineInfoEnd(line_info, this);
-  return result;
 }
 
 std::string VerilogPackage::Emit(LineInfo* line_info) const {
+  StringVastSink sink;
+  EmitTo(sink, line_info);
+  return std::move(sink).Release();
+}
+
+void VerilogPackage::EmitTo(VastSink& sink, LineInfo* line_info) const {
   LineInfoStart(line_info, this);
 
-  std::string result = absl::StrCat("package ", name_, ";\n");
+  sink.Write(absl::StrCat("package ", name_, ";\n"));
   LineInfoIncrease(line_info, 1);
 
-  absl::StrAppend(&result, Indent(top_.Emit(line_info)), "\n");
+  {
+    IndentingVastSink indented_sink(sink);
+    top_.EmitTo(indented_sink, line_info);
+  }
+  sink.Write("\n");
   LineInfoIncrease(line_info, 1);
 
-  absl::StrAppend(&result, "endpackage");
+  sink.Write("endpackage");
   LineInfoEnd(line_info, this);
-  return result;
 }
 
 std::string Literal::Emit(LineInfo* line_info) const {
@@ -39,6 +39,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_cat.h"
 #include "absl/types/span.h"
+#include "xls/common/indent.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_ops.h"
 #include "xls/ir/format_preference.h"
@@ -151,6 +152,60 @@ class LineInfo {
   std::vector<const VastNode*> nodes_;
 };
 
+// Destination for Verilog text emitted incrementally with `EmitTo`. Emitting
+// through a sink avoids materializing the text of an entire file or module as a
+// single string.
+class VastSink {
+ public:
+  virtual ~VastSink() = default;
+
+  // Appends `text` to the output.
+  virtual void Write(std::string_view text) = 0;
+};
+
+// A sink which accumulates the emitted text in a string.
+class StringVastSink final : public VastSink {
+ public:
+  void Write(std::string_view text) final { absl::StrAppend(&text_, text); }
+
+  const std::string& text() const { return text_; }
+  std::string Release() && { return std::move(text_); }
+
+ private:
+  std::string text_;
+};
+
+// A sink which writes the emitted text to an output stream, e.g., a
+// std::ofstream.
+class OstreamVastSink final : public VastSink {
+ public:
+  explicit OstreamVastSink(std::ostream& os) : os_(os) {}
+
+  void Write(std::string_view text) final { os_ << text; }
+
+ private:
+  std::ostream& os_;
+};
+
+// A sink which indents each line of the text written to it before forwarding
+// it to `sink`. The output is identical to calling `xls::Indent` on the
+// concatenation of all text written: empty lines are not indented and leading
+// empty lines are dropped.
+class IndentingVastSink final : public VastSink {
+ public:
+  explicit IndentingVastSink(VastSink& sink,
+                             int64_t spaces = kDefaultIndentSpaces)
+      : sink_(sink), indent_(spaces, ' ') {}
+
+  void Write(std::string_view text) final;
+
+ private:
+  VastSink& sink_;
+  std::string indent_;
+  bool at_line_start_ = true;
+  bool wrote_anything_ = false;
+};
+
 // Returns a sanitized identifier string based on the given name. Invalid
 // characters are replaced with '_'. (System)Verilog keywords are
 // suffixed with "_".
@@ -171,6 +226,13 @@ class VastNode {
 
   virtual std::string Emit(LineInfo* line_info) const = 0;
 
+  // Writes the text of this node to `sink`. By default this writes the result
+  // of `Emit`; containers of many members (modules, packages and their
+  // sections) override it to stream their members one at a time.
+  virtual void EmitTo(VastSink& sink, LineInfo* line_info) const {
+    sink.Write(Emit(line_info));
+  }
+
  private:
   VerilogFile* file_;
   SourceInfo loc_;
@@ -2200,6 +2262,7 @@ class ModuleSection final : public VastNode {
   const std::vector<ModuleMember>& members() const { return members_; }
 
   std::string Emit(LineInfo* line_info) const final;
+  void EmitTo(VastSink& sink, LineInfo* line_info) const final;
 
  private:
   std::vector<ModuleMember> members_;
@@ -2306,6 +2369,7 @@ class Module final : public VastNode {
   const std::string& name() const { return name_; }
 
   std::string Emit(LineInfo* line_info) const final;
+  void EmitTo(VastSink& sink, LineInfo* line_info) const final;
 
  private:
   // Note: these `*Internal` variants don't do any already-defined checking.
@@ -2404,6 +2468,7 @@ class VerilogPackageSection final : public VastNode {
   const std::vector<VerilogPackageMember>& members() const { return members_; }
 
   std::string Emit(LineInfo* line_info) const final;
+  void EmitTo(VastSink& sink, LineInfo* line_info) const final;
 
  private:
   std::vector<VerilogPackageMember> members_;
@@ -2438,6 +2503,7 @@ class VerilogPackage final : public VastNode {
   const std::string& name() const { return name_; }
 
   std::string Emit(LineInfo* line_info) const final;
+  void EmitTo(VastSink& sink, LineInfo* line_info) const final;
 
  private:
   std::string name_;
@@ -2492,6 +2558,10 @@ class VerilogFile {
 
   std::string Emit(LineInfo* line_info = nullptr) const;
 
+  // Writes the text of the file to `sink` one member at a time. The text is
+  // identical to that returned by `Emit`.
+  void EmitTo(VastSink& sink, LineInfo* line_info = nullptr) const;
+
   verilog::Slice* Slice(IndexableExpression* subject, Expression* hi,
                         Expression* lo, const SourceInfo& loc) {
     return Make<verilog::Slice>(loc, subject, hi, lo);
@@ -16,6 +16,7 @@
 
 #include <cstdint>
 #include <optional>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -25,9 +26,11 @@
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
+#include "absl/strings/escaping.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
+#include "xls/common/indent.h"
 #include "xls/common/status/matchers.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/format_preference.h"
@@ -2535,12 +2538,85 @@ TEST_P(VastTest, SimpleGenerateLoop) {
 endmodule)");
 }
 
+TEST_P(VastTest, EmitToMatchesEmit) {
+  VerilogFile f(GetFileType());
+  f.AddInclude("foo.v", SourceInfo());
+  Module* m = f.AddModule("top", SourceInfo());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      LogicRef * in,
+      m->AddInput("in", f.BitVectorType(8, SourceInfo()), SourceInfo()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      LogicRef * out,
+      m->AddOutput("out", f.BitVectorType(8, SourceInfo()), SourceInfo()));
+  ModuleSection* section = m->Add<ModuleSection>(SourceInfo());
+  section->Add<Comment>(SourceInfo(), "multi-line\ncomment");
+  // Empty sections are skipped.
+  section->Add<ModuleSection>(SourceInfo());
+  ModuleSection* nested = section->Add<ModuleSection>(SourceInfo());
+  nested->Add<BlankLine>(SourceInfo());
+  m->Add<ContinuousAssignment>(SourceInfo(), out, in);
+  f.Add(f.Make<BlankLine>(SourceInfo()));
+  Module* empty = f.AddModule("empty", SourceInfo());
+
+  LineInfo line_info;
+  std::string text = f.Emit(&line_info);
+
+  LineInfo streamed_line_info;
+  std::ostringstream os;
+  OstreamVastSink sink(os);
+  f.EmitTo(sink, &streamed_line_info);
+  EXPECT_EQ(os.str(), text);
+  EXPECT_EQ(text,
+            R"(`include "foo.v"
+module top(
+  input wire [7:0] in,
+  output wire [7:0] out
+);
+  // multi-line
+  // comment
+
+  assign out = in;
+endmodule
+
+module empty;
+
+endmodule
+)");
+
+  for (const VastNode* node : {static_cast<const VastNode*>(m),
+                               static_cast<const VastNode*>(section),
+                               static_cast<const VastNode*>(nested),
+                               static_cast<const VastNode*>(empty)}) {
+    EXPECT_EQ(streamed_line_info.LookupNode(node), line_info.LookupNode(node));
+  }
+  EXPECT_EQ(line_info.LookupNode(m).value(),
+            std::vector<LineSpan>{LineSpan(1, 9)});
+}
+
 INSTANTIATE_TEST_SUITE_P(VastTestInstantiation, VastTest,
                          testing::Values(false, true),
                          [](const testing::TestParamInfo<bool>& info) {
                            return info.param ? "SystemVerilog" : "Verilog";
                          });
 
+TEST(VastSinkTest, IndentingSinkMatchesIndent) {
+  for (std::string_view text :
+       {"", "foo", "foo\nbar", "\n\nfoo\n\nbar\n", "foo\n", "\n", "a\n\n"}) {
+    // Write the text in two chunks, split at every possible position.
+    for (int64_t split = 0; split <= text.size(); ++split) {
+      StringVastSink sink;
+      {
+        IndentingVastSink indented_sink(sink);
+        indented_sink.Write(text.substr(0, split));
+        indented_sink.Write(text.substr(split));
+      }
+      EXPECT_EQ(sink.text(), Indent(text))
+          << absl::StrFormat("text: \"%s\", split: %d",
+                             absl::CEscape(text), split);
+    }
+  }
+}
+
 }  // namespace
 }  // namespace verilog
 }  // namespace xls
@@ -63,9 +63,13 @@ absl::StatusOr<TempDirectory> TempDirectory::Create(
   if (ec) {
     return absl::InternalError("Failed to get temporary directory path.");
   }
+  return CreateInDirectory(global_temp_dir, name_root);
+}
 
+absl::StatusOr<TempDirectory> TempDirectory::CreateInDirectory(
+    const std::filesystem::path& directory, std::string_view name_root) {
   std::string name_template = absl::StrCat(name_root, "_XXXXXX");
-  std::string temp_dir = (global_temp_dir / name_template).string();
+  std::string temp_dir = (directory / name_template).string();
   if (mkdtemp(temp_dir.data()) == nullptr) {
     return absl::UnavailableError(
         absl::StrCat("Failed to create temporary directory ", temp_dir));
@@ -33,6 +33,12 @@ class TempDirectory {
 
   static absl::StatusOr<TempDirectory> Create(
       std::string_view name_root = "temp_directory");
+  // Creates the temporary directory inside `directory` rather than the system
+  // temporary directory, e.g., so that it can be renamed to a path on the same
+  // filesystem as `directory`.
+  static absl::StatusOr<TempDirectory> CreateInDirectory(
+      const std::filesystem::path& directory,
+      std::string_view name_root = "temp_directory");
 
   const std::filesystem::path& path() const;
 
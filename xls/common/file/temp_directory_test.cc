@@ -35,6 +35,19 @@ TEST(TempDirectory, CreateCreatesATemporaryDirectory) {
   EXPECT_TRUE(std::filesystem::is_directory(temp_dir->path(), ec));
 }
 
+TEST(TempDirectory, CreateInDirectoryCreatesADirectoryInTheGivenDirectory) {
+  std::error_code ec;
+
+  auto parent = TempDirectory::Create();
+  XLS_ASSERT_OK(parent);
+  auto temp_dir = TempDirectory::CreateInDirectory(parent->path(), "child");
+  XLS_ASSERT_OK(temp_dir);
+
+  EXPECT_TRUE(std::filesystem::is_directory(temp_dir->path(), ec));
+  EXPECT_EQ(temp_dir->path().parent_path(), parent->path());
+  EXPECT_EQ(temp_dir->path().filename().string().rfind("child_", 0), 0);
+}
+
 TEST(TempDirectory, DestructorDeletesTheTemporaryDirectory) {
   std::error_code ec;
 
@@ -0,0 +1,129 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "absl/base/no_destructor.h"
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/thread.h"
+
+namespace xls {
+
+ThreadPool& ThreadPool::Shared() {
+  static absl::NoDestructor<ThreadPool> pool(std::max(AvailableCPUs() - 1, 0));
+  return *pool;
+}
+
+ThreadPool::ThreadPool(int64_t thread_count) {
+  for (int64_t i = 0; i < thread_count; ++i) {
+    threads_.push_back(std::make_unique<Thread>([this]() { WorkLoop(); }));
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    absl::MutexLock lock(&mutex_);
+    stopping_ = true;
+  }
+  for (std::unique_ptr<Thread>& thread : threads_) {
+    thread->Join();
+  }
+}
+
+void ThreadPool::Schedule(absl::AnyInvocable<void() &&> task) {
+  absl::MutexLock lock(&mutex_);
+  tasks_.push_back(std::move(task));
+}
+
+void ThreadPool::WorkLoop() {
+  while (true) {
+    absl::AnyInvocable<void() &&> task;
+    {
+      absl::MutexLock lock(&mutex_);
+      mutex_.Await(absl::Condition(this, &ThreadPool::HasTasksOrStopping));
+      if (tasks_.empty()) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    std::move(task)();
+  }
+}
+
+void ParallelFor(ThreadPool& pool, int64_t count, int64_t max_threads,
+                 absl::FunctionRef<void(int64_t)> fn) {
+  int64_t task_count =
+      std::min({max_threads - 1, pool.thread_count(), count - 1});
+  if (task_count <= 0) {
+    for (int64_t i = 0; i < count; ++i) {
+      fn(i);
+    }
+    return;
+  }
+
+  // Shared with the pool tasks, which may only start after this call returns.
+  // `fn` is only called while the caller is waiting for `running_tasks`.
+  struct State {
+    explicit State(absl::FunctionRef<void(int64_t)> fn) : fn(fn) {}
+
+    absl::FunctionRef<void(int64_t)> fn;
+    std::atomic<int64_t> next = 0;
+    absl::Mutex mutex;
+    // Whether the caller has claimed every index; tasks which have not
+    // started by then do nothing.
+    bool done ABSL_GUARDED_BY(mutex) = false;
+    int64_t running_tasks ABSL_GUARDED_BY(mutex) = 0;
+
+    bool TasksFinished() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex) {
+      return running_tasks == 0;
+    }
+  };
+  auto state = std::make_shared<State>(fn);
+  auto run_remaining = [count](State& state) {
+    for (int64_t i = state.next.fetch_add(1); i < count;
+         i = state.next.fetch_add(1)) {
+      state.fn(i);
+    }
+  };
+  for (int64_t i = 0; i < task_count; ++i) {
+    pool.Schedule([state, run_remaining]() {
+      {
+        absl::MutexLock lock(&state->mutex);
+        if (state->done) {
+          return;
+        }
+        ++state->running_tasks;
+      }
+      run_remaining(*state);
+      absl::MutexLock lock(&state->mutex);
+      --state->running_tasks;
+    });
+  }
+  run_remaining(*state);
+  absl::MutexLock lock(&state->mutex);
+  state->done = true;
+  state->mutex.Await(absl::Condition(state.get(), &State::TasksFinished));
+}
+
+}  // namespace xls
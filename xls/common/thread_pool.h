@@ -0,0 +1,77 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_COMMON_THREAD_POOL_H_
+#define XLS_COMMON_THREAD_POOL_H_
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/functional/function_ref.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/thread.h"
+
+namespace xls {
+
+// A fixed set of threads which run scheduled tasks in FIFO order.
+class ThreadPool {
+ public:
+  // Returns the process-wide pool of AvailableCPUs() - 1 threads, started on
+  // first use. Components which parallelize work (verification, quickcheck,
+  // parsing imports, ...) share these threads, so running many of them at
+  // once (e.g., one per thread of a tool) does not oversubscribe the machine.
+  static ThreadPool& Shared();
+
+  explicit ThreadPool(int64_t thread_count);
+
+  // Runs the tasks already scheduled, then joins the threads.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  int64_t thread_count() const { return threads_.size(); }
+
+  void Schedule(absl::AnyInvocable<void() &&> task);
+
+ private:
+  void WorkLoop();
+
+  bool HasTasksOrStopping() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(mutex_) {
+    return !tasks_.empty() || stopping_;
+  }
+
+  absl::Mutex mutex_;
+  std::deque<absl::AnyInvocable<void() &&>> tasks_ ABSL_GUARDED_BY(mutex_);
+  bool stopping_ ABSL_GUARDED_BY(mutex_) = false;
+  std::vector<std::unique_ptr<Thread>> threads_;
+};
+
+// Calls `fn(i)` for every `i` in [0, `count`) on the calling thread and on up
+// to `max_threads` - 1 threads of `pool`, each repeatedly claiming the next
+// index in increasing order. Returns once every call has returned.
+//
+// The calling thread takes part, so it never waits for tasks queued behind
+// other work in the pool: tasks which only start after all indices are
+// claimed do nothing. `fn` must be safe to call concurrently.
+void ParallelFor(ThreadPool& pool, int64_t count, int64_t max_threads,
+                 absl::FunctionRef<void(int64_t)> fn);
+
+}  // namespace xls
+
+#endif  // XLS_COMMON_THREAD_POOL_H_
@@ -0,0 +1,71 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/common/thread_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/synchronization/notification.h"
+
+namespace xls {
+namespace {
+
+using ::testing::Each;
+
+TEST(ThreadPoolTest, DestructorRunsScheduledTasks) {
+  std::atomic<int64_t> ran = 0;
+  {
+    ThreadPool pool(3);
+    for (int64_t i = 0; i < 100; ++i) {
+      pool.Schedule([&ran]() { ++ran; });
+    }
+  }
+  EXPECT_EQ(ran, 100);
+}
+
+TEST(ThreadPoolTest, ParallelForCallsEveryIndexOnce) {
+  ThreadPool pool(4);
+  for (int64_t max_threads : {0, 1, 2, 5, 100}) {
+    std::vector<std::atomic<int64_t>> calls(1000);
+    ParallelFor(pool, calls.size(), max_threads,
+                [&](int64_t i) { ++calls[i]; });
+    std::vector<int64_t> counts(calls.begin(), calls.end());
+    EXPECT_THAT(counts, Each(1)) << max_threads;
+  }
+}
+
+TEST(ThreadPoolTest, ParallelForWithoutThreadsRunsOnCaller) {
+  ThreadPool pool(0);
+  int64_t sum = 0;
+  ParallelFor(pool, 10, 8, [&](int64_t i) { sum += i; });
+  EXPECT_EQ(sum, 45);
+}
+
+TEST(ThreadPoolTest, ParallelForDoesNotWaitForBusyPool) {
+  absl::Notification release;
+  ThreadPool pool(1);
+  // Occupy the only pool thread; the ParallelFor task is queued behind it.
+  pool.Schedule([&release]() { release.WaitForNotification(); });
+  int64_t sum = 0;
+  ParallelFor(pool, 10, 2, [&](int64_t i) { sum += i; });
+  EXPECT_EQ(sum, 45);
+  release.Notify();
+}
+
+}  // namespace
+}  // namespace xls
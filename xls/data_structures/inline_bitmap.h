@@ -326,6 +326,22 @@ class InlineBitmap {
     }
   }
 
+  // Sets this bitmap to the bitwise 'xor' of this bitmap and `other`.
+  void SymmetricDifference(const InlineBitmap& other) {
+    CHECK_EQ(bit_count(), other.bit_count());
+    for (int64_t i = 0; i < data_.size(); ++i) {
+      data_[i] ^= other.data_[i];
+    }
+  }
+
+  // Inverts every bit of this bitmap.
+  void Complement() {
+    for (uint64_t& word : data_) {
+      word = ~word;
+    }
+    MaskLastWord();
+  }
+
   int64_t byte_count() const { return CeilOfRatio(bit_count_, int64_t{8}); }
   int64_t word_count() const { return data_.size(); }
 
@@ -508,6 +508,67 @@ TEST(InlineBitmapTest, Intersect) {
   }
 }
 
+TEST(InlineBitmapTest, SymmetricDifference) {
+  {
+    InlineBitmap b(0);
+    b.SymmetricDifference(InlineBitmap(0));
+  }
+
+  {
+    InlineBitmap b = InlineBitmap::FromWord(0b00001100, 8);
+    b.SymmetricDifference(InlineBitmap::FromWord(0b10001001, 8));
+    EXPECT_EQ(b.GetWord(0), 0b10000101);
+    b.SymmetricDifference(InlineBitmap::FromWord(0b10000101, 8));
+    EXPECT_TRUE(b.IsAllZeroes());
+  }
+
+  {
+    InlineBitmap b1(80);
+    b1.SetByte(0, 0xab);
+    b1.SetByte(9, 0x84);
+
+    InlineBitmap b2(80);
+    b2.SetByte(0, 0xfb);
+    b2.SetByte(5, 0x42);
+    b2.SetByte(9, 0x31);
+
+    b1.SymmetricDifference(b2);
+    EXPECT_EQ(b1.GetByte(0), 0x50);
+    EXPECT_EQ(b1.GetByte(1), 0);
+    EXPECT_EQ(b1.GetByte(5), 0x42);
+    EXPECT_EQ(b1.GetByte(9), 0xb5);
+  }
+}
+
+TEST(InlineBitmapTest, Complement) {
+  {
+    InlineBitmap b(0);
+    b.Complement();
+    EXPECT_TRUE(b.IsAllOnes());
+  }
+
+  {
+    InlineBitmap b = InlineBitmap::FromWord(0b0110, 4);
+    b.Complement();
+    EXPECT_EQ(b.GetWord(0), 0b1001);
+  }
+
+  {
+    // Bits beyond the bit count stay zero.
+    InlineBitmap b(65);
+    b.Set(3);
+    b.Complement();
+    EXPECT_FALSE(b.Get(3));
+    EXPECT_TRUE(b.Get(64));
+    EXPECT_EQ(b.GetWord(0), ~uint64_t{0b1000});
+    EXPECT_EQ(b.GetWord(1), 1);
+    b.Complement();
+    InlineBitmap expected(65);
+    expected.Set(3);
+    EXPECT_EQ(b, expected);
+  }
+}
+
 TEST(InlineBitmapTest, WithSize) {
   {
     InlineBitmap b1(80);
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <filesystem>  // NOLINT
 #include <iostream>
 #include <iterator>
 #include <memory>
@@ -42,15 +43,19 @@
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/time/clock.h"
+#include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xls/common/exit_status.h"
 #include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
 #include "xls/common/file/temp_file.h"
 #include "xls/common/init_xls.h"
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/common/subprocess.h"
+#include "xls/common/thread.h"
 #include "xls/data_structures/binary_search.h"
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/dev_tools/extract_segment.h"
@@ -114,6 +119,11 @@ IR exhibits the bug. Example invocation:
 
   ir_minimizer_main --test_executable=/foo/test.sh IR_FILE
 
+With an external test executable, --parallelism=N tests batches of N candidate
+reductions concurrently, which speeds up minimization when the test is slow:
+
+  ir_minimizer_main --test_executable=/foo/test.sh --parallelism=16 IR_FILE
+
 The second mode specifically reduces a test case where the JIT results differ
 from the interpreter results. Example invocation:
 
@@ -254,6 +264,16 @@ ABSL_FLAG(std::string, output_path, "-",
           "Path where the minimized IR will be written. Will print to stdout "
           "if not set or set to '-'. If stopped early, will contain the latest "
           "known-failing IR.");
+ABSL_FLAG(int64_t, parallelism, 1,
+          "Number of candidate reductions to test concurrently. If greater "
+          "than one, each round generates a batch of independent candidates "
+          "from the last known-failing IR, runs the test executable on them in "
+          "parallel (each in its own temporary directory) and keeps the "
+          "smallest candidate which still fails. Requires --test_executable.");
+ABSL_FLAG(bool, bisect_nodes, true,
+          "With --parallelism greater than one, also generate candidates "
+          "which replace sets of nodes with literals, bisecting the sets "
+          "delta-debugging style when no candidate of a round still fails.");
 
 namespace xls {
 namespace {
@@ -276,57 +296,71 @@ absl::StatusOr<std::unique_ptr<Package>> ParsePackage(
   return package;
 }
 
+// Runs the test executable on the IR and returns whether the IR still exhibits
+// the bug. If `work_dir` is given the IR is written there and the test is run
+// with it as the working directory, so concurrent tests do not share files;
+// otherwise the IR is written to a temporary file.
+absl::StatusOr<bool> TestExecutableStillFails(
+    std::string_view ir_text,
+    std::optional<std::filesystem::path> work_dir = std::nullopt) {
+  // Verify script exists and is executable.
+  absl::Status exists_status = FileExists(absl::GetFlag(FLAGS_test_executable));
+  QCHECK(exists_status.ok() || absl::IsNotFound(exists_status))
+      << absl::StreamFormat("Unable to access test executable %s: %s",
+                            absl::GetFlag(FLAGS_test_executable),
+                            exists_status.message());
+  QCHECK(!absl::IsNotFound(exists_status)) << absl::StreamFormat(
+      "Test executable %s not found", absl::GetFlag(FLAGS_test_executable));
+  XLS_ASSIGN_OR_RETURN(bool is_executable,
+                       FileIsExecutable(absl::GetFlag(FLAGS_test_executable)));
+  QCHECK(is_executable) << absl::StreamFormat(
+      "Test executable %s is not executable",
+      absl::GetFlag(FLAGS_test_executable));
+
+  // Test for bug using external executable.
+  std::optional<TempFile> temp_file;
+  std::string ir_path;
+  if (work_dir.has_value()) {
+    ir_path = (*work_dir / "sample.ir").string();
+    XLS_RETURN_IF_ERROR(SetFileContents(ir_path, ir_text));
+  } else {
+    XLS_ASSIGN_OR_RETURN(temp_file, TempFile::CreateWithContent(ir_text));
+    ir_path = temp_file->path().string();
+  }
+
+  QCHECK(!absl::GetFlag(FLAGS_test_llvm_jit))
+      << "Cannot specify --test_llvm_jit with --test_executable";
+  QCHECK(!absl::GetFlag(FLAGS_test_optimizer))
+      << "Cannot specify --test_optimizer with --test_executable";
+  QCHECK(absl::GetFlag(FLAGS_input).empty())
+      << "Cannot specify --input with --test_executable";
+  std::vector<std::string> argv;
+  argv.reserve(2 + absl::GetFlag(FLAGS_test_executable_args).size());
+  argv.push_back(absl::GetFlag(FLAGS_test_executable));
+  absl::c_copy(absl::GetFlag(FLAGS_test_executable_args),
+               std::back_inserter(argv));
+  argv.push_back(ir_path);
+
+  XLS_ASSIGN_OR_RETURN(SubprocessResult subproc_result,
+                       InvokeSubprocess(argv, work_dir));
+
+  if (subproc_result.exit_status != 0) {
+    VLOG(2) << "stdout:  \"\"\"" << subproc_result.stdout_content << "\"\"\"";
+    VLOG(2) << "stderr:  \"\"\"" << subproc_result.stderr_content << "\"\"\"";
+    VLOG(2) << "retcode: " << subproc_result.exit_status;
+  }
+  if (absl::GetFlag(FLAGS_test_executable_crash_is_bug)) {
+    return !subproc_result.normal_termination;
+  }
+  return subproc_result.exit_status == 0;
+}
+
 // Checks whether we still fail when attempting to run function "f". Optional
 // 'inputs' is required if --test_llvm_jit is used.
 absl::StatusOr<bool> StillFailsHelper(
     std::string_view ir_text, std::optional<std::vector<Value>> inputs) {
   if (!absl::GetFlag(FLAGS_test_executable).empty()) {
-    // Verify script exists and is executable.
-    absl::Status exists_status =
-        FileExists(absl::GetFlag(FLAGS_test_executable));
-    QCHECK(exists_status.ok() || absl::IsNotFound(exists_status))
-        << absl::StreamFormat("Unable to access test executable %s: %s",
-                              absl::GetFlag(FLAGS_test_executable),
-                              exists_status.message());
-    QCHECK(!absl::IsNotFound(exists_status)) << absl::StreamFormat(
-        "Test executable %s not found", absl::GetFlag(FLAGS_test_executable));
-    XLS_ASSIGN_OR_RETURN(
-        bool is_executable,
-        FileIsExecutable(absl::GetFlag(FLAGS_test_executable)));
-    QCHECK(is_executable) << absl::StreamFormat(
-        "Test executable %s is not executable",
-        absl::GetFlag(FLAGS_test_executable));
-
-    // Test for bug using external executable.
-    XLS_ASSIGN_OR_RETURN(TempFile temp_file,
-                         TempFile::CreateWithContent(ir_text));
-    std::string ir_path = temp_file.path().string();
-
-    QCHECK(!absl::GetFlag(FLAGS_test_llvm_jit))
-        << "Cannot specify --test_llvm_jit with --test_executable";
-    QCHECK(!absl::GetFlag(FLAGS_test_optimizer))
-        << "Cannot specify --test_optimizer with --test_executable";
-    QCHECK(absl::GetFlag(FLAGS_input).empty())
-        << "Cannot specify --input with --test_executable";
-    std::vector<std::string> argv;
-    argv.reserve(2 + absl::GetFlag(FLAGS_test_executable_args).size());
-    argv.push_back(absl::GetFlag(FLAGS_test_executable));
-    absl::c_copy(absl::GetFlag(FLAGS_test_executable_args),
-                 std::back_inserter(argv));
-    argv.push_back(ir_path);
-
-    XLS_ASSIGN_OR_RETURN(SubprocessResult subproc_result,
-                         InvokeSubprocess(argv));
-
-    if (subproc_result.exit_status != 0) {
-      VLOG(2) << "stdout:  \"\"\"" << subproc_result.stdout_content << "\"\"\"";
-      VLOG(2) << "stderr:  \"\"\"" << subproc_result.stderr_content << "\"\"\"";
-      VLOG(2) << "retcode: " << subproc_result.exit_status;
-    }
-    if (absl::GetFlag(FLAGS_test_executable_crash_is_bug)) {
-      return !subproc_result.normal_termination;
-    }
-    return subproc_result.exit_status == 0;
+    return TestExecutableStillFails(ir_text);
   }
 
   if (absl::GetFlag(FLAGS_test_optimizer)) {
@@ -1312,6 +1346,364 @@ absl::Status CleanUp(FunctionBase* f, bool can_remove_params) {
   return absl::OkStatus();
 }
 
+// A candidate reduction of the last known-failing IR, tested in batched mode.
+struct BatchCandidate {
+  std::string which_transform;
+  std::string ir_text;
+  // Number of nodes in the whole package.
+  int64_t node_count;
+};
+
+// Generates a candidate by applying one random simplification to a fresh copy
+// of the package in `ir_text`. `candidate` is only filled in if the result is
+// kDidChange.
+absl::StatusOr<SimplificationResult> GenerateRandomCandidate(
+    std::string_view ir_text, std::optional<std::vector<Value>> inputs,
+    absl::BitGenRef rng, bool can_remove_params, BatchCandidate* candidate) {
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       ParsePackage(ir_text));
+  FunctionBase* f;
+  if (absl::GetFlag(FLAGS_simplify_top_only)) {
+    f = package->GetTop().value();
+  } else {
+    std::vector<FunctionBase*> bases;
+    std::vector<int64_t> node_counts;
+    for (FunctionBase* fb : package->GetFunctionBases()) {
+      if (fb->node_count() > 0) {
+        bases.push_back(fb);
+        node_counts.push_back(fb->node_count());
+      }
+    }
+    if (bases.empty()) {
+      return SimplificationResult::kCannotChange;
+    }
+    absl::discrete_distribution<size_t> distribution(node_counts.cbegin(),
+                                                     node_counts.cend());
+    f = bases[distribution(rng)];
+  }
+
+  std::string which_transform;
+  XLS_ASSIGN_OR_RETURN(SimplifiedIr simplification,
+                       Simplify(f, inputs, rng, &which_transform));
+  if (simplification.result != SimplificationResult::kDidChange) {
+    return simplification.result;
+  }
+  if (simplification.in_place()) {
+    // f might have been removed by DFE at this point.
+    if (absl::c_linear_search(package->GetFunctionBases(), f)) {
+      XLS_RETURN_IF_ERROR(CleanUp(f, can_remove_params));
+    }
+    candidate->ir_text = package->DumpIr();
+    candidate->node_count = package->GetNodeCount();
+  } else {
+    candidate->ir_text = simplification.ir();
+    XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> new_package,
+                         ParsePackage(candidate->ir_text));
+    candidate->node_count = new_package->GetNodeCount();
+  }
+  candidate->which_transform = std::move(which_transform);
+  return SimplificationResult::kDidChange;
+}
+
+// A node which delta-debugging bisection may replace with a literal,
+// identified by name so it can be found in fresh copies of the package.
+struct BisectableNode {
+  std::string function_base;
+  std::string node;
+};
+
+// Returns the nodes of the package which can be replaced by a literal without
+// changing its interface: nodes of functions and procs which are not
+// parameters, literals, state reads or side-effecting, and do not carry
+// tokens.
+std::vector<BisectableNode> GetBisectableNodes(Package* package) {
+  std::vector<FunctionBase*> bases;
+  if (absl::GetFlag(FLAGS_simplify_top_only)) {
+    bases.push_back(package->GetTop().value());
+  } else {
+    bases = package->GetFunctionBases();
+  }
+  std::vector<BisectableNode> nodes;
+  for (FunctionBase* f : bases) {
+    if (f->IsBlock()) {
+      continue;
+    }
+    for (Node* n : f->nodes()) {
+      if (n->Is<Param>() || n->Is<Literal>() || n->Is<StateRead>() ||
+          OpIsSideEffecting(n->op()) || TypeHasToken(n->GetType())) {
+        continue;
+      }
+      nodes.push_back(
+          BisectableNode{.function_base = f->name(), .node = n->GetName()});
+    }
+  }
+  return nodes;
+}
+
+// Generates the candidate which replaces `nodes` of the package in `ir_text`
+// with zero-valued literals.
+absl::StatusOr<BatchCandidate> ReplaceNodesWithLiterals(
+    std::string_view ir_text, absl::Span<const BisectableNode> nodes,
+    bool can_remove_params) {
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       ParsePackage(ir_text));
+  absl::flat_hash_map<std::string_view, FunctionBase*> bases;
+  for (FunctionBase* f : package->GetFunctionBases()) {
+    bases[f->name()] = f;
+  }
+  for (const BisectableNode& node : nodes) {
+    auto it = bases.find(node.function_base);
+    XLS_RET_CHECK(it != bases.end()) << node.function_base;
+    XLS_ASSIGN_OR_RETURN(Node * n, it->second->GetNode(node.node));
+    XLS_RETURN_IF_ERROR(
+        n->ReplaceUsesWithNew<Literal>(ZeroOfType(n->GetType())).status());
+  }
+  XLS_RETURN_IF_ERROR(CleanUp(package->GetTop().value(), can_remove_params));
+  return BatchCandidate{
+      .which_transform =
+          absl::StrFormat("replace %d nodes with literals", nodes.size()),
+      .ir_text = package->DumpIr(),
+      .node_count = package->GetNodeCount()};
+}
+
+// Runs the test executable on the candidates concurrently, each in its own
+// work directory, and returns whether each candidate still fails.
+absl::StatusOr<std::vector<bool>> TestCandidatesInParallel(
+    absl::Span<const BatchCandidate> candidates,
+    absl::Span<const TempDirectory> work_dirs) {
+  XLS_RET_CHECK_LE(candidates.size(), work_dirs.size());
+  std::vector<absl::StatusOr<bool>> results(candidates.size(), false);
+  std::vector<std::unique_ptr<Thread>> threads;
+  threads.reserve(candidates.size());
+  for (int64_t i = 0; i < candidates.size(); ++i) {
+    threads.push_back(std::make_unique<Thread>([&, i]() {
+      results[i] = TestExecutableStillFails(candidates[i].ir_text,
+                                            work_dirs[i].path());
+    }));
+  }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+  std::vector<bool> still_fails;
+  still_fails.reserve(results.size());
+  for (absl::StatusOr<bool>& result : results) {
+    XLS_ASSIGN_OR_RETURN(bool fails, std::move(result));
+    still_fails.push_back(fails);
+  }
+  return still_fails;
+}
+
+// Minimizes the known-failing IR in rounds. Each round generates a batch of up
+// to `parallelism` distinct candidates from the known-failing IR, tests them
+// concurrently and keeps the smallest candidate which still fails.
+//
+// If --bisect_nodes is set, part of each batch replaces chunks of the
+// bisectable nodes with literals, delta-debugging style: the nodes are split
+// into `granularity` chunks, and when no chunk can be replaced the granularity
+// is doubled until single nodes are tried. The remainder of the batch is
+// filled with random simplifications as in the serial mode.
+//
+// Returns the minimized IR.
+absl::StatusOr<std::string> MinimizeInBatches(
+    std::string knownf_ir_text, std::string_view output_path,
+    std::optional<std::vector<Value>> inputs, int64_t parallelism,
+    bool can_remove_params, const int64_t failed_attempt_limit,
+    const int64_t total_attempt_limit,
+    absl::flat_hash_map<std::string, bool>& test_cache) {
+  // Bounds the random simplifications tried per candidate slot, as most of
+  // them do not change the IR.
+  constexpr int64_t kGenerationAttemptsPerCandidate = 16;
+
+  std::vector<TempDirectory> work_dirs;
+  work_dirs.reserve(parallelism);
+  for (int64_t i = 0; i < parallelism; ++i) {
+    XLS_ASSIGN_OR_RETURN(TempDirectory work_dir,
+                         TempDirectory::Create("ir_minimizer"));
+    work_dirs.push_back(std::move(work_dir));
+  }
+
+  std::mt19937 rng;  // Default constructor uses deterministic seed.
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       ParsePackage(knownf_ir_text));
+  const int64_t initial_node_count = package->GetNodeCount();
+  const absl::Time start = absl::Now();
+  int64_t failed_attempts = 0;
+  int64_t total_attempts = 0;
+  int64_t rounds = 0;
+
+  // Delta-debugging state over the bisectable nodes of `package`.
+  bool bisect = absl::GetFlag(FLAGS_bisect_nodes);
+  int64_t granularity = 2;
+  int64_t next_chunk = 0;
+
+  while (true) {
+    if (failed_attempts >= failed_attempt_limit) {
+      LOG(INFO) << "Hit failed-simplification-attempt-limit: "
+                << failed_attempts;
+      break;
+    }
+    if (total_attempts >= total_attempt_limit) {
+      LOG(INFO) << "Hit total-attempt-limit: " << total_attempts;
+      break;
+    }
+    ++rounds;
+
+    std::vector<BatchCandidate> batch;
+    absl::flat_hash_set<std::string> seen = {knownf_ir_text};
+    auto add_candidate = [&](BatchCandidate candidate) {
+      if (seen.insert(candidate.ir_text).second) {
+        batch.push_back(std::move(candidate));
+      }
+    };
+
+    std::vector<BisectableNode> nodes;
+    if (bisect) {
+      nodes = GetBisectableNodes(package.get());
+      granularity = std::min<int64_t>(granularity, nodes.size());
+      // Leave at least half of the batch for random simplifications.
+      const int64_t bisection_slots = std::max<int64_t>(parallelism / 2, 1);
+      const int64_t chunk_size =
+          nodes.empty() ? 0 : (nodes.size() + granularity - 1) / granularity;
+      while (batch.size() < bisection_slots && next_chunk < granularity) {
+        const int64_t begin = next_chunk * chunk_size;
+        const int64_t end =
+            std::min<int64_t>(begin + chunk_size, nodes.size());
+        ++next_chunk;
+        if (begin >= end) {
+          continue;
+        }
+        XLS_ASSIGN_OR_RETURN(
+            BatchCandidate candidate,
+            ReplaceNodesWithLiterals(
+                knownf_ir_text,
+                absl::MakeConstSpan(nodes).subspan(begin, end - begin),
+                can_remove_params));
+        add_candidate(std::move(candidate));
+      }
+    }
+
+    bool cannot_change = false;
+    for (int64_t attempt = 0;
+         batch.size() < parallelism &&
+         attempt < kGenerationAttemptsPerCandidate * parallelism;
+         ++attempt) {
+      BatchCandidate candidate;
+      XLS_ASSIGN_OR_RETURN(
+          SimplificationResult result,
+          GenerateRandomCandidate(knownf_ir_text, inputs, rng,
+                                  can_remove_params, &candidate));
+      if (result == SimplificationResult::kCannotChange) {
+        cannot_change = true;
+        break;
+      }
+      if (result == SimplificationResult::kDidChange) {
+        add_candidate(std::move(candidate));
+      }
+    }
+    if (batch.empty()) {
+      if (cannot_change) {
+        LOG(INFO) << "Cannot simplify any further, done!";
+        break;
+      }
+      failed_attempts += kGenerationAttemptsPerCandidate * parallelism;
+      total_attempts += kGenerationAttemptsPerCandidate * parallelism;
+      continue;
+    }
+
+    // Only run the test on candidates which have not been tested before.
+    std::vector<bool> still_fails(batch.size());
+    std::vector<BatchCandidate> untested;
+    std::vector<int64_t> untested_indices;
+    for (int64_t i = 0; i < batch.size(); ++i) {
+      auto it = test_cache.find(batch[i].ir_text);
+      if (it != test_cache.end()) {
+        still_fails[i] = it->second;
+      } else {
+        untested.push_back(batch[i]);
+        untested_indices.push_back(i);
+      }
+    }
+    XLS_ASSIGN_OR_RETURN(std::vector<bool> results,
+                         TestCandidatesInParallel(untested, work_dirs));
+    for (int64_t i = 0; i < untested.size(); ++i) {
+      still_fails[untested_indices[i]] = results[i];
+      test_cache[untested[i].ir_text] = results[i];
+    }
+    total_attempts += batch.size();
+
+    std::optional<int64_t> best;
+    for (int64_t i = 0; i < batch.size(); ++i) {
+      if (still_fails[i] &&
+          (!best.has_value() || batch[i].node_count < batch[*best].node_count ||
+           (batch[i].node_count == batch[*best].node_count &&
+            batch[i].ir_text.size() < batch[*best].ir_text.size()))) {
+        best = i;
+      }
+    }
+
+    if (best.has_value()) {
+      BatchCandidate& known_failure = batch[*best];
+      std::cerr << "---\ntransform: " << known_failure.which_transform << "\n"
+                << (known_failure.node_count > 50 ? ""
+                                                  : known_failure.ir_text)
+                << "(" << known_failure.node_count << " nodes)\n";
+      knownf_ir_text = std::move(known_failure.ir_text);
+      if (output_path != "-") {
+        XLS_RETURN_IF_ERROR(
+            SetFileContentsAtomically(output_path, knownf_ir_text));
+      }
+      XLS_ASSIGN_OR_RETURN(package, ParsePackage(knownf_ir_text));
+      failed_attempts = 0;
+      // The bisectable nodes changed; start over at a slightly coarser
+      // granularity.
+      bisect = absl::GetFlag(FLAGS_bisect_nodes);
+      granularity = std::max<int64_t>(granularity - 1, 2);
+      next_chunk = 0;
+    } else {
+      failed_attempts += batch.size();
+      if (bisect && next_chunk >= granularity) {
+        if (granularity >= nodes.size()) {
+          // No single node can be replaced; leave it to the random
+          // simplifications to make progress.
+          bisect = false;
+        } else {
+          granularity = std::min<int64_t>(2 * granularity, nodes.size());
+          next_chunk = 0;
+        }
+      }
+    }
+
+    const double seconds =
+        std::max(absl::ToDoubleSeconds(absl::Now() - start), 1e-6);
+    const int64_t node_count = package->GetNodeCount();
+    LOG(INFO) << absl::StreamFormat(
+        "Round %d: %d/%d candidates still fail, %d nodes left (%d removed); "
+        "%.2f candidates/s, %.2f nodes removed/s",
+        rounds, absl::c_count(still_fails, true), batch.size(), node_count,
+        initial_node_count - node_count, total_attempts / seconds,
+        (initial_node_count - node_count) / seconds);
+  }
+  return knownf_ir_text;
+}
+
+// Writes out the minimized IR and verifies that it still fails.
+absl::Status WriteMinimizedIr(std::string_view knownf_ir_text,
+                              std::string_view output_path,
+                              std::optional<std::vector<Value>> inputs) {
+  if (output_path == "-") {
+    std::cout << knownf_ir_text;
+  } else {
+    XLS_RETURN_IF_ERROR(SetFileContentsAtomically(output_path, knownf_ir_text));
+  }
+
+  // Run the last test verification without the cache.
+  XLS_RETURN_IF_ERROR(VerifyStillFails(knownf_ir_text, inputs,
+                                       "Minimized function does not fail!",
+                                       /*test_cache=*/nullptr));
+
+  return absl::OkStatus();
+}
+
 absl::Status RealMain(std::string_view path, std::string_view output_path,
                       const int64_t failed_attempt_limit,
                       const int64_t total_attempt_limit,
@@ -1371,6 +1763,16 @@ absl::Status RealMain(std::string_view path, std::string_view output_path,
     LOG(INFO) << "=== Done cleaning up initial garbage";
   }
 
+  if (const int64_t parallelism = absl::GetFlag(FLAGS_parallelism);
+      parallelism > 1) {
+    XLS_ASSIGN_OR_RETURN(
+        knownf_ir_text,
+        MinimizeInBatches(std::move(knownf_ir_text), output_path, inputs,
+                          parallelism, can_remove_params, failed_attempt_limit,
+                          total_attempt_limit, test_cache));
+    return WriteMinimizedIr(knownf_ir_text, output_path, inputs);
+  }
+
   // If so, we start simplifying via this seeded RNG.
   std::mt19937 rng;  // Default constructor uses deterministic seed.
 
@@ -1570,18 +1972,7 @@ absl::Status RealMain(std::string_view path, std::string_view output_path,
     candidate_changes.clear();
   }
 
-  if (output_path == "-") {
-    std::cout << knownf_ir_text;
-  } else {
-    XLS_RETURN_IF_ERROR(SetFileContentsAtomically(output_path, knownf_ir_text));
-  }
-
-  // Run the last test verification without the cache.
-  XLS_RETURN_IF_ERROR(VerifyStillFails(knownf_ir_text, inputs,
-                                       "Minimized function does not fail!",
-                                       /*test_cache=*/nullptr));
-
-  return absl::OkStatus();
+  return WriteMinimizedIr(knownf_ir_text, output_path, inputs);
 }
 
 }  // namespace
@@ -1609,6 +2000,11 @@ int main(int argc, char** argv) {
   QCHECK_EQ(test_flags, 1)
       << "Must specify exactly one of --test_executable, --test_llvm_jit, or "
          "--test_optimizer";
+  QCHECK_GE(absl::GetFlag(FLAGS_parallelism), 1)
+      << "--parallelism must be at least one";
+  QCHECK(absl::GetFlag(FLAGS_parallelism) == 1 ||
+         !absl::GetFlag(FLAGS_test_executable).empty())
+      << "--parallelism greater than one requires --test_executable";
 
   if (absl::GetFlag(FLAGS_can_extract_segments)) {
     std::vector<std::string> failures;
@@ -162,9 +162,9 @@ class BytecodeInterpreter {
   std::string FormatChannelNameForTracing(const Bytecode::ChannelData& channel);
 
  private:
-  // Runs the next instruction in the current frame. Returns an error if called
-  // when the PC is already pointing to the end of the bytecode.
-  absl::Status EvalNextInstruction();
+  // Runs `bytecode`, which must be the instruction at the PC of the current
+  // frame.
+  absl::Status EvalNextInstruction(const Bytecode& bytecode);
 
   absl::Status EvalAdd(const Bytecode& bytecode, bool is_signed);
   absl::Status EvalSub(const Bytecode& bytecode, bool is_signed);
@@ -221,9 +221,12 @@ class BytecodeInterpreter {
   absl::Status EvalWidthSlice(const Bytecode& bytecode);
   absl::Status EvalXor(const Bytecode& bytecode);
 
-  absl::Status EvalBinop(
-      const std::function<absl::StatusOr<InterpValue>(
-          const InterpValue& lhs, const InterpValue& rhs)>& op);
+  // Applies `op` to the top two stack values (lhs below rhs) and replaces them
+  // with the result. `op` returns an InterpValue or
+  // absl::StatusOr<InterpValue>. This is a template rather than taking a
+  // std::function as it is on the interpreter's hot path.
+  template <typename OpT>
+  absl::Status EvalBinop(OpT op);
 
   absl::StatusOr<BytecodeFunction*> GetBytecodeFn(
       Function& function, const Invocation* invocation,
@@ -0,0 +1,126 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Microbenchmarks for the DSLX bytecode interpreter's dispatch loop and
+// common operations.
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "absl/log/check.h"
+#include "absl/status/statusor.h"
+#include "xls/common/benchmark_support.h"
+#include "xls/common/init_xls.h"
+#include "xls/dslx/bytecode/bytecode.h"
+#include "xls/dslx/bytecode/bytecode_emitter.h"
+#include "xls/dslx/bytecode/bytecode_interpreter.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/interp_value.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/type_system/parametric_env.h"
+
+namespace xls::dslx {
+namespace {
+
+// Arithmetic on narrow (<= 64 bit) values in a counted loop; dominated by
+// load/binop/store sequences.
+constexpr std::string_view kNarrowArithmetic = R"(
+fn main(x: u32) -> u32 {
+  for (i, acc): (u32, u32) in u32:0..u32:1000 {
+    (acc + i * x) ^ (acc >> u32:3)
+  }(u32:0)
+}
+)";
+
+// As above but on values wider than 64 bits.
+constexpr std::string_view kWideArithmetic = R"(
+fn main(x: u128) -> u128 {
+  for (i, acc): (u32, u128) in u32:0..u32:1000 {
+    (acc + (i as u128) * x) ^ (acc >> u128:3)
+  }(u128:0)
+}
+)";
+
+// Comparisons feeding conditional jumps.
+constexpr std::string_view kCompareAndBranch = R"(
+fn main(x: u32) -> u32 {
+  for (i, acc): (u32, u32) in u32:0..u32:1000 {
+    if i < x { acc + u32:1 } else if i == x { acc } else { acc - u32:1 }
+  }(u32:0)
+}
+)";
+
+// Calls to a small function in a loop.
+constexpr std::string_view kCalls = R"(
+fn step(a: u32, b: u32) -> u32 { a + b }
+
+fn main(x: u32) -> u32 {
+  for (i, acc): (u32, u32) in u32:0..u32:1000 {
+    step(acc, i ^ x)
+  }(u32:0)
+}
+)";
+
+void RunProgram(benchmark::State& state, std::string_view program,
+                const InterpValue& arg) {
+  ImportData import_data = CreateImportDataForTest();
+  TypecheckedModule tm =
+      ParseAndTypecheck(program, "bench.x", "bench", &import_data).value();
+  Function* f = tm.module->GetMemberOrError<Function>("main").value();
+  std::unique_ptr<BytecodeFunction> bf =
+      BytecodeEmitter::Emit(&import_data, tm.type_info, *f, ParametricEnv())
+          .value();
+  std::vector<InterpValue> args = {arg};
+  for (auto _ : state) {
+    absl::StatusOr<InterpValue> result =
+        BytecodeInterpreter::Interpret(&import_data, bf.get(), args);
+    CHECK_OK(result.status());
+    benchmark::DoNotOptimize(result);
+  }
+}
+
+void BM_NarrowArithmetic(benchmark::State& state) {
+  RunProgram(state, kNarrowArithmetic, InterpValue::MakeU32(7));
+}
+
+void BM_WideArithmetic(benchmark::State& state) {
+  RunProgram(state, kWideArithmetic, InterpValue::MakeUBits(128, 7));
+}
+
+void BM_CompareAndBranch(benchmark::State& state) {
+  RunProgram(state, kCompareAndBranch, InterpValue::MakeU32(500));
+}
+
+void BM_Calls(benchmark::State& state) {
+  RunProgram(state, kCalls, InterpValue::MakeU32(7));
+}
+
+BENCHMARK(BM_NarrowArithmetic);
+BENCHMARK(BM_WideArithmetic);
+BENCHMARK(BM_CompareAndBranch);
+BENCHMARK(BM_Calls);
+
+}  // namespace
+}  // namespace xls::dslx
+
+int main(int argc, char* argv[]) {
+  xls::InitXls(argv[0], argc, argv);
+  xls::RunSpecifiedBenchmarks(/*default_spec=*/"all");
+  return 0;
+}
@@ -27,6 +27,7 @@
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
+#include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/interp_value.h"
@@ -83,6 +84,34 @@ class InterpreterStack {
     stack_.push_back(std::move(value));
   }
 
+  // Pops the top `count` values and pushes `value`. Equivalent to `count`
+  // calls to Pop() followed by Push(value), but reuses the stack slot.
+  absl::Status ReplaceTop(int64_t count, InterpValue value) {
+    XLS_RET_CHECK_GE(count, 1);
+    if (stack_.size() < count) {
+      return absl::InternalError(absl::StrFormat(
+          "Tried to replace the top %d values of a stack of size %d.", count,
+          stack_.size()));
+    }
+    VLOG(3) << absl::StreamFormat("ReplaceTop(%d, %s)", count,
+                                  value.ToString());
+    stack_.erase(stack_.end() - (count - 1), stack_.end());
+    stack_.back() = FormattedInterpValue{.value = std::move(value),
+                                         .format_descriptor = std::nullopt};
+    return absl::OkStatus();
+  }
+
+  // Returns the value `from_top` entries below the top of the stack without
+  // popping it. The pointer is invalidated by any modification of the stack.
+  absl::StatusOr<const InterpValue*> Peek(int64_t from_top = 0) const {
+    if (stack_.size() <= from_top) {
+      return absl::InternalError(
+          absl::StrFormat("Tried to peek at from_top=%d of a stack of size %d.",
+                          from_top, stack_.size()));
+    }
+    return &stack_[stack_.size() - from_top - 1].value;
+  }
+
   const InterpValue& PeekOrDie(int64_t from_top = 0) const {
     CHECK_GE(stack_.size(), from_top + 1) << absl::StreamFormat(
         "Attempted to peek at from_top=%d but stack size is %d", from_top,
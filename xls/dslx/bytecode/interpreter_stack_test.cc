@@ -40,5 +40,32 @@ TEST(InterpreterStackTest, PushThenDoublePop) {
                                      "Tried to pop off an empty stack."));
 }
 
+TEST(InterpreterStackTest, PeekAndReplaceTop) {
+  FileTable file_table;
+  InterpreterStack stack(file_table);
+  stack.Push(InterpValue::MakeU32(1));
+  stack.Push(InterpValue::MakeU32(2));
+  XLS_ASSERT_OK_AND_ASSIGN(const InterpValue* top, stack.Peek());
+  EXPECT_TRUE(top->Eq(InterpValue::MakeU32(2)));
+  XLS_ASSERT_OK_AND_ASSIGN(const InterpValue* below, stack.Peek(1));
+  EXPECT_TRUE(below->Eq(InterpValue::MakeU32(1)));
+
+  XLS_ASSERT_OK(stack.ReplaceTop(2, InterpValue::MakeU32(3)));
+  EXPECT_EQ(stack.size(), 1);
+  XLS_ASSERT_OK_AND_ASSIGN(top, stack.Peek());
+  EXPECT_TRUE(top->Eq(InterpValue::MakeU32(3)));
+}
+
+TEST(InterpreterStackTest, PeekAndReplaceTopReportUnderflow) {
+  FileTable file_table;
+  InterpreterStack stack(file_table);
+  stack.Push(InterpValue::MakeU32(1));
+  EXPECT_THAT(stack.Peek(1),
+              absl_testing::StatusIs(absl::StatusCode::kInternal));
+  EXPECT_THAT(stack.ReplaceTop(2, InterpValue::MakeU32(3)),
+              absl_testing::StatusIs(absl::StatusCode::kInternal));
+  EXPECT_EQ(stack.size(), 1);
+}
+
 }  // namespace
 }  // namespace xls::dslx
@@ -61,6 +61,60 @@
 #include "xls/ir/bits.h"
 
 namespace xls::dslx {
+namespace {
+
+// Evaluates a binary operation on constexpr bits operands directly, without
+// emitting and interpreting bytecode. The result is the same as the bytecode
+// interpreter's, since it uses the same InterpValue operation.
+//
+// Returns nullopt for operators that need the interpreter (e.g. the
+// short-circuiting logical operators) and for non-bits operands.
+absl::StatusOr<std::optional<InterpValue>> EvaluateBitsBinop(
+    BinopKind kind, const InterpValue& lhs, const InterpValue& rhs) {
+  if (!lhs.IsBits() || !rhs.IsBits()) {
+    return std::nullopt;
+  }
+  switch (kind) {
+    case BinopKind::kAdd:
+      return lhs.Add(rhs);
+    case BinopKind::kSub:
+      return lhs.Sub(rhs);
+    case BinopKind::kMul:
+      return lhs.Mul(rhs);
+    case BinopKind::kDiv:
+      return lhs.FloorDiv(rhs);
+    case BinopKind::kMod:
+      return lhs.FloorMod(rhs);
+    case BinopKind::kAnd:
+      return lhs.BitwiseAnd(rhs);
+    case BinopKind::kOr:
+      return lhs.BitwiseOr(rhs);
+    case BinopKind::kXor:
+      return lhs.BitwiseXor(rhs);
+    case BinopKind::kShl:
+      return lhs.Shl(rhs);
+    case BinopKind::kShr:
+      return lhs.IsSigned() ? lhs.Shra(rhs) : lhs.Shrl(rhs);
+    case BinopKind::kConcat:
+      return lhs.Concat(rhs);
+    case BinopKind::kEq:
+      return InterpValue::MakeBool(lhs.Eq(rhs));
+    case BinopKind::kNe:
+      return InterpValue::MakeBool(lhs.Ne(rhs));
+    case BinopKind::kLt:
+      return lhs.Lt(rhs);
+    case BinopKind::kLe:
+      return lhs.Le(rhs);
+    case BinopKind::kGt:
+      return lhs.Gt(rhs);
+    case BinopKind::kGe:
+      return lhs.Ge(rhs);
+    default:
+      return std::nullopt;
+  }
+}
+
+}  // namespace
 
 /* static */ absl::Status ConstexprEvaluator::Evaluate(
     ImportData* import_data, TypeInfo* type_info,
@@ -188,8 +242,17 @@ absl::Status ConstexprEvaluator::HandleArray(const Array* expr) {
 
 absl::Status ConstexprEvaluator::HandleBinop(const Binop* expr) {
   VLOG(3) << "ConstexprEvaluator::HandleBinop : " << expr->ToString();
-  EVAL_AS_CONSTEXPR_OR_RETURN(expr->lhs());
-  EVAL_AS_CONSTEXPR_OR_RETURN(expr->rhs());
+  GET_CONSTEXPR_OR_RETURN(InterpValue lhs, expr->lhs());
+  GET_CONSTEXPR_OR_RETURN(InterpValue rhs, expr->rhs());
+
+  // Simple arithmetic (e.g. on parametrics) is by far the most common case, and
+  // doesn't need the interpreter.
+  XLS_ASSIGN_OR_RETURN(std::optional<InterpValue> result,
+                       EvaluateBitsBinop(expr->binop_kind(), lhs, rhs));
+  if (result.has_value()) {
+    type_info_->NoteConstExpr(expr, *std::move(result));
+    return absl::OkStatus();
+  }
   return InterpretExpr(expr);
 }
 
@@ -594,8 +657,23 @@ absl::Status ConstexprEvaluator::HandleConditional(const Conditional* expr) {
 }
 
 absl::Status ConstexprEvaluator::HandleUnop(const Unop* expr) {
-  EVAL_AS_CONSTEXPR_OR_RETURN(expr->operand());
-
+  GET_CONSTEXPR_OR_RETURN(InterpValue operand, expr->operand());
+
+  // No need to fire up the interpreter for bits operands.
+  if (operand.IsBits()) {
+    absl::StatusOr<InterpValue> result;
+    switch (expr->unop_kind()) {
+      case UnopKind::kInvert:
+        result = operand.BitwiseNegate();
+        break;
+      case UnopKind::kNegate:
+        result = operand.ArithmeticNegate();
+        break;
+    }
+    XLS_RETURN_IF_ERROR(result.status());
+    type_info_->NoteConstExpr(expr, *std::move(result));
+    return absl::OkStatus();
+  }
   return InterpretExpr(expr);
 }
 
@@ -474,6 +474,31 @@ fn main() -> s32 {
   EXPECT_EQ(value.GetBitValueViaSign().value(), -1337);
 }
 
+TEST(ConstexprEvaluatorTest, HandleNestedBinops) {
+  constexpr std::string_view kProgram = R"(
+fn main() -> s32 {
+  (s32:-16 >> u32:2) + (s32:1 << u32:4) * s32:3
+}
+)";
+
+  ImportData import_data(CreateImportDataForTest());
+  XLS_ASSERT_OK_AND_ASSIGN(
+      TypecheckedModule tm,
+      ParseAndTypecheck(kProgram, "test.x", "test", &import_data));
+
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f,
+                           tm.module->GetMemberOrError<Function>("main"));
+  Binop* binop = down_cast<Binop*>(GetSingleBodyExpr(f));
+  XLS_ASSERT_OK_AND_ASSIGN(Type * type, GetType(tm.type_info, binop));
+  WarningCollector warnings(kAllWarningsSet);
+  XLS_ASSERT_OK(ConstexprEvaluator::Evaluate(
+      &import_data, tm.type_info, &warnings, ParametricEnv(), binop, type));
+  XLS_ASSERT_OK_AND_ASSIGN(InterpValue value,
+                           tm.type_info->GetConstExpr(binop));
+  EXPECT_TRUE(value.IsSigned());
+  EXPECT_EQ(value.GetBitValueViaSign().value(), 44);
+}
+
 TEST(ConstexprEvaluatorTest, BasicTupleIndex) {
   constexpr std::string_view kProgram = R"(
 fn main() -> u32 {
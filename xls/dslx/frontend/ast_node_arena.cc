@@ -0,0 +1,64 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/frontend/ast_node_arena.h"
+
+#include <cstddef>
+#include <memory>
+
+#include "xls/dslx/frontend/ast_node.h"
+
+namespace xls::dslx {
+
+size_t AstNodeArena::bytes_reserved() const {
+  size_t total = 0;
+  for (const auto& [block, size] : blocks_) {
+    total += size;
+  }
+  return total;
+}
+
+void* AstNodeArena::Allocate(size_t size) {
+  // Storage from `new std::byte[]` is suitably aligned for any object of
+  // fundamental alignment, so keeping every allocation a multiple of that
+  // alignment keeps every node aligned.
+  constexpr size_t kAlign = alignof(std::max_align_t);
+  size = (size + kAlign - 1) & ~(kAlign - 1);
+  if (size > kBlockSize) {
+    blocks_.push_back({std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+    return blocks_.back().first.get();
+  }
+  if (size > remaining_) {
+    blocks_.push_back(
+        {std::unique_ptr<std::byte[]>(new std::byte[kBlockSize]), kBlockSize});
+    cursor_ = blocks_.back().first.get();
+    remaining_ = kBlockSize;
+  }
+  void* result = cursor_;
+  cursor_ += size;
+  remaining_ -= size;
+  return result;
+}
+
+void AstNodeArena::Clear() {
+  for (AstNode* node : nodes_) {
+    node->~AstNode();
+  }
+  nodes_.clear();
+  blocks_.clear();
+  cursor_ = nullptr;
+  remaining_ = 0;
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,100 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_FRONTEND_AST_NODE_ARENA_H_
+#define XLS_DSLX_FRONTEND_AST_NODE_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "xls/dslx/frontend/ast_node.h"
+
+namespace xls::dslx {
+
+// Bump allocator that owns the AST nodes of a single module.
+//
+// Nodes are placement-constructed into large contiguous blocks instead of
+// being heap allocated one at a time, which avoids per-node allocator overhead
+// and keeps nodes created together (e.g. by the parser, or the type
+// annotations synthesized during type inference) close together in memory.
+// Node addresses are stable for the lifetime of the arena. Nodes are destroyed
+// in creation order when the arena is destroyed; individual nodes cannot be
+// freed.
+class AstNodeArena {
+ public:
+  AstNodeArena() = default;
+  ~AstNodeArena() { Clear(); }
+
+  AstNodeArena(AstNodeArena&& other)
+      : blocks_(std::move(other.blocks_)),
+        nodes_(std::move(other.nodes_)),
+        cursor_(std::exchange(other.cursor_, nullptr)),
+        remaining_(std::exchange(other.remaining_, 0)) {
+    other.blocks_.clear();
+    other.nodes_.clear();
+  }
+  AstNodeArena& operator=(AstNodeArena&& other) {
+    if (this != &other) {
+      Clear();
+      blocks_ = std::move(other.blocks_);
+      nodes_ = std::move(other.nodes_);
+      cursor_ = std::exchange(other.cursor_, nullptr);
+      remaining_ = std::exchange(other.remaining_, 0);
+      other.blocks_.clear();
+      other.nodes_.clear();
+    }
+    return *this;
+  }
+
+  AstNodeArena(const AstNodeArena&) = delete;
+  AstNodeArena& operator=(const AstNodeArena&) = delete;
+
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    static_assert(std::is_base_of_v<AstNode, T>);
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "Over-aligned AST nodes are not supported.");
+    void* storage = Allocate(sizeof(T));
+    T* node = new (storage) T(std::forward<Args>(args)...);
+    nodes_.push_back(node);
+    return node;
+  }
+
+  // All nodes owned by the arena, in creation order.
+  const std::vector<AstNode*>& nodes() const { return nodes_; }
+
+  // Total bytes reserved from the system allocator.
+  size_t bytes_reserved() const;
+
+ private:
+  // Size of a regular block; nodes larger than this get a dedicated block.
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  void* Allocate(size_t size);
+  void Clear();
+
+  // Allocated blocks and their sizes.
+  std::vector<std::pair<std::unique_ptr<std::byte[]>, size_t>> blocks_;
+  std::vector<AstNode*> nodes_;
+  std::byte* cursor_ = nullptr;
+  size_t remaining_ = 0;
+};
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_FRONTEND_AST_NODE_ARENA_H_
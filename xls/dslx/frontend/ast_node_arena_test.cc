@@ -0,0 +1,77 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/frontend/ast_node_arena.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/strings/str_cat.h"
+#include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/frontend/module.h"
+#include "xls/dslx/frontend/pos.h"
+
+namespace xls::dslx {
+namespace {
+
+TEST(AstNodeArenaTest, NodesHaveStableAddressesInCreationOrder) {
+  FileTable file_table;
+  Module owner("test", /*fs_path=*/std::nullopt, file_table);
+  AstNodeArena arena;
+  std::vector<NameDef*> created;
+  // Enough nodes to span several blocks.
+  for (int64_t i = 0; i < 10000; ++i) {
+    created.push_back(arena.New<NameDef>(&owner, Span(), absl::StrCat("x", i),
+                                         /*definer=*/nullptr));
+  }
+  ASSERT_EQ(arena.nodes().size(), created.size());
+  for (int64_t i = 0; i < static_cast<int64_t>(created.size()); ++i) {
+    EXPECT_EQ(arena.nodes()[i], created[i]);
+    EXPECT_EQ(created[i]->identifier(), absl::StrCat("x", i));
+  }
+  EXPECT_GT(arena.bytes_reserved(), 0);
+}
+
+TEST(AstNodeArenaTest, MoveTransfersOwnership) {
+  FileTable file_table;
+  Module owner("test", /*fs_path=*/std::nullopt, file_table);
+  AstNodeArena arena;
+  NameDef* name_def = arena.New<NameDef>(&owner, Span(), std::string("x"),
+                                         /*definer=*/nullptr);
+  AstNodeArena moved(std::move(arena));
+  EXPECT_THAT(moved.nodes(), testing::ElementsAre(name_def));
+  EXPECT_EQ(name_def->identifier(), "x");
+
+  // The moved-from arena is empty but still usable.
+  NameDef* other = arena.New<NameDef>(&owner, Span(), std::string("y"),
+                                      /*definer=*/nullptr);
+  EXPECT_THAT(arena.nodes(), testing::ElementsAre(other));
+}
+
+TEST(AstNodeArenaTest, ModuleNodesAreArenaAllocated) {
+  FileTable file_table;
+  Module m("test", /*fs_path=*/std::nullopt, file_table);
+  const Span fake_span;
+  Number* number = m.Make<Number>(fake_span, std::string("42"),
+                                  NumberKind::kOther, /*type=*/nullptr);
+  EXPECT_EQ(m.FindNode(AstNodeKind::kNumber, fake_span), number);
+}
+
+}  // namespace
+}  // namespace xls::dslx
@@ -103,10 +103,10 @@ std::string Module::ToString() const {
 }
 
 const AstNode* Module::FindNode(AstNodeKind kind, const Span& target) const {
-  for (const auto& node : nodes_) {
+  for (const AstNode* node : nodes_.nodes()) {
     if (node->kind() == kind && node->GetSpan().has_value() &&
         node->GetSpan().value() == target) {
-      return node.get();
+      return node;
     }
   }
   return nullptr;
@@ -114,12 +114,12 @@ const AstNode* Module::FindNode(AstNodeKind kind, const Span& target) const {
 
 std::vector<const AstNode*> Module::FindIntercepting(const Pos& target) const {
   std::vector<const AstNode*> found;
-  for (const auto& node : nodes_) {
-    if (IsSyntheticNode(node.get())) {
+  for (const AstNode* node : nodes_.nodes()) {
+    if (IsSyntheticNode(node)) {
       continue;
     }
     if (node->GetSpan().has_value() && node->GetSpan()->Contains(target)) {
-      found.push_back(node.get());
+      found.push_back(node);
     }
   }
   return found;
@@ -127,13 +127,13 @@ std::vector<const AstNode*> Module::FindIntercepting(const Pos& target) const {
 
 std::vector<const AstNode*> Module::FindContained(const Span& target) const {
   std::vector<const AstNode*> found;
-  for (const auto& node : nodes_) {
-    if (IsSyntheticNode(node.get())) {
+  for (const AstNode* node : nodes_.nodes()) {
+    if (IsSyntheticNode(node)) {
       continue;
     }
     if (std::optional<Span> node_span = node->GetSpan();
         node_span.has_value() && target.Contains(node_span.value())) {
-      found.push_back(node.get());
+      found.push_back(node);
     }
   }
   return found;
@@ -37,6 +37,7 @@
 #include "absl/strings/str_split.h"
 #include "absl/types/span.h"
 #include "xls/dslx/frontend/ast.h"
+#include "xls/dslx/frontend/ast_node_arena.h"
 #include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/frontend/proc.h"
 
@@ -316,6 +317,11 @@ class Module : public AstNode {
 
   FileTable* file_table() const { return file_table_; }
 
+  // Points the module at a different file table. The file numbers in the
+  // module's spans must name the same files in `file_table` as in the table
+  // the module was parsed with.
+  void set_file_table(FileTable& file_table) { file_table_ = &file_table; }
+
   absl::Status SetConfiguredValues(std::vector<std::string> configured_values) {
     absl::flat_hash_map<std::string, std::string> configured_values_map;
     for (const auto& item : configured_values) {
@@ -339,11 +345,8 @@ class Module : public AstNode {
  private:
   template <typename T, typename... Args>
   T* MakeInternal(Args&&... args) {
-    std::unique_ptr<T> node =
-        std::make_unique<T>(this, std::forward<Args>(args)...);
-    T* ptr = node.get();
+    T* ptr = nodes_.New<T>(this, std::forward<Args>(args)...);
     ptr->SetParentage();
-    nodes_.push_back(std::move(node));
     return ptr;
   }
 
@@ -382,7 +385,7 @@ class Module : public AstNode {
   FileTable* file_table_;
 
   std::vector<ModuleMember> top_;  // Top-level members of this module.
-  std::vector<std::unique_ptr<AstNode>> nodes_;  // Lifetime-owned AST nodes.
+  AstNodeArena nodes_;  // Lifetime-owned AST nodes.
 
   // Same as `top_` but as a set, for quick contains() checks.
   absl::flat_hash_set<const AstNode*> top_set_;
@@ -57,6 +57,27 @@ class FileTable {
   // URI to filesystem path happen beyond the file table implementation.
   Fileno GetOrCreate(std::string_view path);
 
+  // Returns the file number of `path` if it is already in the table.
+  std::optional<Fileno> Find(std::string_view path) const {
+    auto it = path_to_number_.find(path);
+    if (it == path_to_number_.end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
+  // Returns the file number `GetOrCreate` will assign to the next new path.
+  Fileno next_fileno() const { return next_fileno_; }
+
+  // Makes `GetOrCreate` assign new paths numbers starting at `fileno`, which
+  // must not be below `next_fileno()`. This lets a file be parsed into a
+  // scratch table with the number it is expected to receive in another table
+  // (see `PrefetchImports()`).
+  void SkipTo(Fileno fileno) {
+    CHECK_GE(fileno.value(), next_fileno_.value());
+    next_fileno_ = fileno;
+  }
+
   std::string_view Get(Fileno fileno) const {
     DCHECK(number_to_path_.contains(fileno))
         << "fileno " << fileno.value() << " not found in FileTable";
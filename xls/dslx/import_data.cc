@@ -95,6 +95,39 @@ absl::StatusOr<ModuleInfo*> ImportData::Put(
   return pmodule_info;
 }
 
+void ImportData::AddPrefetchedModule(
+    const ImportTokens& subject, std::filesystem::path source_path,
+    Fileno fileno, std::unique_ptr<FileTable> scratch_file_table,
+    std::unique_ptr<Module> module) {
+  prefetched_modules_.insert_or_assign(
+      subject,
+      PrefetchedModule{.source_path = std::move(source_path),
+                       .fileno = fileno,
+                       .scratch_file_table = std::move(scratch_file_table),
+                       .module = std::move(module)});
+}
+
+std::unique_ptr<Module> ImportData::TakePrefetchedModule(
+    const ImportTokens& subject, const std::filesystem::path& source_path,
+    Fileno fileno) {
+  auto it = prefetched_modules_.find(subject);
+  if (it == prefetched_modules_.end()) {
+    return nullptr;
+  }
+  PrefetchedModule prefetched = std::move(it->second);
+  prefetched_modules_.erase(it);
+  if (prefetched.source_path != source_path || prefetched.fileno != fileno) {
+    VLOG(3) << "Discarding prefetched " << subject.ToString()
+            << "; it was parsed as file number " << prefetched.fileno.value()
+            << " but is imported as " << fileno.value();
+    return nullptr;
+  }
+  // The spans of the module name `fileno`, which now maps to the same path in
+  // the real file table as it did in the scratch table.
+  prefetched.module->set_file_table(file_table());
+  return std::move(prefetched.module);
+}
+
 absl::StatusOr<TypeInfo*> ImportData::GetRootTypeInfoForNode(
     const AstNode* node) {
   XLS_RET_CHECK(node != nullptr);
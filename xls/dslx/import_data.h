@@ -160,6 +160,32 @@ class ImportData {
   absl::StatusOr<ModuleInfo*> Put(const ImportTokens& subject,
                                   std::unique_ptr<ModuleInfo> module_info);
 
+  // Holds a module which has been parsed ahead of its import (see
+  // `PrefetchImports()`) so that the import only needs to typecheck it.
+  //
+  // The module was parsed into `scratch_file_table` as file number `fileno`,
+  // the number its path is expected to receive in `file_table()` when it is
+  // imported.
+  void AddPrefetchedModule(const ImportTokens& subject,
+                           std::filesystem::path source_path, Fileno fileno,
+                           std::unique_ptr<FileTable> scratch_file_table,
+                           std::unique_ptr<Module> module);
+
+  // Removes the prefetched module for `subject`, if any, and returns it if it
+  // was parsed from `source_path` as file number `fileno` (which the caller
+  // has just obtained from `file_table()`), or nullptr otherwise. The returned
+  // module refers to `file_table()`; ownership is transferred to the caller.
+  std::unique_ptr<Module> TakePrefetchedModule(
+      const ImportTokens& subject, const std::filesystem::path& source_path,
+      Fileno fileno);
+
+  bool HasPrefetchedModule(const ImportTokens& subject) const {
+    return prefetched_modules_.contains(subject);
+  }
+
+  // Discards any prefetched modules which were not imported.
+  void ClearPrefetchedModules() { prefetched_modules_.clear(); }
+
   // Creates the `InferenceTable` for the corpus, if it does not already exist,
   // and returns it. This is a data structure only used by type inference v2.
   InferenceTable* GetOrCreateInferenceTable() {
@@ -304,6 +330,14 @@ class ImportData {
       top_level_bindings_;
   absl::flat_hash_set<Module*> top_level_bindings_done_;
   absl::flat_hash_map<Module*, AstNode*> typecheck_wip_;
+
+  struct PrefetchedModule {
+    std::filesystem::path source_path;
+    Fileno fileno;
+    std::unique_ptr<FileTable> scratch_file_table;
+    std::unique_ptr<Module> module;
+  };
+  absl::flat_hash_map<ImportTokens, PrefetchedModule> prefetched_modules_;
   TypeInfoOwner type_info_owner_;
   const std::filesystem::path stdlib_path_;
   std::vector<std::filesystem::path> additional_search_paths_;
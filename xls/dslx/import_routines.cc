@@ -15,15 +15,19 @@
 #include "xls/dslx/import_routines.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "absl/cleanup/cleanup.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -36,11 +40,13 @@
 #include "xls/common/file/get_runfile_path.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/dslx/frontend/ast.h"
 #include "xls/dslx/frontend/module.h"
 #include "xls/dslx/frontend/parser.h"
 #include "xls/dslx/frontend/pos.h"
 #include "xls/dslx/frontend/scanner.h"
+#include "xls/dslx/frontend/token.h"
 #include "xls/dslx/import_data.h"
 #include "xls/dslx/virtualizable_file_system.h"
 
@@ -193,6 +199,21 @@ static absl::StatusOr<std::unique_ptr<ModuleInfo>> DslxPathToModuleInfo(
   absl::Cleanup cleanup = absl::MakeCleanup(
       [&] { CHECK_OK(import_data->PopFromImporterStack(span)); });
 
+  absl::Span<std::string const> pieces = subject.pieces();
+  std::string fully_qualified_name = absl::StrJoin(pieces, ".");
+
+  if (import_data->HasPrefetchedModule(subject)) {
+    // The file number is assigned here, as it would be when parsing below, so
+    // that it does not depend on whether the module was prefetched.
+    Fileno fileno = file_table.GetOrCreate(dslx_path.source_path.c_str());
+    if (std::unique_ptr<Module> module = import_data->TakePrefetchedModule(
+            subject, dslx_path.source_path, fileno);
+        module != nullptr) {
+      VLOG(3) << "Typechecking prefetched " << fully_qualified_name;
+      return ftypecheck(std::move(module), dslx_path.source_path);
+    }
+  }
+
   // Use the "filesystem_path" for reading the contents but the "source_path"
   // for other uses. This avoids decorated paths like
   // "/build/work/.../runfiles/...a/b/c/foo.x" appearing in the file table and
@@ -200,8 +221,6 @@ static absl::StatusOr<std::unique_ptr<ModuleInfo>> DslxPathToModuleInfo(
   XLS_ASSIGN_OR_RETURN(std::string contents,
                        vfs.GetFileContents(dslx_path.filesystem_path));
 
-  absl::Span<std::string const> pieces = subject.pieces();
-  std::string fully_qualified_name = absl::StrJoin(pieces, ".");
   VLOG(3) << "Parsing and typechecking " << fully_qualified_name << ": start";
 
   VLOG(4) << "Subject = " << subject.ToString();
@@ -249,6 +268,235 @@ absl::StatusOr<ModuleInfo*> DoImport(const TypecheckModuleFn& ftypecheck,
   return import_data->Put(subject, std::move(module_info));
 }
 
+namespace {
+
+// What PrefetchImports() learns about a module before parsing it.
+struct ScannedModule {
+  DslxPath dslx_path;
+  std::string contents;
+  // The subjects of the module's `import` statements in source order, up to
+  // the first `use` statement, which is recorded as std::nullopt.
+  std::vector<std::optional<ImportTokens>> imports;
+};
+
+// Collects the imports of `contents` from its token stream, which is much
+// cheaper than parsing it.
+std::vector<std::optional<ImportTokens>> ScanImports(
+    const std::filesystem::path& source_path, std::string contents) {
+  FileTable file_table;
+  Scanner scanner(file_table, file_table.GetOrCreate(source_path.c_str()),
+                  std::move(contents));
+  std::vector<std::optional<ImportTokens>> imports;
+  absl::StatusOr<Token> token = scanner.Pop();
+  while (token.ok() && token->kind() != TokenKind::kEof) {
+    if (token->IsKeyword(Keyword::kUse)) {
+      imports.push_back(std::nullopt);
+      break;
+    }
+    if (!token->IsKeyword(Keyword::kImport)) {
+      token = scanner.Pop();
+      continue;
+    }
+    std::vector<std::string> pieces;
+    token = scanner.Pop();
+    while (token.ok() && token->kind() == TokenKind::kIdentifier) {
+      pieces.push_back(*token->GetValue());
+      token = scanner.Pop();
+      if (!token.ok() || token->kind() != TokenKind::kDot) {
+        break;
+      }
+      token = scanner.Pop();
+    }
+    if (!pieces.empty()) {
+      imports.push_back(ImportTokens(std::move(pieces)));
+    }
+  }
+  return imports;
+}
+
+// Walks the scanned import graph in the order the typechecker imports modules
+// (depth-first, in member order) to predict the file number each module will
+// receive when it is imported.
+class FilenoPredictor {
+ public:
+  struct Prediction {
+    ImportTokens subject;
+    const ScannedModule* scanned;
+    Fileno fileno;
+  };
+
+  FilenoPredictor(
+      const ImportData& import_data,
+      const absl::flat_hash_map<ImportTokens, ScannedModule>& scanned)
+      : import_data_(import_data),
+        scanned_(scanned),
+        next_fileno_(import_data.file_table().next_fileno()) {}
+
+  // Returns false once the order stops being predictable, i.e. at a `use`
+  // statement (which assigns file numbers of its own) or at an import which
+  // could not be scanned.
+  bool Visit(absl::Span<const std::optional<ImportTokens>> imports) {
+    for (const std::optional<ImportTokens>& subject : imports) {
+      if (!subject.has_value()) {
+        return false;
+      }
+      if (import_data_.Contains(*subject) ||
+          !visited_.insert(*subject).second) {
+        continue;
+      }
+      auto it = scanned_.find(*subject);
+      if (it == scanned_.end()) {
+        return false;
+      }
+      const ScannedModule& module = it->second;
+      std::string path = module.dslx_path.source_path.string();
+      Fileno fileno;
+      if (std::optional<Fileno> existing =
+              import_data_.file_table().Find(path)) {
+        fileno = *existing;
+      } else if (auto [path_it, inserted] =
+                     new_filenos_.try_emplace(path, next_fileno_);
+                 inserted) {
+        fileno = next_fileno_;
+        next_fileno_ = Fileno(next_fileno_.value() + 1);
+      } else {
+        fileno = path_it->second;
+      }
+      predictions_.push_back(Prediction{
+          .subject = *subject, .scanned = &module, .fileno = fileno});
+      if (!Visit(module.imports)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  std::vector<Prediction>& predictions() { return predictions_; }
+
+ private:
+  const ImportData& import_data_;
+  const absl::flat_hash_map<ImportTokens, ScannedModule>& scanned_;
+  Fileno next_fileno_;
+  absl::flat_hash_set<ImportTokens> visited_;
+  absl::flat_hash_map<std::string, Fileno> new_filenos_;
+  std::vector<Prediction> predictions_;
+};
+
+}  // namespace
+
+void PrefetchImports(const Module& module, ImportData* import_data,
+                     VirtualizableFilesystem& vfs) {
+  std::vector<std::optional<ImportTokens>> root_imports;
+  for (const ModuleMember& member : module.top()) {
+    if (std::holds_alternative<Use*>(member)) {
+      root_imports.push_back(std::nullopt);
+      break;
+    }
+    if (std::holds_alternative<Import*>(member)) {
+      root_imports.push_back(
+          ImportTokens(std::get<Import*>(member)->subject()));
+    }
+  }
+
+  // Discover the import closure level by level. Paths are resolved serially;
+  // reading and scanning the files of a level runs on the shared pool.
+  struct ScanJob {
+    ImportTokens subject;
+    ScannedModule module;
+    bool read = false;
+  };
+  absl::flat_hash_map<ImportTokens, ScannedModule> scanned;
+  absl::flat_hash_set<ImportTokens> seen;
+  std::vector<std::optional<ImportTokens>> level = root_imports;
+  while (!level.empty()) {
+    std::vector<ScanJob> jobs;
+    for (const std::optional<ImportTokens>& subject : level) {
+      if (!subject.has_value() || import_data->Contains(*subject) ||
+          import_data->HasPrefetchedModule(*subject) ||
+          !seen.insert(*subject).second) {
+        continue;
+      }
+      absl::StatusOr<DslxPath> dslx_path = FindExistingPath(
+          *subject, import_data->stdlib_path(),
+          import_data->additional_search_paths(), Span::Fake(),
+          import_data->file_table(), vfs);
+      if (dslx_path.ok()) {
+        jobs.push_back(
+            ScanJob{.subject = *subject,
+                    .module = ScannedModule{.dslx_path = *dslx_path}});
+      }
+    }
+    ParallelFor(ThreadPool::Shared(), jobs.size(), jobs.size(),
+                [&](int64_t i) {
+                  ScanJob& job = jobs[i];
+                  absl::StatusOr<std::string> contents = vfs.GetFileContents(
+                      job.module.dslx_path.filesystem_path);
+                  if (!contents.ok()) {
+                    return;
+                  }
+                  job.module.contents = *std::move(contents);
+                  job.module.imports = ScanImports(
+                      job.module.dslx_path.source_path, job.module.contents);
+                  job.read = true;
+                });
+    level.clear();
+    for (ScanJob& job : jobs) {
+      if (!job.read) {
+        continue;
+      }
+      level.insert(level.end(), job.module.imports.begin(),
+                   job.module.imports.end());
+      scanned.emplace(std::move(job.subject), std::move(job.module));
+    }
+  }
+
+  // Only modules whose file number can be predicted are worth parsing: the
+  // import discards a prefetched module parsed under a different number.
+  FilenoPredictor predictor(*import_data, scanned);
+  predictor.Visit(root_imports);
+  std::vector<FilenoPredictor::Prediction>& predictions =
+      predictor.predictions();
+
+  struct ParseResult {
+    std::unique_ptr<FileTable> file_table = std::make_unique<FileTable>();
+    absl::StatusOr<std::unique_ptr<Module>> module =
+        absl::UnknownError("Module not parsed");
+  };
+  std::vector<ParseResult> results(predictions.size());
+  ParallelFor(ThreadPool::Shared(), predictions.size(), predictions.size(),
+              [&](int64_t i) {
+                const FilenoPredictor::Prediction& prediction = predictions[i];
+                ParseResult& result = results[i];
+                // Parse into a private table under the predicted number so
+                // that nothing is added to the real file table until the
+                // module is imported.
+                result.file_table->SkipTo(prediction.fileno);
+                Fileno fileno = result.file_table->GetOrCreate(
+                    prediction.scanned->dslx_path.source_path.c_str());
+                Scanner scanner(*result.file_table, fileno,
+                                prediction.scanned->contents);
+                Parser parser(
+                    /*module_name=*/absl::StrJoin(
+                        prediction.subject.pieces(), "."),
+                    &scanner);
+                result.module = parser.ParseModule();
+              });
+
+  for (int64_t i = 0; i < predictions.size(); ++i) {
+    FilenoPredictor::Prediction& prediction = predictions[i];
+    ParseResult& result = results[i];
+    if (!result.module.ok()) {
+      VLOG(3) << "Prefetch parse of " << prediction.subject.ToString()
+              << " failed: " << result.module.status();
+      continue;
+    }
+    import_data->AddPrefetchedModule(
+        prediction.subject, prediction.scanned->dslx_path.source_path,
+        prediction.fileno, std::move(result.file_table),
+        *std::move(result.module));
+  }
+}
+
 absl::StatusOr<UseImportResult> DoImportViaUse(
     const TypecheckModuleFn& ftypecheck, const UseSubject& subject,
     ImportData* import_data, const Span& name_def_span, FileTable& file_table,
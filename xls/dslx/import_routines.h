@@ -58,6 +58,24 @@ absl::StatusOr<ModuleInfo*> DoImport(const TypecheckModuleFn& ftypecheck,
                                      const Span& import_span,
                                      VirtualizableFilesystem& vfs);
 
+// Parses the transitive closure of modules imported (via `import`
+// statements) by `module` ahead of typechecking, and holds the results in
+// `import_data` for DoImport() to consume.
+//
+// The import graph is discovered level by level from the `import` statements
+// in each file's token stream, then every module is parsed concurrently on
+// `ThreadPool::Shared()`. Nothing is added to the file table: each module is
+// parsed into a scratch table under the file number it is predicted to receive
+// when the typechecker imports it (depth-first, in member order), and
+// DoImport() only uses a prefetched module if the prediction held. Prediction
+// stops at the first `use` statement, which assigns file numbers of its own.
+//
+// Typechecking is not parallelized: it still happens in import order when the
+// typechecker reaches each import. Modules which cannot be resolved or parsed
+// are skipped so that the error is reported by the regular import path.
+void PrefetchImports(const Module& module, ImportData* import_data,
+                     VirtualizableFilesystem& vfs);
+
 struct UseImportResult {
   // The `ModuleInfo`s that were imported as we traversed. Note that there can
   // be more that one if there is a chain of `pub use` statements.
@@ -0,0 +1,133 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/import_routines.h"
+
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "absl/status/statusor.h"
+#include "xls/common/status/matchers.h"
+#include "xls/dslx/create_import_data.h"
+#include "xls/dslx/frontend/module.h"
+#include "xls/dslx/frontend/pos.h"
+#include "xls/dslx/import_data.h"
+#include "xls/dslx/parse_and_typecheck.h"
+#include "xls/dslx/virtualizable_file_system.h"
+
+namespace xls::dslx {
+namespace {
+
+using ::testing::HasSubstr;
+
+constexpr std::string_view kMain = R"(
+import a;
+import b;
+
+fn main() -> u32 { a::f() + b::g() }
+)";
+
+ImportData CreateImportData(std::string_view c_contents) {
+  absl::flat_hash_map<std::filesystem::path, std::string> files = {
+      {"/a.x", "import c;\npub fn f() -> u32 { c::h() }\n"},
+      {"/b.x", "import c;\npub fn g() -> u32 { c::h() + u32:1 }\n"},
+      {"/c.x", std::string(c_contents)},
+  };
+  return CreateImportDataForTest(
+      std::make_unique<FakeFilesystem>(files, /*cwd=*/"/"));
+}
+
+TEST(ImportRoutinesTest, PrefetchImportsParsesTransitiveClosure) {
+  ImportData import_data = CreateImportData("pub fn h() -> u32 { u32:42 }\n");
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<Module> module,
+      ParseModule(kMain, "/main.x", "main", import_data.file_table()));
+
+  PrefetchImports(*module, &import_data, import_data.vfs());
+
+  EXPECT_TRUE(import_data.HasPrefetchedModule(ImportTokens({"a"})));
+  EXPECT_TRUE(import_data.HasPrefetchedModule(ImportTokens({"b"})));
+  EXPECT_TRUE(import_data.HasPrefetchedModule(ImportTokens({"c"})));
+  EXPECT_FALSE(import_data.Contains(ImportTokens({"c"})));
+}
+
+TEST(ImportRoutinesTest, PrefetchImportsDoesNotAssignFilenos) {
+  ImportData import_data = CreateImportData("pub fn h() -> u32 { u32:42 }\n");
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<Module> module,
+      ParseModule(kMain, "/main.x", "main", import_data.file_table()));
+
+  PrefetchImports(*module, &import_data, import_data.vfs());
+
+  for (std::string_view path : {"/a.x", "/b.x", "/c.x"}) {
+    EXPECT_EQ(import_data.file_table().Find(path), std::nullopt) << path;
+  }
+}
+
+TEST(ImportRoutinesTest, PrefetchedImportsGetSerialFilenos) {
+  constexpr std::string_view kC = "pub fn h() -> u32 { u32:42 }\n";
+  ImportData serial_import_data = CreateImportData(kC);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::unique_ptr<Module> module,
+      ParseModule(kMain, "/main.x", "main", serial_import_data.file_table()));
+  XLS_ASSERT_OK(
+      TypecheckModule(std::move(module), "/main.x", &serial_import_data)
+          .status());
+
+  ImportData import_data = CreateImportData(kC);
+  XLS_ASSERT_OK(
+      ParseAndTypecheck(kMain, "/main.x", "main", &import_data).status());
+
+  // Imports are numbered depth-first: a, c, then b.
+  for (std::string_view path : {"/main.x", "/a.x", "/b.x", "/c.x"}) {
+    EXPECT_EQ(import_data.file_table().Find(path),
+              serial_import_data.file_table().Find(path))
+        << path;
+  }
+  EXPECT_LT(import_data.file_table().Find("/c.x"),
+            import_data.file_table().Find("/b.x"));
+  XLS_ASSERT_OK_AND_ASSIGN(ModuleInfo * c,
+                           import_data.Get(ImportTokens({"c"})));
+  EXPECT_EQ(c->module().file_table(), &import_data.file_table());
+}
+
+TEST(ImportRoutinesTest, ParseAndTypecheckConsumesPrefetchedModules) {
+  ImportData import_data = CreateImportData("pub fn h() -> u32 { u32:42 }\n");
+  XLS_ASSERT_OK(
+      ParseAndTypecheck(kMain, "/main.x", "main", &import_data).status());
+
+  for (std::string_view name : {"a", "b", "c"}) {
+    ImportTokens subject({std::string(name)});
+    EXPECT_TRUE(import_data.Contains(subject)) << name;
+    EXPECT_FALSE(import_data.HasPrefetchedModule(subject)) << name;
+  }
+}
+
+TEST(ImportRoutinesTest, ParseErrorInPrefetchedImportIsReported) {
+  ImportData import_data = CreateImportData("pub fn h( -> u32 { u32:42 }\n");
+  absl::StatusOr<TypecheckedModule> result =
+      ParseAndTypecheck(kMain, "/main.x", "main", &import_data);
+  ASSERT_FALSE(result.ok());
+  EXPECT_THAT(result.status().message(), HasSubstr("c.x"));
+}
+
+}  // namespace
+}  // namespace xls::dslx
@@ -572,9 +572,9 @@ absl::StatusOr<InterpValue> InterpValue::Sub(const InterpValue& other) const {
 absl::StatusOr<InterpValue> InterpValue::Add(const InterpValue& other) const {
   XLS_RET_CHECK(IsBits() && other.IsBits());
   XLS_RET_CHECK_EQ(tag(), other.tag());
-  XLS_RET_CHECK_EQ(GetBitCount().value(), other.GetBitCount().value());
-  XLS_ASSIGN_OR_RETURN(Bits lhs, GetBits());
-  XLS_ASSIGN_OR_RETURN(Bits rhs, other.GetBits());
+  const Bits& lhs = GetBitsOrDie();
+  const Bits& rhs = other.GetBitsOrDie();
+  XLS_RET_CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   return InterpValue(tag_, bits_ops::Add(lhs, rhs));
 }
 
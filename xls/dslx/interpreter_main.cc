@@ -37,6 +37,7 @@
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
 #include "xls/dslx/command_line_utils.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
 #include "xls/dslx/parse_and_typecheck.h"
@@ -89,10 +90,18 @@ ABSL_FLAG(bool, trace_calls, false,
 ABSL_FLAG(int64_t, max_ticks, 100000,
           "If non-zero, the maximum number of ticks to execute on any proc. If "
           "exceeded an error is returned.");
+ABSL_FLAG(int64_t, quickcheck_jobs, 1,
+          "Number of threads across which the cases of each quickcheck are "
+          "evaluated (when comparing against the JIT). The threads come from "
+          "a process-wide pool with one thread per available CPU. If zero, "
+          "the number of available CPUs is used. Results do not depend on "
+          "this value.");
 ABSL_FLAG(std::string, evaluator, "dslx-interpreter",
           "What evaluator should be used to actually execute the dslx test. "
           "'dslx-interpreter' is the DSLX bytecode interpreter. 'ir-jit' is "
-          "the XLS-IR JIT. ir-interpreter' is the XLS-IR interpreter.");
+          "the XLS-IR JIT. 'ir-jit-with-fallback' is the XLS-IR JIT, running "
+          "any test that cannot be converted to IR in the DSLX bytecode "
+          "interpreter instead. ir-interpreter' is the XLS-IR interpreter.");
 ABSL_FLAG(bool, type_inference_v2, false,
           "Whether to use type system v2 when type checking the input.");
 // LINT.ThenChange(//xls/build_rules/xls_dslx_rules.bzl)
@@ -109,6 +118,7 @@ enum class EvaluatorType : uint8_t {
   kDslxInterpreter,
   kIrInterpreter,
   kIrJit,
+  kIrJitWithFallback,
 };
 
 absl::StatusOr<EvaluatorType> GetEvaluatorType(std::string_view text) {
@@ -118,12 +128,15 @@ absl::StatusOr<EvaluatorType> GetEvaluatorType(std::string_view text) {
   if (text == "ir-jit") {
     return EvaluatorType::kIrJit;
   }
+  if (text == "ir-jit-with-fallback") {
+    return EvaluatorType::kIrJitWithFallback;
+  }
   if (text == "ir-interpreter") {
     return EvaluatorType::kIrInterpreter;
   }
   return absl::InvalidArgumentError(
       "Unknown evaluator. Options are ['dslx-interpreter', 'ir-jit', "
-      "'ir-interpreter']");
+      "'ir-jit-with-fallback', 'ir-interpreter']");
 }
 static constexpr std::string_view kUsage = R"(
 Parses, typechecks, and executes all tests inside of a DSLX module.
@@ -137,6 +150,9 @@ std::unique_ptr<AbstractTestRunner> GetTestRunner(EvaluatorType evaluator) {
       return std::make_unique<IrInterpreterTestRunner>();
     case EvaluatorType::kIrJit:
       return std::make_unique<IrJitTestRunner>();
+    case EvaluatorType::kIrJitWithFallback:
+      return std::make_unique<IrJitTestRunner>(
+          /*fallback_to_dslx_interpreter=*/true);
   }
 }
 
@@ -147,7 +163,7 @@ absl::StatusOr<TestResult> RealMain(
     const std::optional<std::string>& test_filter,
     FormatPreference format_preference, CompareFlag compare_flag, bool execute,
     bool warnings_as_errors, std::optional<int64_t> seed, bool trace_channels,
-    bool trace_calls, std::optional<int64_t> max_ticks,
+    bool trace_calls, std::optional<int64_t> max_ticks, int64_t quickcheck_jobs,
     std::optional<std::string_view> xml_output_file, EvaluatorType evaluator) {
   XLS_ASSIGN_OR_RETURN(
       WarningKindSet warnings,
@@ -201,6 +217,7 @@ absl::StatusOr<TestResult> RealMain(
       .run_comparator = run_comparator.get(),
       .execute = execute,
       .seed = seed,
+      .quickcheck_jobs = quickcheck_jobs,
       .trace_channels = trace_channels,
       .trace_calls = trace_calls,
       .max_ticks = max_ticks,
@@ -250,6 +267,11 @@ int main(int argc, char* argv[]) {
       absl::GetFlag(FLAGS_max_ticks) == 0
           ? std::nullopt
           : std::optional<int64_t>(absl::GetFlag(FLAGS_max_ticks));
+  int64_t quickcheck_jobs = absl::GetFlag(FLAGS_quickcheck_jobs);
+  QCHECK_GE(quickcheck_jobs, 0) << "--quickcheck_jobs must be non-negative";
+  if (quickcheck_jobs == 0) {
+    quickcheck_jobs = xls::AvailableCPUs();
+  }
 
   xls::dslx::CompareFlag compare_flag;
   if (compare_flag_str == "none") {
@@ -327,7 +349,8 @@ int main(int argc, char* argv[]) {
   absl::StatusOr<xls::dslx::TestResult> test_result = xls::dslx::RealMain(
       args[0], dslx_paths, dslx_stdlib_path, test_filter, preference,
       compare_flag, execute, warnings_as_errors, seed, trace_channels,
-      trace_calls, max_ticks, xml_output_file, evaluator.value());
+      trace_calls, max_ticks, quickcheck_jobs, xml_output_file,
+      evaluator.value());
   if (!test_result.ok()) {
     return xls::ExitStatus(test_result.status());
   }
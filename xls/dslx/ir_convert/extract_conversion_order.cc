@@ -839,7 +839,8 @@ absl::StatusOr<std::vector<ConversionRecord>> GetOrder(Module* module,
 }
 
 absl::StatusOr<std::vector<ConversionRecord>> GetOrderForEntry(
-    std::variant<Function*, Proc*> entry, TypeInfo* type_info) {
+    std::variant<Function*, Proc*> entry, TypeInfo* type_info,
+    const ParametricEnv& parametric_env) {
   std::vector<ConversionRecord> ready;
   if (std::holds_alternative<Function*>(entry)) {
     Function* f = std::get<Function*>(entry);
@@ -849,13 +850,14 @@ absl::StatusOr<std::vector<ConversionRecord>> GetOrderForEntry(
     }
     XLS_RETURN_IF_ERROR(AddToReady(f,
                                    /*invocation=*/nullptr, f->owner(),
-                                   type_info, ParametricEnv(), &ready, {},
+                                   type_info, parametric_env, &ready, {},
                                    /*is_top=*/true));
     RemoveFunctionDuplicates(&ready);
     return ready;
   }
 
   Proc* p = std::get<Proc*>(entry);
+  XLS_RET_CHECK(parametric_env.empty());
   XLS_ASSIGN_OR_RETURN(TypeInfo * new_ti,
                        type_info->GetTopLevelProcTypeInfo(p));
   XLS_ASSIGN_OR_RETURN(ready, GetOrderForProc(p, new_ti, /*is_top=*/true));
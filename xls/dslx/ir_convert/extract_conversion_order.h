@@ -151,8 +151,11 @@ absl::StatusOr<std::vector<ConversionRecord>> GetOrder(
 // Args:
 //  f: The top level function.
 //  type_info: Mapping from node to type.
+//  parametric_env: Parametric bindings of `f` if it is a parametric function,
+//    in which case `type_info` is the type information of that instantiation.
 absl::StatusOr<std::vector<ConversionRecord>> GetOrderForEntry(
-    std::variant<Function*, Proc*> entry, TypeInfo* type_info);
+    std::variant<Function*, Proc*> entry, TypeInfo* type_info,
+    const ParametricEnv& parametric_env = ParametricEnv());
 
 // Top level procs are procs where their config or next function is not invoked
 // within the module.
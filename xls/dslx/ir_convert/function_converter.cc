@@ -2266,7 +2266,8 @@ absl::Status FunctionConverter::HandleFailBuiltin(const Invocation* node,
     BValue assert_result_token =
         function_builder_->Assert(implicit_token_data_->entry_token,
                                   function_builder_->Not(control_predicate),
-                                  label_data.message, label_data.label);
+                                  label_data.message, label_data.label,
+                                  ToSourceInfo(node->span()));
     XLS_RETURN_IF_ERROR(function_builder_->GetError());
     implicit_token_data_->control_tokens.push_back(assert_result_token);
     tokens_.push_back(assert_result_token);
@@ -2338,7 +2339,8 @@ absl::Status FunctionConverter::HandleAssertBuiltin(const Invocation* node,
                          GetAssertionLabel(name, label_expr, node->span()));
     BValue assert_result_token =
         function_builder_->Assert(implicit_token_data_->entry_token, ok,
-                                  label_data.message, label_data.label);
+                                  label_data.message, label_data.label,
+                                  ToSourceInfo(node->span()));
     implicit_token_data_->control_tokens.push_back(assert_result_token);
     tokens_.push_back(assert_result_token);
   }
@@ -3021,6 +3023,43 @@ absl::Status FunctionConverter::AddImplicitTokenParams() {
   return absl::OkStatus();
 }
 
+absl::Status FunctionConverter::SetConvertedFunctionAsTop(
+    Function* node, xls::Function* existing, std::string_view mangled_name,
+    bool requires_implicit_token) {
+  PackageInterfaceProto& interface = package_data_.conversion_info->interface;
+  PackageInterfaceProto::Function* existing_proto = nullptr;
+  for (PackageInterfaceProto::Function& function_proto :
+       *interface.mutable_functions()) {
+    if (function_proto.base().name() == mangled_name) {
+      existing_proto = &function_proto;
+      break;
+    }
+  }
+  XLS_RET_CHECK(existing_proto != nullptr)
+      << "No interface for converted function " << mangled_name;
+  existing_proto->mutable_base()->set_top(true);
+
+  // Parametric instantiations have no entry wrapper.
+  if (!requires_implicit_token || node->IsParametric()) {
+    return package()->SetTop(existing);
+  }
+  // Non-public callees are converted without an entry wrapper.
+  XLS_ASSIGN_OR_RETURN(
+      std::string wrapper_name,
+      MangleDslxName(module_->name(), node->identifier(),
+                     CallingConvention::kTypical, /*free_keys=*/{},
+                     /*parametric_env=*/nullptr));
+  std::optional<xls::Function*> wrapper =
+      package()->TryGetFunction(wrapper_name);
+  if (!wrapper.has_value()) {
+    XLS_ASSIGN_OR_RETURN(
+        wrapper, EmitImplicitTokenEntryWrapper(existing, node, /*is_top=*/true,
+                                               &interface, *existing_proto));
+    package_data_.wrappers.insert(*wrapper);
+  }
+  return package()->SetTop(*wrapper);
+}
+
 absl::Status FunctionConverter::HandleFunction(
     Function* node, TypeInfo* type_info, const ParametricEnv* parametric_env) {
   XLS_RET_CHECK_NE(type_info, nullptr);
@@ -3046,13 +3085,37 @@ absl::Status FunctionConverter::HandleFunction(
                      requires_implicit_token ? CallingConvention::kImplicitToken
                                              : CallingConvention::kTypical,
                      f.GetFreeParametricKeySet(), parametric_env, scope));
+
+  // When several entry points are converted into one package, callees they
+  // share will already have been converted (along with any wrapper) by an
+  // earlier entry. The mangled name includes the parametric environment, so
+  // the same DSLX function under the same name is the same instantiation.
+  if (std::optional<xls::Function*> existing =
+          package()->TryGetFunction(mangled_name);
+      existing.has_value()) {
+    auto it = package_data_.ir_to_dslx.find(*existing);
+    if (it == package_data_.ir_to_dslx.end() || it->second != node) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Cannot convert function `%s` of module `%s`: the package already "
+          "has an IR function named `%s` which was not converted from it",
+          f.identifier(), module_->name(), mangled_name));
+    }
+    VLOG(5) << "Function " << mangled_name << " already converted";
+    if (is_top_) {
+      XLS_RETURN_IF_ERROR(SetConvertedFunctionAsTop(
+          node, *existing, mangled_name, requires_implicit_token));
+    }
+    return absl::OkStatus();
+  }
+
   auto ir_builder =
       std::make_unique<FunctionBuilder>(mangled_name, package(), true);
 
   auto* ir_builder_ptr = ir_builder.get();
   SetFunctionBuilder(std::move(ir_builder));
-  // Function is a top entity.
-  if (is_top_ && !requires_implicit_token) {
+  // Function is a top entity. Implicit-token functions are exposed through
+  // their entry wrapper instead, except for parametric ones, which have none.
+  if (is_top_ && (!requires_implicit_token || node->IsParametric())) {
     XLS_RETURN_IF_ERROR(ir_builder_ptr->SetAsTop());
   }
 
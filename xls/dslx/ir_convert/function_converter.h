@@ -258,6 +258,15 @@ class FunctionConverter {
   // Populates the implicit_token_data_.
   absl::Status AddImplicitTokenParams();
 
+  // Makes `existing`, the IR function an earlier entry converted for `node`
+  // under `mangled_name`, the top of the package: marks it as top in the
+  // package interface and, if it uses the implicit-token calling convention,
+  // makes its entry wrapper (emitting it if needed) the package top.
+  absl::Status SetConvertedFunctionAsTop(Function* node,
+                                         xls::Function* existing,
+                                         std::string_view mangled_name,
+                                         bool requires_implicit_token);
+
   // Aliases the (IR) result of AST node 'from' with AST node 'to'.
   //
   // That is, 'from' has already been emitted, and we want 'to' to just be
@@ -24,11 +24,14 @@
 
 #include "xls/dslx/ir_convert/ir_converter.h"
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>  // NOLINT
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -471,35 +474,66 @@ absl::Status CheckAcceptableTopProc(Proc* proc) {
   return absl::OkStatus();
 }
 
+namespace {
+
+// Converts the instantiation of the parametric function `fn` with
+// `parametric_env` as the top. Its type information comes from typechecking,
+// so the program must instantiate `fn` with these bindings.
+absl::Status ConvertParametricFunctionIntoPackage(
+    Function* fn, ImportData* import_data, const ParametricEnv& parametric_env,
+    const ConvertOptions& options, PackageData& package_data) {
+  if (options.lower_to_proc_scoped_channels) {
+    return absl::UnimplementedError(absl::StrFormat(
+        "Cannot convert parametric function `%s` as top with "
+        "lower_to_proc_scoped_channels",
+        fn->identifier()));
+  }
+  XLS_ASSIGN_OR_RETURN(TypeInfo * root_type_info,
+                       import_data->GetRootTypeInfoForNode(fn));
+  for (const InvocationCalleeData& callee_data :
+       root_type_info->GetUniqueInvocationCalleeData(fn)) {
+    if (callee_data.callee_bindings != parametric_env) {
+      continue;
+    }
+    XLS_ASSIGN_OR_RETURN(std::vector<ConversionRecord> order,
+                         GetOrderForEntry(fn, callee_data.derived_type_info,
+                                          parametric_env));
+    return ConvertCallGraph(order, import_data, options, package_data);
+  }
+  return absl::InvalidArgumentError(absl::StrFormat(
+      "Function `%s` of module %s is not instantiated with parametrics %s; "
+      "only instantiations which occur in the module can be converted",
+      fn->identifier(), fn->owner()->name(), parametric_env.ToString()));
+}
+
 template <typename BlockT>
 absl::Status ConvertOneFunctionIntoPackageInternal(
     BlockT* block, ImportData* import_data, const ParametricEnv* parametric_env,
-    const ConvertOptions& options, PackageConversionData* conv) {
+    const ConvertOptions& options, PackageData& package_data) {
+  if constexpr (std::is_same_v<BlockT, Function>) {
+    if (parametric_env != nullptr && !parametric_env->empty()) {
+      return ConvertParametricFunctionIntoPackage(
+          block, import_data, *parametric_env, options, package_data);
+    }
+  }
   XLS_ASSIGN_OR_RETURN(TypeInfo * func_type_info,
                        import_data->GetRootTypeInfoForNode(block));
   XLS_ASSIGN_OR_RETURN(std::vector<ConversionRecord> order,
                        GetConversionRecords(block, func_type_info, options));
-  PackageData package_data{.conversion_info = conv};
   XLS_RETURN_IF_ERROR(
       ConvertCallGraph(order, import_data, options, package_data));
   return absl::OkStatus();
 }
 
-absl::Status ConvertOneFunctionIntoPackage(Function* fn,
-                                           ImportData* import_data,
-                                           const ParametricEnv* parametric_env,
-                                           const ConvertOptions& options,
-                                           PackageConversionData* conv) {
-  return ConvertOneFunctionIntoPackageInternal(fn, import_data, parametric_env,
-                                               options, conv);
-}
-
-absl::Status ConvertOneFunctionIntoPackage(Module* module,
-                                           std::string_view entry_function_name,
-                                           ImportData* import_data,
-                                           const ParametricEnv* parametric_env,
-                                           const ConvertOptions& options,
-                                           PackageConversionData* conv) {
+// Implements ConvertOneFunctionIntoPackage() for the entry named
+// `entry_function_name`, converting into `package_data` so that what earlier
+// conversions into the same package recorded there is visible.
+absl::Status ConvertEntryIntoPackage(Module* module,
+                                     std::string_view entry_function_name,
+                                     ImportData* import_data,
+                                     const ParametricEnv* parametric_env,
+                                     const ConvertOptions& options,
+                                     PackageData& package_data) {
   absl::StatusOr<TestFunction*> test_fn = module->GetTest(entry_function_name);
   if (test_fn.ok()) {
     if (!options.convert_tests) {
@@ -508,8 +542,8 @@ absl::Status ConvertOneFunctionIntoPackage(Module* module,
           "function \"%s\" from module %s was requested.",
           entry_function_name, module->name()));
     }
-    return ConvertOneFunctionIntoPackageInternal(&(*test_fn)->fn(), import_data,
-                                                 parametric_env, options, conv);
+    return ConvertOneFunctionIntoPackageInternal(
+        &(*test_fn)->fn(), import_data, parametric_env, options, package_data);
   }
 
   std::optional<Function*> fn_or = module->GetFunction(entry_function_name);
@@ -521,8 +555,8 @@ absl::Status ConvertOneFunctionIntoPackage(Module* module,
           entry_function_name, module->name()));
     }
 
-    return ConvertOneFunctionIntoPackageInternal(*fn_or, import_data,
-                                                 parametric_env, options, conv);
+    return ConvertOneFunctionIntoPackageInternal(
+        *fn_or, import_data, parametric_env, options, package_data);
   }
 
   absl::StatusOr<TestProc*> test_proc =
@@ -535,16 +569,17 @@ absl::Status ConvertOneFunctionIntoPackage(Module* module,
                           "of a test proc \"%s\" from module %s was requested.",
                           entry_function_name, module->name()));
     }
-    return ConvertOneFunctionIntoPackageInternal(
-        (*test_proc)->proc(), import_data, parametric_env, options, conv);
+    return ConvertOneFunctionIntoPackageInternal((*test_proc)->proc(),
+                                                 import_data, parametric_env,
+                                                 options, package_data);
   }
 
   absl::StatusOr<Proc*> proc =
       module->GetMemberOrError<Proc>(entry_function_name);
   if (proc.ok()) {
     XLS_RETURN_IF_ERROR(CheckAcceptableTopProc(*proc));
-    return ConvertOneFunctionIntoPackageInternal(*proc, import_data,
-                                                 parametric_env, options, conv);
+    return ConvertOneFunctionIntoPackageInternal(
+        *proc, import_data, parametric_env, options, package_data);
   }
 
   return absl::InvalidArgumentError(
@@ -553,6 +588,29 @@ absl::Status ConvertOneFunctionIntoPackage(Module* module,
                       entry_function_name, module->name()));
 }
 
+}  // namespace
+
+absl::Status ConvertOneFunctionIntoPackage(Function* fn,
+                                           ImportData* import_data,
+                                           const ParametricEnv* parametric_env,
+                                           const ConvertOptions& options,
+                                           PackageConversionData* conv) {
+  PackageData package_data{.conversion_info = conv};
+  return ConvertOneFunctionIntoPackageInternal(fn, import_data, parametric_env,
+                                               options, package_data);
+}
+
+absl::Status ConvertOneFunctionIntoPackage(Module* module,
+                                           std::string_view entry_function_name,
+                                           ImportData* import_data,
+                                           const ParametricEnv* parametric_env,
+                                           const ConvertOptions& options,
+                                           PackageConversionData* conv) {
+  PackageData package_data{.conversion_info = conv};
+  return ConvertEntryIntoPackage(module, entry_function_name, import_data,
+                                 parametric_env, options, package_data);
+}
+
 absl::StatusOr<std::string> ConvertOneFunction(
     Module* module, std::string_view entry_function_name,
     ImportData* import_data, const ParametricEnv* parametric_env,
@@ -589,21 +647,13 @@ absl::Status CheckPackageName(std::string_view name) {
   return absl::OkStatus();
 }
 
-// Adds IR-converted symbols from the module specified by "path" to the given
-// "package".
-//
-// TODO(leary): 2021-07-21 We should be able to reuse the type checking if
-// there are overlapping nodes in the module DAG between files to process. For
-// now we throw it away for each file and re-derive it (we need to refactor to
-// make the modules outlive any given AddPathToPackage() if we want to
-// appropriately reuse things in ImportData).
-absl::Status AddContentsToPackage(
+// Parses and typechecks the given module contents into `import_data`, treating
+// warnings as errors if requested.
+absl::StatusOr<Module*> ParseAndTypecheckForConversion(
     std::string_view file_contents, std::string_view module_name,
-    std::optional<std::string_view> path, std::optional<std::string_view> entry,
-    const ConvertOptions& convert_options, ImportData* import_data,
-    PackageConversionData* conv, bool* printed_error) {
+    std::string_view path_value, const ConvertOptions& convert_options,
+    ImportData* import_data, bool* printed_error) {
   // Parse the module text.
-  const std::string_view path_value = path.value_or("<UNKNOWN>");
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<Module> module,
                        ParseText(import_data->vfs(), import_data->file_table(),
                                  file_contents, module_name,
@@ -632,18 +682,119 @@ absl::Status AddContentsToPackage(
     return absl::InvalidArgumentError(
         "Warnings encountered and warnings-as-errors set.");
   }
+  return typechecked_module->module;
+}
 
+// Adds IR-converted symbols from the module specified by "path" to the given
+// "package".
+//
+// TODO(leary): 2021-07-21 We should be able to reuse the type checking if
+// there are overlapping nodes in the module DAG between files to process. For
+// now we throw it away for each file and re-derive it (we need to refactor to
+// make the modules outlive any given AddPathToPackage() if we want to
+// appropriately reuse things in ImportData). ConvertEntriesToPackages() does
+// share an ImportData across entries.
+absl::Status AddContentsToPackage(
+    std::string_view file_contents, std::string_view module_name,
+    std::optional<std::string_view> path, std::optional<std::string_view> entry,
+    const ConvertOptions& convert_options, ImportData* import_data,
+    PackageConversionData* conv, bool* printed_error) {
+  XLS_ASSIGN_OR_RETURN(
+      Module * module,
+      ParseAndTypecheckForConversion(file_contents, module_name,
+                                     path.value_or("<UNKNOWN>"),
+                                     convert_options, import_data,
+                                     printed_error));
   if (entry.has_value()) {
     XLS_RETURN_IF_ERROR(ConvertOneFunctionIntoPackage(
-        typechecked_module->module, entry.value(), /*import_data=*/import_data,
+        module, entry.value(), /*import_data=*/import_data,
         /*parametric_env=*/nullptr, convert_options, conv));
   } else {
-    XLS_RETURN_IF_ERROR(ConvertModuleIntoPackage(
-        typechecked_module->module, import_data, convert_options, conv));
+    XLS_RETURN_IF_ERROR(ConvertModuleIntoPackage(module, import_data,
+                                                 convert_options, conv));
+  }
+  return absl::OkStatus();
+}
+
+// Warns (or errors, under warnings-as-errors) if the module name derived from
+// `path` had to be canonicalized to `module_name`.
+absl::Status CheckModuleNameForPath(std::string_view path,
+                                    std::string_view module_name,
+                                    const ConvertOptions& convert_options,
+                                    ImportData& import_data) {
+  if (!NameNeedsCanonicalization(path)) {
+    return absl::OkStatus();
+  }
+  WarningCollector col(convert_options.warnings);
+  Pos pos(import_data.file_table().GetOrCreate(path), 0, 0);
+  col.Add(Span(pos, pos), WarningKind::kIllegalPackageName,
+          absl::StrFormat(
+              "Module name '%s' is not a valid identifier name and "
+              "would fail to parse from text-ir. Avoid use of "
+              "infix or special characters.%s",
+              RawNameFromPath(path).value(),
+              convert_options.warnings_as_errors
+                  ? ""
+                  : absl::StrFormat(" Using '%s' as fallback.", module_name)));
+  if (!col.empty()) {
+    PrintWarnings(col, import_data.file_table(), import_data.vfs());
+    if (convert_options.warnings_as_errors) {
+      return absl::InvalidArgumentError(
+          "Warnings encountered and warnings-as-errors set.");
+    }
   }
   return absl::OkStatus();
 }
 
+// Returns the bindings with which `module` instantiates the parametric
+// function `entry.top` that have the values `entry.parametrics`.
+absl::StatusOr<ParametricEnv> ResolveEntryParametrics(
+    Module* module, const ConversionEntry& entry, ImportData& import_data) {
+  std::optional<Function*> fn = module->GetFunction(entry.top);
+  if (!fn.has_value() || !(*fn)->IsParametric()) {
+    return absl::InvalidArgumentError(absl::StrFormat(
+        "Parametrics were given for `%s`, which is not a parametric function "
+        "of module %s",
+        entry.top, module->name()));
+  }
+  XLS_ASSIGN_OR_RETURN(TypeInfo * type_info,
+                       import_data.GetRootTypeInfo(module));
+  for (const InvocationCalleeData& callee_data :
+       type_info->GetUniqueInvocationCalleeData(*fn)) {
+    const ParametricEnv& env = callee_data.callee_bindings;
+    if (env.size() != entry.parametrics.size()) {
+      continue;
+    }
+    auto matches_entry = [&](const ParametricEnvItem& binding) {
+      auto it = entry.parametrics.find(binding.identifier);
+      if (it == entry.parametrics.end() || !binding.value.IsBits()) {
+        return false;
+      }
+      absl::StatusOr<int64_t> value = binding.value.GetBitValueViaSign();
+      return value.ok() && *value == it->second;
+    };
+    if (absl::c_all_of(env.bindings(), matches_entry)) {
+      return env;
+    }
+  }
+  return absl::InvalidArgumentError(absl::StrFormat(
+      "Module %s does not instantiate `%s` with parametrics {%s}; only "
+      "instantiations which occur in the module can be converted",
+      module->name(), entry.top,
+      absl::StrJoin(entry.parametrics, ", ", absl::PairFormatter(": "))));
+}
+
+// Unmarks every function and proc of `interface` as top.
+void ClearInterfaceTops(PackageInterfaceProto& interface) {
+  for (PackageInterfaceProto::Function& function :
+       *interface.mutable_functions()) {
+    function.mutable_base()->set_top(false);
+  }
+  for (PackageInterfaceProto::Proc& proc : *interface.mutable_procs()) {
+    proc.mutable_base()->set_top(false);
+  }
+}
+
 }  // namespace
 
 absl::StatusOr<PackageConversionData> ConvertFilesToPackage(
@@ -683,27 +834,8 @@ absl::StatusOr<PackageConversionData> ConvertFilesToPackage(
     XLS_ASSIGN_OR_RETURN(std::string text,
                          import_data.vfs().GetFileContents(path));
     XLS_ASSIGN_OR_RETURN(std::string module_name, PathToName(path));
-    if (NameNeedsCanonicalization(path)) {
-      WarningCollector col(convert_options.warnings);
-      Pos pos(import_data.file_table().GetOrCreate(path), 0, 0);
-      col.Add(
-          Span(pos, pos), WarningKind::kIllegalPackageName,
-          absl::StrFormat(
-              "Module name '%s' is not a valid identifier name and "
-              "would fail to parse from text-ir. Avoid use of "
-              "infix or special characters.%s",
-              RawNameFromPath(path).value(),
-              convert_options.warnings_as_errors
-                  ? ""
-                  : absl::StrFormat(" Using '%s' as fallback.", module_name)));
-      if (!col.empty()) {
-        PrintWarnings(col, import_data.file_table(), import_data.vfs());
-        if (convert_options.warnings_as_errors) {
-          return absl::InvalidArgumentError(
-              "Warnings encountered and warnings-as-errors set.");
-        }
-      }
-    }
+    XLS_RETURN_IF_ERROR(CheckModuleNameForPath(path, module_name,
+                                               convert_options, import_data));
     XLS_RETURN_IF_ERROR(AddContentsToPackage(
         text, module_name, /*path=*/path, /*entry=*/top, convert_options,
         &import_data, &conversion_data, printed_error));
@@ -711,4 +843,100 @@ absl::StatusOr<PackageConversionData> ConvertFilesToPackage(
   return conversion_data;
 }
 
+absl::StatusOr<std::vector<PackageConversionData>> ConvertEntriesToPackages(
+    absl::Span<const ConversionEntry> entries, std::string_view stdlib_path,
+    absl::Span<const std::filesystem::path> dslx_paths,
+    const ConvertOptions& convert_options,
+    std::optional<std::string_view> package_name, bool* printed_error) {
+  std::vector<PackageConversionData> result;
+  auto add_package = [&](std::string_view name) -> PackageConversionData* {
+    PackageConversionData& conv = result.emplace_back(PackageConversionData{
+        .package = std::make_unique<xls::Package>(name)});
+    *conv.interface.mutable_name() = name;
+    return &conv;
+  };
+  if (package_name.has_value()) {
+    XLS_RETURN_IF_ERROR(CheckPackageName(*package_name));
+    add_package(*package_name);
+  }
+
+  // Verifying after every entry would re-verify a merged package once per
+  // entry, so each package is verified once at the end instead.
+  ConvertOptions entry_options = convert_options;
+  entry_options.verify_ir = false;
+
+  // Entries converted into the merged package share its PackageData, so that
+  // callees converted by an earlier entry are recognized as such.
+  std::optional<PackageData> merged_package_data;
+  if (package_name.has_value()) {
+    merged_package_data = PackageData{.conversion_info = &result.front()};
+  }
+
+  ImportData import_data(
+      CreateImportData(stdlib_path, dslx_paths, convert_options.warnings,
+                       std::make_unique<RealFilesystem>()));
+  absl::flat_hash_map<std::string, Module*> path_to_module;
+  for (const ConversionEntry& entry : entries) {
+    auto [it, inserted] = path_to_module.try_emplace(entry.path, nullptr);
+    if (inserted) {
+      XLS_ASSIGN_OR_RETURN(std::string module_name, PathToName(entry.path));
+      XLS_ASSIGN_OR_RETURN(ImportTokens subject,
+                           ImportTokens::FromString(module_name));
+      std::error_code ec;
+      if (import_data.Contains(subject)) {
+        // Already imported by an earlier entry's module.
+        XLS_ASSIGN_OR_RETURN(ModuleInfo * info, import_data.Get(subject));
+        if (std::filesystem::equivalent(info->path(), entry.path, ec)) {
+          it->second = &info->module();
+        }
+      }
+      if (it->second == nullptr) {
+        XLS_ASSIGN_OR_RETURN(std::string text,
+                             import_data.vfs().GetFileContents(entry.path));
+        XLS_RETURN_IF_ERROR(CheckModuleNameForPath(
+            entry.path, module_name, convert_options, import_data));
+        bool entry_printed_error = false;
+        absl::StatusOr<Module*> module = ParseAndTypecheckForConversion(
+            text, module_name, entry.path, convert_options, &import_data,
+            &entry_printed_error);
+        if (printed_error != nullptr) {
+          *printed_error |= entry_printed_error;
+        }
+        XLS_RETURN_IF_ERROR(module.status());
+        it->second = *module;
+      }
+    }
+    Module* module = it->second;
+
+    std::optional<ParametricEnv> parametric_env;
+    if (!entry.parametrics.empty()) {
+      XLS_ASSIGN_OR_RETURN(parametric_env,
+                           ResolveEntryParametrics(module, entry, import_data));
+    }
+
+    PackageData entry_package_data{.conversion_info = nullptr};
+    PackageData* package_data = &entry_package_data;
+    if (merged_package_data.has_value()) {
+      package_data = &*merged_package_data;
+      // Only the top of the latest entry is the package top.
+      ClearInterfaceTops(package_data->conversion_info->interface);
+    } else {
+      XLS_RETURN_IF_ERROR(CheckPackageName(module->name()));
+      package_data->conversion_info = add_package(module->name());
+    }
+    *package_data->conversion_info->interface.add_files() = entry.path;
+    XLS_RETURN_IF_ERROR(ConvertEntryIntoPackage(
+        module, entry.top, &import_data,
+        parametric_env.has_value() ? &*parametric_env : nullptr,
+        entry_options, *package_data));
+  }
+
+  if (convert_options.verify_ir) {
+    for (const PackageConversionData& conv : result) {
+      XLS_RETURN_IF_ERROR(VerifyPackage(conv.package.get()));
+    }
+  }
+  return result;
+}
+
 }  // namespace xls::dslx
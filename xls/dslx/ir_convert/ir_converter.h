@@ -15,11 +15,14 @@
 #ifndef XLS_DSLX_IR_CONVERT_IR_CONVERTER_H_
 #define XLS_DSLX_IR_CONVERT_IR_CONVERTER_H_
 
+#include <cstdint>
 #include <filesystem>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "absl/container/btree_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -118,6 +121,36 @@ absl::StatusOr<PackageConversionData> ConvertFilesToPackage(
     std::optional<std::string_view> package_name = std::nullopt,
     bool* printed_error = nullptr);
 
+// An entry point to convert as part of `ConvertEntriesToPackages`.
+struct ConversionEntry {
+  // Path to the DSLX file containing `top`.
+  std::string path;
+  // Name of the function or proc to convert.
+  std::string top;
+  // Values of the parametrics of `top`, if it is a parametric function. The
+  // module must instantiate `top` with these values, since that is where the
+  // type information of the instantiation comes from.
+  absl::btree_map<std::string, int64_t> parametrics;
+};
+
+// Converts many entry points in one invocation.
+//
+// All entries share one `ImportData`, so each module (including common
+// imports) is parsed and typechecked once rather than once per entry.
+//
+// If `package_name` is given, every entry is converted into a single package of
+// that name and the result has one element; IR for callees shared between
+// entries is only converted once. The top of the last entry is the package top
+// and the only one marked as top in the package interface. Otherwise each entry
+// is converted into its own package, named after the entry's module, and the
+// result has one element per entry, in order.
+absl::StatusOr<std::vector<PackageConversionData>> ConvertEntriesToPackages(
+    absl::Span<const ConversionEntry> entries, std::string_view stdlib_path,
+    absl::Span<const std::filesystem::path> dslx_paths,
+    const ConvertOptions& convert_options,
+    std::optional<std::string_view> package_name = std::nullopt,
+    bool* printed_error = nullptr);
+
 }  // namespace xls::dslx
 
 #endif  // XLS_DSLX_IR_CONVERT_IR_CONVERTER_H_
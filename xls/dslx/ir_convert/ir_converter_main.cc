@@ -12,18 +12,24 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/log/check.h"
-#include "absl/log/log.h"
 #include "absl/status/status.h"
-#include "absl/strings/str_join.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
+#include "absl/strings/str_format.h"
 #include "absl/strings/str_split.h"
 #include "absl/types/span.h"
 #include "google/protobuf/text_format.h"
@@ -57,8 +63,147 @@ Example invocation for a particular function:
 If no entry point is given all functions within the module are converted:
 
   ir_converter_main path/to/frobulator.x
+
+Many entry points can be converted in one invocation via a manifest:
+
+  ir_converter_main --batch_manifest=path/to/manifest.txt
 )";
 
+// An entry of a `--batch_manifest` file.
+struct ManifestEntry {
+  ConversionEntry entry;
+  std::optional<std::filesystem::path> output_file;
+};
+
+absl::StatusOr<std::vector<ManifestEntry>> ParseBatchManifest(
+    const std::filesystem::path& path) {
+  XLS_ASSIGN_OR_RETURN(std::string contents, GetFileContents(path));
+  std::vector<ManifestEntry> result;
+  int64_t lineno = 0;
+  for (std::string_view line : absl::StrSplit(contents, '\n')) {
+    ++lineno;
+    line = absl::StripAsciiWhitespace(line);
+    if (line.empty() || absl::StartsWith(line, "#")) {
+      continue;
+    }
+    std::vector<std::string_view> fields =
+        absl::StrSplit(line, absl::ByAnyChar(" \t"), absl::SkipEmpty());
+    auto error = [&](std::string_view reason) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "%s:%d: %s; expected `<dslx file> <top> [<parametrics>] "
+          "[<output ir file>]`, got `%s`",
+          path.string(), lineno, reason, line));
+    };
+    if (fields.size() < 2 || fields.size() > 4) {
+      return error("wrong number of fields");
+    }
+    ManifestEntry& entry = result.emplace_back();
+    entry.entry.path = fields[0];
+    entry.entry.top = fields[1];
+    size_t next = 2;
+    // Parametrics are `NAME=VALUE[,NAME=VALUE...]`; output files have no `=`.
+    if (next < fields.size() && absl::StrContains(fields[next], '=')) {
+      for (std::string_view binding : absl::StrSplit(fields[next], ',')) {
+        std::pair<std::string_view, std::string_view> name_value =
+            absl::StrSplit(binding, absl::MaxSplits('=', 1));
+        int64_t value;
+        if (name_value.first.empty() ||
+            !absl::SimpleAtoi(name_value.second, &value) ||
+            !entry.entry.parametrics
+                 .emplace(std::string(name_value.first), value)
+                 .second) {
+          return error(absl::StrFormat("invalid parametric `%s`", binding));
+        }
+      }
+      ++next;
+    }
+    if (next < fields.size()) {
+      entry.output_file = std::filesystem::path(fields[next++]);
+    }
+    if (next != fields.size()) {
+      return error("unexpected fields");
+    }
+  }
+  return result;
+}
+
+absl::Status WriteConversionResult(
+    const PackageConversionData& result,
+    const std::optional<std::filesystem::path>& output_file,
+    const IrConverterOptionsFlagsProto& ir_converter_options) {
+  if (output_file) {
+    XLS_RETURN_IF_ERROR(SetFileContents(*output_file, result.DumpIr()));
+  } else {
+    std::cout << result.package->DumpIr();
+  }
+  if (ir_converter_options.has_interface_proto_file()) {
+    XLS_RETURN_IF_ERROR(
+        SetFileContents(ir_converter_options.interface_proto_file(),
+                        result.interface.SerializeAsString()));
+  }
+  if (ir_converter_options.has_interface_textproto_file()) {
+    std::string res;
+    XLS_RET_CHECK(google::protobuf::TextFormat::PrintToString(result.interface, &res));
+    XLS_RETURN_IF_ERROR(
+        SetFileContents(ir_converter_options.interface_textproto_file(), res));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status RealMainBatch(
+    const IrConverterOptionsFlagsProto& ir_converter_options,
+    std::string_view dslx_stdlib_path,
+    absl::Span<const std::filesystem::path> dslx_paths,
+    const ConvertOptions& convert_options,
+    std::optional<std::string_view> package_name,
+    const std::optional<std::filesystem::path>& output_file) {
+  XLS_ASSIGN_OR_RETURN(
+      std::vector<ManifestEntry> manifest,
+      ParseBatchManifest(ir_converter_options.batch_manifest()));
+  std::vector<ConversionEntry> entries;
+  entries.reserve(manifest.size());
+  for (const ManifestEntry& manifest_entry : manifest) {
+    if (package_name.has_value() == manifest_entry.output_file.has_value()) {
+      return absl::InvalidArgumentError(absl::StrFormat(
+          "Batch manifest entry for `%s` in %s must %s an output ir file: one "
+          "is required per entry unless --package_name is given.",
+          manifest_entry.entry.top, manifest_entry.entry.path,
+          package_name.has_value() ? "not give" : "give"));
+    }
+    entries.push_back(manifest_entry.entry);
+  }
+  if (!package_name.has_value() &&
+      (ir_converter_options.has_interface_proto_file() ||
+       ir_converter_options.has_interface_textproto_file())) {
+    return absl::InvalidArgumentError(
+        "Interface files can only be written in batch mode when converting "
+        "into a single package via --package_name.");
+  }
+
+  bool printed_error = false;
+  XLS_ASSIGN_OR_RETURN(
+      std::vector<PackageConversionData> results,
+      ConvertEntriesToPackages(entries, dslx_stdlib_path, dslx_paths,
+                               convert_options, package_name, &printed_error));
+  if (package_name.has_value()) {
+    XLS_RET_CHECK_EQ(results.size(), 1);
+    XLS_RETURN_IF_ERROR(WriteConversionResult(results.front(), output_file,
+                                              ir_converter_options));
+  } else {
+    XLS_RET_CHECK_EQ(results.size(), manifest.size());
+    for (int64_t i = 0; i < results.size(); ++i) {
+      XLS_RETURN_IF_ERROR(
+          SetFileContents(*manifest[i].output_file, results[i].DumpIr()));
+    }
+  }
+
+  if (printed_error) {
+    return absl::InternalError(
+        "IR conversion failed with an earlier non-fatal error.");
+  }
+  return absl::OkStatus();
+}
+
 absl::Status RealMain(absl::Span<const std::string_view> paths) {
   XLS_ASSIGN_OR_RETURN(IrConverterOptionsFlagsProto ir_converter_options,
                        GetIrConverterOptionsFlagsProto());
@@ -127,6 +272,15 @@ absl::Status RealMain(absl::Span<const std::string_view> paths) {
       .configured_values = configured_values,
   };
 
+  if (ir_converter_options.has_batch_manifest()) {
+    QCHECK(paths.empty() && !top.has_value())
+        << "-batch_manifest cannot be combined with input paths or -top";
+    return RealMainBatch(ir_converter_options, dslx_stdlib_path, dslx_paths,
+                         convert_options, package_name, output_file);
+  }
+  QCHECK(!paths.empty())
+      << "Expected at least one input path (or -batch_manifest)";
+
   // The following checks are performed inside ConvertFilesToPackage(), but we
   // reproduce them here to give nicer error messages.
   if (!package_name.has_value()) {
@@ -146,22 +300,8 @@ absl::Status RealMain(absl::Span<const std::string_view> paths) {
                            paths, dslx_stdlib_path, dslx_paths, convert_options,
                            /*top=*/top,
                            /*package_name=*/package_name, &printed_error));
-  if (output_file) {
-    XLS_RETURN_IF_ERROR(SetFileContents(*output_file, result.DumpIr()));
-  } else {
-    std::cout << result.package->DumpIr();
-  }
-  if (ir_converter_options.has_interface_proto_file()) {
-    XLS_RETURN_IF_ERROR(
-        SetFileContents(ir_converter_options.interface_proto_file(),
-                        result.interface.SerializeAsString()));
-  }
-  if (ir_converter_options.has_interface_textproto_file()) {
-    std::string res;
-    XLS_RET_CHECK(google::protobuf::TextFormat::PrintToString(result.interface, &res));
-    XLS_RETURN_IF_ERROR(
-        SetFileContents(ir_converter_options.interface_textproto_file(), res));
-  }
+  XLS_RETURN_IF_ERROR(
+      WriteConversionResult(result, output_file, ir_converter_options));
 
   if (printed_error) {
     return absl::InternalError(
@@ -177,11 +317,6 @@ absl::Status RealMain(absl::Span<const std::string_view> paths) {
 int main(int argc, char* argv[]) {
   std::vector<std::string_view> args =
       xls::InitXls(xls::dslx::kUsage, argc, argv);
-  if (args.empty()) {
-    LOG(QFATAL) << "Wrong number of command-line arguments; got " << args.size()
-                << ": `" << absl::StrJoin(args, " ") << "`; want " << argv[0]
-                << " <input-file>";
-  }
   // "-" is a special path that is shorthand for /dev/stdin. Update here as
   // there isn't a better place later.
   for (auto& arg : args) {
@@ -91,6 +91,18 @@ ABSL_FLAG(
     "--configured_values="
     "{\"supported_opcodes\":\"OpcodeSet::SmallSubset\",\"foo\":\"true\"}");
 // LINT.ThenChange(//xls/build_rules/xls_ir_rules.bzl)
+ABSL_FLAG(std::optional<std::string>, batch_manifest, std::nullopt,
+          "Path to a manifest of entry points to convert in a single "
+          "invocation, instead of passing input paths. Each non-empty line not "
+          "starting with '#' is `<dslx file> <top> [<parametrics>] "
+          "[<output ir file>]`, where `<parametrics>` is "
+          "`NAME=VALUE[,NAME=VALUE...]` and selects an instantiation of a "
+          "parametric top in its module. Modules are parsed and typechecked "
+          "once for all entries. If --package_name is given, all entries are "
+          "converted into one package (written to --output_file or stdout), "
+          "shared callees are converted once and the last entry's top is the "
+          "package top; otherwise each entry is written as its own package to "
+          "its output ir file.");
 ABSL_FLAG(std::optional<std::string>, ir_converter_options_used_textproto_file,
           std::nullopt,
           "If present, path to write a protobuf recording all ir converter "
@@ -141,6 +153,7 @@ absl::StatusOr<bool> SetOptionsFromFlags(IrConverterOptionsFlagsProto& proto) {
   POPULATE_FLAG(type_inference_v2);
   POPULATE_FLAG(lower_to_proc_scoped_channels);
   POPULATE_REPEATED_FLAG(configured_values);
+  POPULATE_OPTIONAL_FLAG(batch_manifest);
 
 #undef POPULATE_FLAG
 
@@ -20,15 +20,18 @@
 
 #include "xls/dslx/ir_convert/ir_converter.h"
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
 #include "absl/status/statusor.h"
+#include "absl/strings/match.h"
 #include "absl/strings/str_format.h"
 #include "xls/common/file/temp_file.h"
 #include "xls/common/golden_files.h"
@@ -43,6 +46,10 @@
 #include "xls/dslx/run_routines/run_comparator.h"
 #include "xls/dslx/run_routines/run_routines.h"
 #include "xls/dslx/type_system/typecheck_test_utils.h"
+#include "xls/ir/function.h"
+#include "xls/ir/package.h"
+#include "xls/ir/verifier.h"
+#include "xls/ir/xls_ir_interface.pb.h"
 #include "re2/re2.h"
 
 namespace xls::dslx {
@@ -50,7 +57,10 @@ namespace {
 
 using ::absl_testing::StatusIs;
 using ::testing::AllOf;
+using ::testing::ElementsAre;
+using ::testing::EndsWith;
 using ::testing::HasSubstr;
+using ::testing::Not;
 
 constexpr std::string_view kProgramToVerifyTestConversion = R"(
 #[cfg(test)]
@@ -3936,6 +3946,155 @@ fn main() -> u8 {
   }
 }
 
+TEST(IrConverterTest, ConvertEntriesToPackagesMergedSharesCallees) {
+  constexpr std::string_view program =
+      R"(
+fn shared(x: u32) -> u32 { x + u32:1 }
+fn f(x: u32) -> u32 { shared(x) }
+fn g(x: u32) -> u32 { shared(x) * u32:2 }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(xls::TempFile temp,
+                           xls::TempFile::CreateWithContent(program, ".x"));
+  const std::string path = temp.path().string();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<PackageConversionData> result,
+      ConvertEntriesToPackages(
+          {ConversionEntry{.path = path, .top = "f"},
+           ConversionEntry{.path = path, .top = "g"}},
+          /*stdlib_path=*/"", {temp.path().parent_path()}, ConvertOptions{},
+          /*package_name=*/"merged"));
+  ASSERT_EQ(result.size(), 1);
+  const Package& package = *result.front().package;
+  EXPECT_EQ(package.name(), "merged");
+  // `shared` is converted once even though both entries call it.
+  EXPECT_EQ(package.functions().size(), 3);
+  XLS_ASSERT_OK(VerifyPackage(result.front().package.get()));
+}
+
+TEST(IrConverterTest, ConvertEntriesToPackagesOnePackagePerEntry) {
+  constexpr std::string_view program =
+      R"(
+fn shared(x: u32) -> u32 { x + u32:1 }
+fn f(x: u32) -> u32 { shared(x) }
+fn g(x: u32) -> u32 { shared(x) * u32:2 }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(xls::TempFile temp,
+                           xls::TempFile::CreateWithContent(program, ".x"));
+  const std::string path = temp.path().string();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<PackageConversionData> result,
+      ConvertEntriesToPackages({ConversionEntry{.path = path, .top = "f"},
+                                ConversionEntry{.path = path, .top = "g"}},
+                               /*stdlib_path=*/"", {temp.path().parent_path()},
+                               ConvertOptions{}));
+  ASSERT_EQ(result.size(), 2);
+  for (const PackageConversionData& conv : result) {
+    EXPECT_EQ(conv.package->functions().size(), 2);
+    XLS_ASSERT_OK(VerifyPackage(conv.package.get()));
+  }
+  XLS_ASSERT_OK_AND_ASSIGN(xls::Function * f_top,
+                           result[0].package->GetTopAsFunction());
+  XLS_ASSERT_OK_AND_ASSIGN(xls::Function * g_top,
+                           result[1].package->GetTopAsFunction());
+  EXPECT_THAT(f_top->name(), HasSubstr("__f"));
+  EXPECT_THAT(g_top->name(), HasSubstr("__g"));
+}
+
+TEST(IrConverterTest, ConvertEntriesToPackagesMergedTopIsEarlierCallee) {
+  // `g` needs an implicit token, so the first entry converts it (and `f`) with
+  // the implicit-token calling convention. As `g` is not public it gets no
+  // entry wrapper until the second entry names it as top.
+  constexpr std::string_view program =
+      R"(
+fn g(x: u32) -> u32 {
+  trace_fmt!("x: {}", x);
+  x + u32:1
+}
+fn f(x: u32) -> u32 { g(x) * u32:2 }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(xls::TempFile temp,
+                           xls::TempFile::CreateWithContent(program, ".x"));
+  const std::string path = temp.path().string();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<PackageConversionData> result,
+      ConvertEntriesToPackages(
+          {ConversionEntry{.path = path, .top = "f"},
+           ConversionEntry{.path = path, .top = "g"}},
+          /*stdlib_path=*/"", {temp.path().parent_path()}, ConvertOptions{},
+          /*package_name=*/"merged"));
+  ASSERT_EQ(result.size(), 1);
+  const PackageConversionData& conv = result.front();
+  XLS_ASSERT_OK(VerifyPackage(conv.package.get()));
+
+  // The implicit-token `f` and `g` plus a wrapper for each.
+  EXPECT_EQ(conv.package->functions().size(), 4);
+  XLS_ASSERT_OK_AND_ASSIGN(xls::Function * top,
+                           conv.package->GetTopAsFunction());
+  EXPECT_THAT(top->name(), AllOf(EndsWith("__g"), Not(HasSubstr("itok"))));
+  EXPECT_EQ(top->params().size(), 1);
+
+  // The implicit-token `g` converted by the first entry is the only function
+  // marked as top in the interface; `f` no longer is.
+  std::vector<std::string> interface_tops;
+  for (const PackageInterfaceProto::Function& function :
+       conv.interface.functions()) {
+    if (function.base().top()) {
+      interface_tops.push_back(function.base().name());
+    }
+  }
+  EXPECT_TRUE(conv.interface.procs().empty());
+  EXPECT_THAT(interface_tops,
+              ElementsAre(AllOf(HasSubstr("itok"), EndsWith("__g"))));
+}
+
+TEST(IrConverterTest, ConvertEntriesToPackagesParametricEntry) {
+  constexpr std::string_view program =
+      R"(
+fn p<N: u32>(x: uN[N]) -> uN[N] { x + uN[N]:1 }
+fn f(x: u8, y: u16) -> (u8, u16) { (p(x), p(y)) }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(xls::TempFile temp,
+                           xls::TempFile::CreateWithContent(program, ".x"));
+  const std::string path = temp.path().string();
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::vector<PackageConversionData> result,
+      ConvertEntriesToPackages(
+          {ConversionEntry{.path = path, .top = "f"},
+           ConversionEntry{
+               .path = path, .top = "p", .parametrics = {{"N", 16}}}},
+          /*stdlib_path=*/"", {temp.path().parent_path()}, ConvertOptions{},
+          /*package_name=*/"merged"));
+  ASSERT_EQ(result.size(), 1);
+  const PackageConversionData& conv = result.front();
+  XLS_ASSERT_OK(VerifyPackage(conv.package.get()));
+
+  // `f` and the two instantiations of `p`, each converted once.
+  EXPECT_EQ(conv.package->functions().size(), 3);
+  XLS_ASSERT_OK_AND_ASSIGN(xls::Function * top,
+                           conv.package->GetTopAsFunction());
+  EXPECT_THAT(top->name(), EndsWith("__p__16"));
+  EXPECT_EQ(top->GetType()->return_type()->GetFlatBitCount(), 16);
+}
+
+TEST(IrConverterTest, ConvertEntriesToPackagesParametricEntryNotInstantiated) {
+  constexpr std::string_view program =
+      R"(
+fn p<N: u32>(x: uN[N]) -> uN[N] { x + uN[N]:1 }
+fn f(x: u8) -> u8 { p(x) }
+)";
+  XLS_ASSERT_OK_AND_ASSIGN(xls::TempFile temp,
+                           xls::TempFile::CreateWithContent(program, ".x"));
+  const std::string path = temp.path().string();
+  EXPECT_THAT(
+      ConvertEntriesToPackages(
+          {ConversionEntry{
+              .path = path, .top = "p", .parametrics = {{"N", 32}}}},
+          /*stdlib_path=*/"", {temp.path().parent_path()}, ConvertOptions{},
+          /*package_name=*/"merged"),
+      StatusIs(absl::StatusCode::kInvalidArgument,
+               HasSubstr("does not instantiate `p`")));
+}
+
 TEST(IrConverterTest, ProcWithNonConstArgumentInConfigIsNotConverted) {
   constexpr std::string_view program =
       R"(
@@ -0,0 +1,87 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/change_debouncer.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <utility>
+
+#include "absl/algorithm/container.h"
+#include "absl/container/btree_map.h"
+#include "absl/time/time.h"
+#include "xls/dslx/lsp/lsp_uri.h"
+
+namespace xls::dslx {
+
+void ChangeDebouncer::AddChange(const LspUri& uri, std::string content,
+                                absl::Time now) {
+  auto [it, inserted] = pending_changes_.try_emplace(
+      uri, PendingChange{.content = std::nullopt, .arrival = now});
+  it->second.content = std::move(content);
+}
+
+void ChangeDebouncer::AddDependentChange(const LspUri& uri, absl::Time now) {
+  pending_changes_.try_emplace(
+      uri, PendingChange{.content = std::nullopt, .arrival = now});
+}
+
+void ChangeDebouncer::Flush() {
+  const bool flush_edits =
+      absl::c_any_of(pending_changes_, [](const auto& entry) {
+        return entry.second.content.has_value();
+      });
+  // The handler may add changes (e.g., dependent changes of an edited
+  // buffer), so the flushed changes are detached first.
+  absl::btree_map<LspUri, PendingChange> changes;
+  for (auto it = pending_changes_.begin(); it != pending_changes_.end();) {
+    if (it->second.content.has_value() == flush_edits) {
+      changes.emplace(it->first, std::move(it->second));
+      it = pending_changes_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  for (const auto& [uri, change] : changes) {
+    handler_(uri, change.content);
+  }
+}
+
+void ChangeDebouncer::FlushAll() {
+  while (HasPendingChanges()) {
+    Flush();
+  }
+}
+
+std::optional<absl::Duration> ChangeDebouncer::TimeUntilFlush(
+    absl::Time now) const {
+  if (pending_changes_.empty()) {
+    return std::nullopt;
+  }
+  absl::Time oldest = absl::InfiniteFuture();
+  for (const auto& [uri, change] : pending_changes_) {
+    oldest = std::min(oldest, change.arrival);
+  }
+  return std::max(std::min(quiet_period_, oldest + max_latency_ - now),
+                  absl::ZeroDuration());
+}
+
+bool ChangeDebouncer::IsOverdue(absl::Time now) const {
+  return absl::c_any_of(pending_changes_, [&](const auto& entry) {
+    return entry.second.arrival + max_latency_ <= now;
+  });
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,94 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_LSP_CHANGE_DEBOUNCER_H_
+#define XLS_DSLX_LSP_CHANGE_DEBOUNCER_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/container/btree_map.h"
+#include "absl/functional/any_invocable.h"
+#include "absl/time/time.h"
+#include "xls/dslx/lsp/lsp_uri.h"
+
+namespace xls::dslx {
+
+// Coalesces buffer changes so that a burst of edits (e.g., a change per
+// keystroke) results in a single analysis of each changed buffer.
+//
+// Pending changes should be flushed once no input has arrived for
+// `quiet_period` (with a zero quiet period: as soon as no input is waiting),
+// but a change never waits longer than `max_latency` after it arrived, even if
+// input keeps arriving. Only the latest content of each buffer is kept.
+//
+// Besides edits, a buffer can be marked for re-analysis with its current
+// contents because a buffer it imports changed. Such dependent changes are
+// only flushed once no edits are pending, so that diagnostics for the buffer
+// being edited are not delayed by re-analysis of its importers.
+class ChangeDebouncer {
+ public:
+  // `content` is std::nullopt for a dependent change.
+  using Handler = absl::AnyInvocable<void(
+      const LspUri& uri, std::optional<std::string_view> content)>;
+
+  ChangeDebouncer(absl::Duration quiet_period, absl::Duration max_latency,
+                  Handler handler)
+      : quiet_period_(quiet_period),
+        max_latency_(max_latency),
+        handler_(std::move(handler)) {}
+
+  // Records `content` as the latest content of `uri`, received at `now`.
+  void AddChange(const LspUri& uri, std::string content, absl::Time now);
+
+  // Records that `uri` must be re-analyzed, as of `now`, unless an edit of it
+  // is already pending.
+  void AddDependentChange(const LspUri& uri, absl::Time now);
+
+  // Calls the handler for each pending edit, in URI order, and clears them.
+  // If no edits are pending, does the same for the dependent changes instead.
+  void Flush();
+
+  // Flushes until nothing is pending.
+  void FlushAll();
+
+  bool HasPendingChanges() const { return !pending_changes_.empty(); }
+
+  // Returns how long the caller may wait for further input before the pending
+  // changes must be flushed. This is zero if the oldest pending change has
+  // waited for `max_latency`. Returns std::nullopt if nothing is pending.
+  std::optional<absl::Duration> TimeUntilFlush(absl::Time now) const;
+
+  // Returns true if the oldest pending change has waited for `max_latency`, in
+  // which case it must be flushed without first reading waiting input.
+  bool IsOverdue(absl::Time now) const;
+
+ private:
+  struct PendingChange {
+    std::optional<std::string> content;
+    // Arrival time of the oldest change coalesced into this one.
+    absl::Time arrival;
+  };
+
+  absl::Duration quiet_period_;
+  absl::Duration max_latency_;
+  Handler handler_;
+  absl::btree_map<LspUri, PendingChange> pending_changes_;
+};
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_LSP_CHANGE_DEBOUNCER_H_
@@ -0,0 +1,187 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/change_debouncer.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/time/time.h"
+#include "xls/dslx/lsp/lsp_uri.h"
+
+namespace xls::dslx {
+namespace {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Optional;
+using ::testing::Pair;
+
+class ChangeDebouncerTest : public ::testing::Test {
+ protected:
+  ChangeDebouncer MakeDebouncer() {
+    return ChangeDebouncer(
+        /*quiet_period=*/absl::Milliseconds(50),
+        /*max_latency=*/absl::Milliseconds(200),
+        [this](const LspUri& uri, std::optional<std::string_view> content) {
+          handled_.push_back(
+              std::make_pair(std::string(uri.GetStringView()),
+                             std::string(content.value_or(kDependent))));
+        });
+  }
+
+  static constexpr std::string_view kDependent = "<dependent>";
+
+  const absl::Time start_ = absl::FromUnixSeconds(1000);
+  std::vector<std::pair<std::string, std::string>> handled_;
+};
+
+TEST_F(ChangeDebouncerTest, NothingPending) {
+  ChangeDebouncer debouncer = MakeDebouncer();
+  EXPECT_FALSE(debouncer.HasPendingChanges());
+  EXPECT_EQ(debouncer.TimeUntilFlush(start_), std::nullopt);
+  debouncer.Flush();
+  EXPECT_THAT(handled_, IsEmpty());
+}
+
+TEST_F(ChangeDebouncerTest, CoalescesChangesToTheSameBuffer) {
+  ChangeDebouncer debouncer = MakeDebouncer();
+  debouncer.AddChange(LspUri("file:///b.x"), "b1", start_);
+  debouncer.AddChange(LspUri("file:///a.x"), "a1", start_);
+  debouncer.AddChange(LspUri("file:///b.x"), "b2",
+                      start_ + absl::Milliseconds(10));
+  EXPECT_TRUE(debouncer.HasPendingChanges());
+
+  debouncer.Flush();
+  EXPECT_FALSE(debouncer.HasPendingChanges());
+  EXPECT_THAT(handled_, ElementsAre(Pair("file:///a.x", "a1"),
+                                    Pair("file:///b.x", "b2")));
+}
+
+TEST_F(ChangeDebouncerTest, WaitsForTheQuietPeriod) {
+  ChangeDebouncer debouncer = MakeDebouncer();
+  debouncer.AddChange(LspUri("file:///a.x"), "a1", start_);
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_),
+              Optional(absl::Milliseconds(50)));
+  // A later change restarts the quiet period; the caller waits for input again.
+  debouncer.AddChange(LspUri("file:///a.x"), "a2",
+                      start_ + absl::Milliseconds(40));
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_ + absl::Milliseconds(40)),
+              Optional(absl::Milliseconds(50)));
+}
+
+TEST_F(ChangeDebouncerTest, ContinuousInputIsFlushedAfterMaxLatency) {
+  ChangeDebouncer debouncer = MakeDebouncer();
+  // A change every 20ms never leaves a 50ms quiet period, but the oldest
+  // change must be flushed 200ms after it arrived.
+  absl::Time now = start_;
+  for (int i = 0; i < 8; ++i) {
+    debouncer.AddChange(LspUri("file:///a.x"), "a", now);
+    now += absl::Milliseconds(20);
+  }
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_ + absl::Milliseconds(160)),
+              Optional(absl::Milliseconds(40)));
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_ + absl::Milliseconds(200)),
+              Optional(absl::ZeroDuration()));
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_ + absl::Milliseconds(300)),
+              Optional(absl::ZeroDuration()));
+
+  // The deadline is measured from the oldest change since the last flush.
+  debouncer.Flush();
+  debouncer.AddChange(LspUri("file:///a.x"), "a",
+                      start_ + absl::Milliseconds(300));
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_ + absl::Milliseconds(300)),
+              Optional(absl::Milliseconds(50)));
+}
+
+TEST_F(ChangeDebouncerTest, ChangesAddedByTheHandlerStayPending) {
+  ChangeDebouncer* debouncer_ptr = nullptr;
+  ChangeDebouncer debouncer(
+      absl::Milliseconds(50), absl::Milliseconds(200),
+      [&](const LspUri& uri, std::optional<std::string_view> content) {
+        handled_.push_back(std::make_pair(std::string(uri.GetStringView()),
+                                          std::string(*content)));
+        if (content == "first") {
+          debouncer_ptr->AddChange(uri, "second", start_);
+        }
+      });
+  debouncer_ptr = &debouncer;
+  debouncer.AddChange(LspUri("file:///a.x"), "first", start_);
+  debouncer.Flush();
+  EXPECT_THAT(handled_, ElementsAre(Pair("file:///a.x", "first")));
+  EXPECT_TRUE(debouncer.HasPendingChanges());
+}
+
+TEST_F(ChangeDebouncerTest, ZeroQuietPeriodOnlyWaitsForWaitingInput) {
+  ChangeDebouncer debouncer(
+      /*quiet_period=*/absl::ZeroDuration(),
+      /*max_latency=*/absl::Milliseconds(200),
+      [](const LspUri&, std::optional<std::string_view>) {});
+  debouncer.AddChange(LspUri("file:///a.x"), "a1", start_);
+  EXPECT_THAT(debouncer.TimeUntilFlush(start_),
+              Optional(absl::ZeroDuration()));
+  EXPECT_FALSE(debouncer.IsOverdue(start_));
+  EXPECT_TRUE(debouncer.IsOverdue(start_ + absl::Milliseconds(200)));
+}
+
+TEST_F(ChangeDebouncerTest, DependentChangesWaitForEdits) {
+  ChangeDebouncer debouncer = MakeDebouncer();
+  debouncer.AddDependentChange(LspUri("file:///a.x"), start_);
+  debouncer.AddChange(LspUri("file:///b.x"), "b1", start_);
+  debouncer.AddDependentChange(LspUri("file:///c.x"), start_);
+  // An edit supersedes a dependent change of the same buffer, and a later
+  // dependent change does not discard an edit.
+  debouncer.AddChange(LspUri("file:///c.x"), "c1", start_);
+  debouncer.AddDependentChange(LspUri("file:///b.x"), start_);
+
+  debouncer.Flush();
+  EXPECT_THAT(handled_, ElementsAre(Pair("file:///b.x", "b1"),
+                                    Pair("file:///c.x", "c1")));
+  EXPECT_TRUE(debouncer.HasPendingChanges());
+
+  debouncer.Flush();
+  EXPECT_THAT(handled_, ElementsAre(Pair("file:///b.x", "b1"),
+                                    Pair("file:///c.x", "c1"),
+                                    Pair("file:///a.x", kDependent)));
+  EXPECT_FALSE(debouncer.HasPendingChanges());
+}
+
+TEST_F(ChangeDebouncerTest, FlushAllFlushesDependentChangesAddedByTheHandler) {
+  ChangeDebouncer* debouncer_ptr = nullptr;
+  ChangeDebouncer debouncer(
+      absl::Milliseconds(50), absl::Milliseconds(200),
+      [&](const LspUri& uri, std::optional<std::string_view> content) {
+        handled_.push_back(
+            std::make_pair(std::string(uri.GetStringView()),
+                           std::string(content.value_or(kDependent))));
+        if (content.has_value()) {
+          debouncer_ptr->AddDependentChange(LspUri("file:///importer.x"),
+                                            start_);
+        }
+      });
+  debouncer_ptr = &debouncer;
+  debouncer.AddChange(LspUri("file:///a.x"), "a1", start_);
+  debouncer.FlushAll();
+  EXPECT_THAT(handled_, ElementsAre(Pair("file:///a.x", "a1"),
+                                    Pair("file:///importer.x", kDependent)));
+  EXPECT_FALSE(debouncer.HasPendingChanges());
+}
+
+}  // namespace
+}  // namespace xls::dslx
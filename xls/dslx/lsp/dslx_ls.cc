@@ -15,13 +15,15 @@
 // Very simple language server for dslx that
 //  - keeps track of open files and updates them whenever they are
 //    changed in the editor (hidden under the hood).
-//  - On every change, attempts to parse and send back diagnostics
+//  - Once changes quiesce, attempts to parse and send back diagnostics
 //    on errors/warnings.
 //
 // Heavily commented below as this serves as a sample.
 
+#include <poll.h>
 #include <unistd.h>
 
+#include <cstdint>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
@@ -36,6 +38,7 @@
 #include "absl/flags/flag.h"
 #include "absl/status/status.h"
 #include "absl/strings/str_split.h"
+#include "absl/time/time.h"
 #include "nlohmann/json.hpp"
 #include "verible/common/lsp/json-rpc-dispatcher.h"
 #include "verible/common/lsp/lsp-protocol.h"
@@ -44,6 +47,8 @@
 #include "xls/common/exit_status.h"
 #include "xls/common/init_xls.h"
 #include "xls/dslx/default_dslx_stdlib_path.h"
+#include "xls/dslx/lsp/change_debouncer.h"
+#include "xls/dslx/lsp/json_rpc_method.h"
 #include "xls/dslx/lsp/language_server_adapter.h"
 #include "xls/dslx/lsp/lsp_uri.h"
 
@@ -55,6 +60,18 @@ ABSL_FLAG(std::string, dslx_path,
           getenv(kDslxPath) != nullptr ? getenv(kDslxPath) : "",
           "Additional paths to search for modules (colon delimited).");
 
+ABSL_FLAG(int64_t, debounce_ms, 0,
+          "Milliseconds without further input to wait after a buffer change "
+          "before re-analyzing it; changes arriving within this window are "
+          "coalesced into a single analysis. If zero, a change is analyzed as "
+          "soon as no further input is waiting, so changes are only coalesced "
+          "while the server is behind the editor. Requests that need analysis "
+          "results (e.g. go-to-definition) flush pending changes immediately.");
+ABSL_FLAG(int64_t, debounce_max_ms, 500,
+          "Maximum milliseconds a buffer change waits to be analyzed while "
+          "further input keeps arriving, so that diagnostics are still "
+          "refreshed during continuous typing.");
+
 namespace xls::dslx {
 namespace {
 
@@ -98,34 +115,40 @@ InitializeResult InitializeServer(const nlohmann::json& params) {
 }
 
 // On text change: attempt to parse the buffer and emit diagnostics if needed.
+//
+// `file_content` is std::nullopt when the buffer is re-analyzed with its
+// current contents because a buffer it imports changed.
 void TextChangeHandler(const LspUri& file_uri,
-                       const EditTextBuffer& text_buffer,
+                       std::optional<std::string_view> file_content,
+                       ChangeDebouncer& debouncer,
                        verible::lsp::JsonRpcDispatcher& dispatcher,
                        LanguageServerAdapter& adapter) {
-  text_buffer.RequestContent([&](std::string_view file_content) {
+  if (!file_content.has_value()) {
     // Note: this returns a status, but we don't need to surface it from here.
+    adapter.Update(file_uri, std::nullopt).IgnoreError();
+  } else if (auto it = adapter.vfs_contents().find(file_uri);
+             it == adapter.vfs_contents().end() ||
+             it->second != *file_content) {
     adapter.Update(file_uri, file_content).IgnoreError();
-  });
 
-  // For now we brute force evaluate all the files in the DAG that may be
-  // sensitive to the update. We'll need to be smarter as we observe scaling
-  // issues (e.g. only evaluate sensitive files if the original file went from
-  // being an import-time error to having no import-time error).
-  std::vector<LspUri> sensitive_uris =
-      adapter.import_sensitivity().GatherAllSensitiveToChangeIn(file_uri);
-  for (const LspUri& sensitive_uri : sensitive_uris) {
-    // Note to all dependent files that an update has occurred.
-    // We don't need to do this for the file that we updated directly.
-    if (sensitive_uri != file_uri) {
-      adapter.Update(sensitive_uri, std::nullopt).IgnoreError();
+    // The files in the DAG that may be sensitive to the update are brute force
+    // re-evaluated, but only once no further edits are pending, so that they
+    // do not delay diagnostics for the buffer being edited.
+    for (const LspUri& sensitive_uri :
+         adapter.import_sensitivity().GatherAllSensitiveToChangeIn(file_uri)) {
+      if (sensitive_uri != file_uri) {
+        debouncer.AddDependentChange(sensitive_uri, absl::Now());
+      }
     }
-
-    verible::lsp::PublishDiagnosticsParams params{
-        .uri = std::string{sensitive_uri.GetStringView()},
-        .diagnostics = adapter.GenerateParseDiagnostics(sensitive_uri),
-    };
-    dispatcher.SendNotification("textDocument/publishDiagnostics", params);
   }
+  // Otherwise the contents were already analyzed (e.g., an edit was undone
+  // before it was flushed), so only the diagnostics are re-sent.
+
+  verible::lsp::PublishDiagnosticsParams params{
+      .uri = std::string{file_uri.GetStringView()},
+      .diagnostics = adapter.GenerateParseDiagnostics(file_uri),
+  };
+  dispatcher.SendNotification("textDocument/publishDiagnostics", params);
 }
 
 // Attempt to canonicalize "original_path" and return that if successful.
@@ -155,9 +178,21 @@ static std::filesystem::path FailSafeCanonicalize(
   return original_path;
 }
 
+// Returns true if there is input to read on stdin (or the stream is closed or
+// in error, which the reader should observe) within `timeout`.
+static bool InputAvailableWithin(absl::Duration timeout) {
+  pollfd fd{.fd = STDIN_FILENO, .events = POLLIN, .revents = 0};
+  return poll(&fd, 1, static_cast<int>(absl::ToInt64Milliseconds(timeout))) !=
+         0;
+}
+
 absl::Status RealMain() {
   const std::string stdlib_path = absl::GetFlag(FLAGS_stdlib_path);
   const std::string dslx_path = absl::GetFlag(FLAGS_dslx_path);
+  const absl::Duration debounce =
+      absl::Milliseconds(absl::GetFlag(FLAGS_debounce_ms));
+  const absl::Duration debounce_max =
+      absl::Milliseconds(absl::GetFlag(FLAGS_debounce_max_ms));
   const std::vector<std::filesystem::path> dslx_paths =
       absl::StrSplit(dslx_path, ':');
 
@@ -194,12 +229,33 @@ absl::Status RealMain() {
     std::cout << reply << std::flush;
   });
 
+  // Latest contents of buffers that changed since they were last analyzed.
+  // Typing produces a change per keystroke, and analyzing a buffer (and the
+  // buffers that import it) on each one makes the server fall behind the
+  // editor, so analysis is deferred until input quiesces; see the main loop.
+  ChangeDebouncer debouncer(
+      debounce, debounce_max,
+      [&](const LspUri& uri, std::optional<std::string_view> content) {
+        TextChangeHandler(uri, content, debouncer, dispatcher,
+                          language_server_adapter);
+      });
+
   // The input is continuous stream of (header/body)*. The stream
   // splitter separates these messages and feeds them one by one
   // to the dispatcher.
+  //
+  // Messages other than buffer updates (e.g. requests) may reply with results
+  // of analysis, so pending changes are analyzed before they are dispatched.
+  // Only the method name is scanned for; the dispatcher parses the message.
   MessageStreamSplitter stream_splitter;
   stream_splitter.SetMessageProcessor(
-      [&dispatcher](std::string_view header, std::string_view body) {
+      [&](std::string_view header, std::string_view body) {
+        if (debouncer.HasPendingChanges()) {
+          std::optional<std::string> method = PeekJsonRpcMethod(body);
+          if (!method.has_value() || !IsBufferSyncNotification(*method)) {
+            debouncer.FlushAll();
+          }
+        }
         return dispatcher.DispatchMessage(body);
       });
 
@@ -230,8 +286,10 @@ absl::Status RealMain() {
         if (buffer == nullptr) {
           return;  // buffer got deleted. No interest.
         }
-        TextChangeHandler(LspUri(uri), *buffer, dispatcher,
-                          language_server_adapter);
+        buffer->RequestContent([&](std::string_view file_content) {
+          debouncer.AddChange(LspUri(uri), std::string(file_content),
+                              absl::Now());
+        });
       });
 
   dispatcher.AddRequestHandler(
@@ -319,8 +377,18 @@ absl::Status RealMain() {
       });
 
   // Main loop. Feeding the stream-splitter that then calls the dispatcher.
+  // Pending buffer changes are analyzed once no input has arrived for the
+  // debounce interval, or once the oldest has waited for the maximum debounce
+  // latency.
   absl::Status status = absl::OkStatus();
   while (status.ok() && !shutdown_requested) {
+    const absl::Time now = absl::Now();
+    if (std::optional<absl::Duration> wait = debouncer.TimeUntilFlush(now);
+        wait.has_value() &&
+        (debouncer.IsOverdue(now) || !InputAvailableWithin(*wait))) {
+      debouncer.Flush();
+      continue;
+    }
     status = stream_splitter.PullFrom([](char* buf, int size) -> int {  //
       return static_cast<int>(read(STDIN_FILENO, buf, size));
     });
@@ -0,0 +1,100 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/json_rpc_method.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "absl/strings/match.h"
+#include "nlohmann/json.hpp"
+
+namespace xls::dslx {
+namespace {
+
+// SAX handler which stops parsing once it has seen the value of the top-level
+// "method" key.
+class MethodPeeker : public nlohmann::json_sax<nlohmann::json> {
+ public:
+  bool null() override { return Value(); }
+  bool boolean(bool) override { return Value(); }
+  bool number_integer(number_integer_t) override { return Value(); }
+  bool number_unsigned(number_unsigned_t) override { return Value(); }
+  bool number_float(number_float_t, const string_t&) override {
+    return Value();
+  }
+  bool string(string_t& value) override {
+    if (at_method_) {
+      method_ = value;
+      return false;
+    }
+    return Value();
+  }
+  bool binary(binary_t&) override { return Value(); }
+  bool start_object(std::size_t) override {
+    ++depth_;
+    return Value();
+  }
+  bool key(string_t& key) override {
+    at_method_ = depth_ == 1 && key == "method";
+    return true;
+  }
+  bool end_object() override {
+    --depth_;
+    return true;
+  }
+  bool start_array(std::size_t) override {
+    ++depth_;
+    return Value();
+  }
+  bool end_array() override {
+    --depth_;
+    return true;
+  }
+  bool parse_error(std::size_t, const std::string&,
+                   const nlohmann::detail::exception&) override {
+    return false;
+  }
+
+  const std::optional<std::string>& method() const { return method_; }
+
+ private:
+  // Called for any value other than the method name; a non-string "method"
+  // is not a method name.
+  bool Value() {
+    at_method_ = false;
+    return true;
+  }
+
+  int64_t depth_ = 0;
+  bool at_method_ = false;
+  std::optional<std::string> method_;
+};
+
+}  // namespace
+
+std::optional<std::string> PeekJsonRpcMethod(std::string_view body) {
+  MethodPeeker peeker;
+  nlohmann::json::sax_parse(body.data(), body.data() + body.size(), &peeker);
+  return peeker.method();
+}
+
+bool IsBufferSyncNotification(std::string_view method) {
+  return absl::StartsWith(method, "textDocument/did");
+}
+
+}  // namespace xls::dslx
@@ -0,0 +1,38 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_DSLX_LSP_JSON_RPC_METHOD_H_
+#define XLS_DSLX_LSP_JSON_RPC_METHOD_H_
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace xls::dslx {
+
+// Returns the "method" member of the JSON-RPC message `body`, or std::nullopt
+// if it has none (e.g., a response) or is malformed up to that point.
+//
+// This scans the message only up to the method name and builds no JSON
+// document, so it is cheap to call on every message before dispatching it.
+std::optional<std::string> PeekJsonRpcMethod(std::string_view body);
+
+// Returns true for notifications which only update buffer contents, such as
+// "textDocument/didChange", as opposed to requests which read analysis
+// results.
+bool IsBufferSyncNotification(std::string_view method);
+
+}  // namespace xls::dslx
+
+#endif  // XLS_DSLX_LSP_JSON_RPC_METHOD_H_
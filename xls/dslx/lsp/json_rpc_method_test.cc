@@ -0,0 +1,65 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/dslx/lsp/json_rpc_method.h"
+
+#include <optional>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+namespace xls::dslx {
+namespace {
+
+using ::testing::Optional;
+
+TEST(JsonRpcMethodTest, PeeksRequestMethod) {
+  EXPECT_THAT(
+      PeekJsonRpcMethod(R"({"jsonrpc":"2.0","id":1,)"
+                        R"("method":"textDocument/definition",)"
+                        R"("params":{"textDocument":{"uri":"file:///a.x"}}})"),
+      Optional(std::string("textDocument/definition")));
+}
+
+TEST(JsonRpcMethodTest, IgnoresNestedMethodKeys) {
+  EXPECT_THAT(
+      PeekJsonRpcMethod(R"({"params":{"method":"nested",)"
+                        R"("list":[{"method":1}]},)"
+                        R"("method":"textDocument/didChange"})"),
+      Optional(std::string("textDocument/didChange")));
+}
+
+TEST(JsonRpcMethodTest, NoMethod) {
+  EXPECT_EQ(PeekJsonRpcMethod(R"({"jsonrpc":"2.0","id":1,"result":null})"),
+            std::nullopt);
+  EXPECT_EQ(PeekJsonRpcMethod(R"({"method":42})"), std::nullopt);
+  EXPECT_EQ(PeekJsonRpcMethod("not json"), std::nullopt);
+}
+
+TEST(JsonRpcMethodTest, IgnoresMalformedTrailingContent) {
+  // Scanning stops at the method, so later errors are not observed.
+  EXPECT_THAT(PeekJsonRpcMethod(R"({"method":"initialize","params":{)"),
+              Optional(std::string("initialize")));
+}
+
+TEST(JsonRpcMethodTest, BufferSyncNotifications) {
+  EXPECT_TRUE(IsBufferSyncNotification("textDocument/didOpen"));
+  EXPECT_TRUE(IsBufferSyncNotification("textDocument/didChange"));
+  EXPECT_FALSE(IsBufferSyncNotification("textDocument/documentSymbol"));
+  EXPECT_FALSE(IsBufferSyncNotification("shutdown"));
+}
+
+}  // namespace
+}  // namespace xls::dslx
@@ -35,6 +35,7 @@
 #include "xls/dslx/frontend/scanner.h"
 #include "xls/dslx/frontend/semantics_analysis.h"
 #include "xls/dslx/import_data.h"
+#include "xls/dslx/import_routines.h"
 #include "xls/dslx/ir_convert/convert_options.h"
 #include "xls/dslx/type_system/type_info.h"
 #include "xls/dslx/type_system/typecheck_module.h"
@@ -66,6 +67,13 @@ absl::StatusOr<TypecheckedModule> ParseAndTypecheck(
                                    import_data->file_table(), comments));
 
   XLS_RETURN_IF_ERROR(module->SetConfiguredValues(options.configured_values));
+
+  // Parse the import closure concurrently up front; imports then only need to
+  // be typechecked as the typechecker reaches them.
+  PrefetchImports(*module, import_data, import_data->vfs());
+  absl::Cleanup clear_prefetched = [&] {
+    import_data->ClearPrefetchedModules();
+  };
   return TypecheckModule(std::move(module), path, import_data, force_version);
 }
 
@@ -27,6 +27,7 @@
 
 #include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -57,8 +58,12 @@
 #include "xls/ir/events.h"
 #include "xls/ir/format_preference.h"
 #include "xls/ir/function.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
 #include "xls/ir/package.h"
 #include "xls/ir/proc_elaboration.h"
+#include "xls/ir/source_location.h"
 #include "xls/ir/value.h"
 #include "xls/jit/function_jit.h"
 #include "xls/jit/jit_proc_runtime.h"
@@ -68,6 +73,48 @@
 
 namespace xls::dslx {
 namespace {
+
+// Returns the DSLX span of the assertion in `package` with `message`, from
+// the source position the IR converter gives assertion nodes. IR positions
+// only record where the assertion starts, so the span is empty.
+std::optional<Span> AssertionSpan(const Package& package,
+                                  std::string_view message,
+                                  FileTable& file_table) {
+  for (FunctionBase* fb : package.GetFunctionBases()) {
+    for (Node* node : fb->nodes()) {
+      if (!node->Is<xls::Assert>() ||
+          node->As<xls::Assert>()->message() != message ||
+          node->loc().Empty()) {
+        continue;
+      }
+      const SourceLocation& loc = node->loc().locations.front();
+      std::optional<std::string> filename = package.GetFilename(loc.fileno());
+      if (!filename.has_value()) {
+        continue;
+      }
+      Pos pos(file_table.GetOrCreate(*filename), loc.lineno().value(),
+              loc.colno().value());
+      return Span(pos, pos);
+    }
+  }
+  return std::nullopt;
+}
+
+// Converts the assertion messages produced by evaluating `package` into a test
+// failure status, reported at the DSLX position of the first failing
+// assertion as the bytecode interpreter does.
+absl::Status AssertionFailureStatus(const Package& package,
+                                    absl::Span<const std::string> asserts,
+                                    FileTable& file_table) {
+  std::string message = absl::StrJoin(asserts, "\n");
+  std::optional<Span> span =
+      AssertionSpan(package, asserts.front(), file_table);
+  if (span.has_value()) {
+    return FailureErrorStatus(*span, message, file_table);
+  }
+  return absl::AbortedError(message);
+}
+
 class IrRunner : public AbstractParsedTestRunner {
  public:
   IrRunner(
@@ -78,12 +125,16 @@ class IrRunner : public AbstractParsedTestRunner {
       std::function<absl::StatusOr<InterpreterResult<Value>>(
           xls::Function* f, absl::Span<Value const>)>
           func_runner,
-      ImportData* import_data)
+      ImportData* import_data,
+      absl::flat_hash_set<std::string>&& unconverted_tests,
+      std::unique_ptr<AbstractParsedTestRunner> fallback)
       : packages_(std::move(packages)),
         finish_chan_names_(std::move(finish_chan_names)),
         proc_runner_(std::move(proc_runner)),
         func_runner_(std::move(func_runner)),
-        import_data_(import_data) {}
+        import_data_(import_data),
+        unconverted_tests_(std::move(unconverted_tests)),
+        fallback_(std::move(fallback)) {}
 
   template <typename ChannelT>
   absl::StatusOr<RunResult> RunTestSingleProc(
@@ -118,8 +169,8 @@ class IrRunner : public AbstractParsedTestRunner {
       }
       return RunResult{.result = absl::OkStatus()};
     }
-    return RunResult{.result =
-                         absl::AbortedError(absl::StrJoin(asserts, "\n"))};
+    return RunResult{.result = AssertionFailureStatus(
+                         *rt->package(), asserts, file_table())};
   }
 
   // TODO need to move to having each test proc have its own package from
@@ -149,6 +200,9 @@ class IrRunner : public AbstractParsedTestRunner {
   absl::StatusOr<RunResult> RunTestProc(
       std::string_view name,
       const BytecodeInterpreterOptions& options) override {
+    if (ShouldFallBack(name, options)) {
+      return fallback_->RunTestProc(name, options);
+    }
     if (options.trace_channels()) {
       LOG(WARNING) << "Unable to trace channels with IR testing";
     }
@@ -175,6 +229,9 @@ class IrRunner : public AbstractParsedTestRunner {
   absl::StatusOr<RunResult> RunTestFunction(
       std::string_view name,
       const BytecodeInterpreterOptions& options) override {
+    if (ShouldFallBack(name, options)) {
+      return fallback_->RunTestFunction(name, options);
+    }
     auto* func_package = packages_.at(name).get();
     XLS_ASSIGN_OR_RETURN(xls::Function * f, func_package->GetTopAsFunction());
     XLS_RET_CHECK(f->GetType()->return_type()->IsTuple()) << f->GetType();
@@ -189,13 +246,36 @@ class IrRunner : public AbstractParsedTestRunner {
     if (v.events.assert_msgs.empty()) {
       return RunResult{.result = absl::OkStatus()};
     }
-    return RunResult{.result = absl::AbortedError(
-                         absl::StrJoin(v.events.assert_msgs, "\n"))};
+    return RunResult{.result = AssertionFailureStatus(
+                         *func_package, v.events.assert_msgs, file_table())};
   }
 
  private:
   FileTable& file_table() { return import_data_->file_table(); }
 
+  // Returns true if the test `name` should be run by the fallback (bytecode)
+  // runner: either it could not be converted to IR or the options request
+  // features only the bytecode interpreter supports.
+  bool ShouldFallBack(std::string_view name,
+                      const BytecodeInterpreterOptions& options) const {
+    if (fallback_ == nullptr) {
+      return false;
+    }
+    if (unconverted_tests_.contains(name)) {
+      VLOG(1) << "Test " << name
+              << " could not be converted to IR; running in the DSLX "
+                 "interpreter.";
+      return true;
+    }
+    if (options.post_fn_eval_hook() != nullptr) {
+      VLOG(1) << "Test " << name
+              << " uses a post-function-evaluation hook; running in the DSLX "
+                 "interpreter.";
+      return true;
+    }
+    return false;
+  }
+
   absl::flat_hash_map<std::string, std::unique_ptr<Package>> packages_;
   absl::flat_hash_map<std::string, std::string> finish_chan_names_;
   std::function<absl::StatusOr<std::unique_ptr<ProcRuntime>>(xls::Package*)>
@@ -204,6 +284,8 @@ class IrRunner : public AbstractParsedTestRunner {
       xls::Function* f, absl::Span<Value const>)>
       func_runner_;
   ImportData* import_data_;
+  absl::flat_hash_set<std::string> unconverted_tests_;
+  std::unique_ptr<AbstractParsedTestRunner> fallback_;
 };
 
 absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> MakeRunner(
@@ -212,7 +294,8 @@ absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> MakeRunner(
         xls::Function* f, absl::Span<Value const>)>
         func,
     std::function<absl::StatusOr<std::unique_ptr<ProcRuntime>>(xls::Package*)>
-        proc) {
+        proc,
+    bool fallback_to_dslx_interpreter) {
   ConvertOptions base_option{
       .emit_fail_as_assert = true,
       .verify_ir = false,
@@ -222,6 +305,7 @@ absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> MakeRunner(
   };
   absl::flat_hash_map<std::string, std::unique_ptr<Package>> packages;
   absl::flat_hash_map<std::string, std::string> finish_chan_names;
+  absl::flat_hash_set<std::string> unconverted_tests;
   for (std::string_view name : module->GetTestNames()) {
     std::optional<ModuleMember*> maybe_member =
         module->FindMemberWithName(name);
@@ -230,8 +314,18 @@ absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> MakeRunner(
     PackageConversionData package_data{
         .package = std::make_unique<Package>(
             absl::StrFormat("%s_test_for_package_%s", name, module->name()))};
-    XLS_RETURN_IF_ERROR(ConvertOneFunctionIntoPackage(
-        module, name, import_data, nullptr, base_option, &package_data));
+    absl::Status converted = ConvertOneFunctionIntoPackage(
+        module, name, import_data, nullptr, base_option, &package_data);
+    if (!converted.ok()) {
+      if (!fallback_to_dslx_interpreter) {
+        return converted;
+      }
+      LOG(WARNING) << "Unable to convert test " << name
+                   << " to IR; it will run in the DSLX interpreter: "
+                   << converted;
+      unconverted_tests.insert(std::string(name));
+      continue;
+    }
     if (std::holds_alternative<TestProc*>(*member)) {
       TestProc* tp = std::get<TestProc*>(*member);
       std::string dslx_chan_name =
@@ -242,9 +336,15 @@ absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> MakeRunner(
     }
     packages[name] = std::move(package_data.package);
   }
+  std::unique_ptr<AbstractParsedTestRunner> fallback;
+  if (fallback_to_dslx_interpreter) {
+    fallback = std::make_unique<DslxInterpreterParsedTestRunner>(
+        import_data, type_info, module);
+  }
   return std::make_unique<IrRunner>(
       std::move(packages), std::move(finish_chan_names), std::move(proc),
-      std::move(func), import_data);
+      std::move(func), import_data, std::move(unconverted_tests),
+      std::move(fallback));
 }
 }  // namespace
 
@@ -265,7 +365,8 @@ IrJitTestRunner::CreateTestRunner(ImportData* import_data, TypeInfo* type_info,
         } else {
           return CreateJitSerialProcRuntime(p, EvaluatorOptions());
         }
-      });
+      },
+      fallback_to_dslx_interpreter_);
 }
 
 absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>>
@@ -284,7 +385,8 @@ IrInterpreterTestRunner::CreateTestRunner(ImportData* import_data,
         } else {
           return CreateInterpreterSerialProcRuntime(p, EvaluatorOptions());
         }
-      });
+      },
+      /*fallback_to_dslx_interpreter=*/false);
 }
 
 }  // namespace xls::dslx
@@ -32,11 +32,24 @@ class IrInterpreterTestRunner : public AbstractTestRunner {
       Module* module) const override;
 };
 
+// Runs each test by converting it to IR and executing it with the JIT.
+//
+// If `fallback_to_dslx_interpreter` is set, tests which cannot be converted to
+// IR (or which need features only the bytecode interpreter provides, such as
+// post-function-evaluation hooks) are run in the DSLX bytecode interpreter
+// instead of failing the whole module.
 class IrJitTestRunner : public AbstractTestRunner {
+ public:
+  explicit IrJitTestRunner(bool fallback_to_dslx_interpreter = false)
+      : fallback_to_dslx_interpreter_(fallback_to_dslx_interpreter) {}
+
  protected:
   absl::StatusOr<std::unique_ptr<AbstractParsedTestRunner>> CreateTestRunner(
       ImportData* import_data, TypeInfo* type_info,
       Module* module) const override;
+
+ private:
+  bool fallback_to_dslx_interpreter_;
 };
 
 }  // namespace xls::dslx
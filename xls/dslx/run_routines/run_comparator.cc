@@ -146,4 +146,18 @@ absl::StatusOr<InterpreterResult<xls::Value>> RunComparator::RunIrFunction(
   return jit->Run(ir_args);
 }
 
+absl::StatusOr<std::unique_ptr<AbstractRunComparator>>
+RunComparator::CloneForConcurrentUse(std::string_view ir_name,
+                                     xls::Function* ir_function) const {
+  if (mode_ != CompareMode::kJit) {
+    // The IR interpreter may create types in the function's package, which is
+    // not thread-safe.
+    return nullptr;
+  }
+  auto clone = std::make_unique<RunComparator>(mode_);
+  XLS_RETURN_IF_ERROR(
+      clone->GetOrCompileJitFunction(ir_name, ir_function).status());
+  return clone;
+}
+
 }  // namespace xls::dslx
@@ -63,6 +63,11 @@ class RunComparator : public AbstractRunComparator {
       std::string_view ir_name, xls::Function* ir_function,
       absl::Span<const xls::Value> ir_args) override;
 
+  // Supported in JIT mode only: each clone owns an independent JIT compilation
+  // of `ir_function`.
+  absl::StatusOr<std::unique_ptr<AbstractRunComparator>> CloneForConcurrentUse(
+      std::string_view ir_name, xls::Function* ir_function) const override;
+
   // Returns the cached or newly-compiled jit function for ir_name.  ir_name has
   // already been mangled (see MangleDslxName) so it should be unique in the
   // program and is used as the cache key.
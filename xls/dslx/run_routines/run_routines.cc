@@ -17,6 +17,7 @@
 #include <unistd.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 #include <functional>
@@ -45,6 +46,7 @@
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/data_structures/inline_bitmap.h"
 #include "xls/dslx/bytecode/bytecode.h"
 #include "xls/dslx/bytecode/bytecode_cache.h"
@@ -97,6 +99,10 @@ namespace {
 constexpr int kUnitSpaces = 7;
 constexpr int kQuickcheckSpaces = 15;
 
+// Number of QuickCheck cases generated per worker thread between
+// synchronization points when evaluating cases concurrently.
+constexpr int64_t kQuickCheckCasesPerJobChunk = 1024;
+
 // Helper routine for handling an error that occurs as the result of a test
 // execution. Prints the error and that the test failed to stderr. Adds the test
 // case to the accumulated test result data in `result`.
@@ -412,7 +418,7 @@ absl::StatusOr<QuickCheckResults> DoQuickCheck(
     bool requires_implicit_token, dslx::FunctionType* dslx_fn_type,
     xls::Function* ir_function, std::string_view ir_name,
     AbstractRunComparator* run_comparator, int64_t seed,
-    QuickCheckTestCases test_cases) {
+    QuickCheckTestCases test_cases, int64_t num_jobs) {
   QuickCheckResults results;
   std::minstd_rand rng_engine(seed);
   xls::TupleType* ir_param_tuple = ir_function->package()->GetTupleType(
@@ -464,26 +470,16 @@ absl::StatusOr<QuickCheckResults> DoQuickCheck(
   XLS_RET_CHECK_EQ(ir_param_tuple->size(), dslx_param_types.size())
       << "IR param tuple size should match DSLX param types size";
 
-  for (int i = 0; i < num_tests; i++) {
-    {
-      std::vector<Value> arg_set = make_arg_set(i);
-      if (!ValuesAreValid(arg_set, dslx_param_types)) {
-        // Note: if we reject an argument set, it counts as a test case -- this
-        // makes sense for exhaustive mode but less sense for randomized mode,
-        // we may want those to operate slightly differently.
-        continue;
-      }
-      results.arg_sets.push_back(std::move(arg_set));
-    }
-
-    // TODO(https://github.com/google/xls/issues/506): 2021-10-15
-    // Assertion failures should work out, but we should consciously decide
-    // if/how we want to dump traces when running QuickChecks (always, for
-    // failures, flag-controlled, ...).
-    absl::Span<const Value> this_arg_set = results.arg_sets.back();
+  // TODO(https://github.com/google/xls/issues/506): 2021-10-15
+  // Assertion failures should work out, but we should consciously decide
+  // if/how we want to dump traces when running QuickChecks (always, for
+  // failures, flag-controlled, ...).
+  auto evaluate =
+      [&](AbstractRunComparator* comparator,
+          absl::Span<const Value> arg_set) -> absl::StatusOr<Value> {
     XLS_ASSIGN_OR_RETURN(xls::Value result,
-                         DropInterpreterEvents(run_comparator->RunIrFunction(
-                             ir_name, ir_function, this_arg_set)));
+                         DropInterpreterEvents(comparator->RunIrFunction(
+                             ir_name, ir_function, arg_set)));
 
     // In the case of an implicit token signature we get (token, bool) as the
     // result of the quickcheck'd function, so we unbox the boolean here.
@@ -496,14 +492,100 @@ absl::StatusOr<QuickCheckResults> DoQuickCheck(
         << "quickcheck properties must return `bool`, should be validated by "
            "type checking; got: "
         << result;
+    return result;
+  };
 
-    results.results.push_back(result);
-
-    if (result.IsAllZeros()) {
-      // We were able to falsify the xls_function (predicate), bail out early
-      // and present this evidence.
+  // Additional comparators for concurrent evaluation; the caller's comparator
+  // is used by the first worker.
+  std::vector<std::unique_ptr<AbstractRunComparator>> clones;
+  for (int64_t i = 1; i < std::min(num_jobs, num_tests); ++i) {
+    XLS_ASSIGN_OR_RETURN(
+        std::unique_ptr<AbstractRunComparator> clone,
+        run_comparator->CloneForConcurrentUse(ir_name, ir_function));
+    if (clone == nullptr) {
+      clones.clear();
       break;
     }
+    clones.push_back(std::move(clone));
+  }
+
+  if (clones.empty()) {
+    for (int64_t i = 0; i < num_tests; i++) {
+      {
+        std::vector<Value> arg_set = make_arg_set(i);
+        if (!ValuesAreValid(arg_set, dslx_param_types)) {
+          // Note: if we reject an argument set, it counts as a test case --
+          // this makes sense for exhaustive mode but less sense for randomized
+          // mode, we may want those to operate slightly differently.
+          continue;
+        }
+        results.arg_sets.push_back(std::move(arg_set));
+      }
+
+      XLS_ASSIGN_OR_RETURN(Value result,
+                           evaluate(run_comparator, results.arg_sets.back()));
+      results.results.push_back(result);
+
+      if (result.IsAllZeros()) {
+        // We were able to falsify the xls_function (predicate), bail out early
+        // and present this evidence.
+        break;
+      }
+    }
+    return results;
+  }
+
+  // Concurrent evaluation. Argument sets are generated serially in chunks (so
+  // the random sequence matches a serial run), evaluated by the workers, and
+  // then committed in order up to the first falsifying example or error.
+  std::vector<AbstractRunComparator*> comparators = {run_comparator};
+  for (const std::unique_ptr<AbstractRunComparator>& clone : clones) {
+    comparators.push_back(clone.get());
+  }
+  const int64_t jobs = comparators.size();
+  int64_t next_test = 0;
+  while (next_test < num_tests) {
+    const int64_t chunk_end =
+        std::min(num_tests, next_test + kQuickCheckCasesPerJobChunk * jobs);
+    std::vector<std::vector<Value>> arg_sets;
+    for (; next_test < chunk_end; ++next_test) {
+      std::vector<Value> arg_set = make_arg_set(next_test);
+      if (ValuesAreValid(arg_set, dslx_param_types)) {
+        arg_sets.push_back(std::move(arg_set));
+      }
+    }
+
+    // Index of the earliest case known to stop the run; workers skip cases
+    // beyond it. Every case before the final value is evaluated.
+    std::atomic<int64_t> first_stop(arg_sets.size());
+    std::vector<absl::StatusOr<Value>> chunk_results(
+        arg_sets.size(), absl::InternalError("QuickCheck case not evaluated"));
+    // Job `job` evaluates every `jobs`-th case with its own comparator on a
+    // thread of the shared pool (or the calling thread).
+    ParallelFor(ThreadPool::Shared(), jobs, jobs, [&](int64_t job) {
+      for (int64_t i = job; i < arg_sets.size(); i += jobs) {
+        if (i > first_stop.load(std::memory_order_relaxed)) {
+          return;
+        }
+        chunk_results[i] = evaluate(comparators[job], arg_sets[i]);
+        if (!chunk_results[i].ok() || chunk_results[i]->IsAllZeros()) {
+          int64_t stop = first_stop.load(std::memory_order_relaxed);
+          while (i < stop && !first_stop.compare_exchange_weak(
+                                 stop, i, std::memory_order_relaxed)) {
+          }
+          return;
+        }
+      }
+    });
+
+    for (int64_t i = 0; i < arg_sets.size(); ++i) {
+      XLS_ASSIGN_OR_RETURN(Value result, std::move(chunk_results[i]));
+      results.arg_sets.push_back(std::move(arg_sets[i]));
+      results.results.push_back(result);
+      if (result.IsAllZeros()) {
+        return results;
+      }
+    }
   }
 
   return results;
@@ -548,7 +630,8 @@ static absl::StatusOr<QuickcheckIrFn> FindQuickcheckIrFn(Function* dslx_fn,
 
 static absl::Status RunQuickCheck(AbstractRunComparator* run_comparator,
                                   Package* ir_package, QuickCheck* quickcheck,
-                                  TypeInfo* type_info, int64_t seed) {
+                                  TypeInfo* type_info, int64_t seed,
+                                  int64_t num_jobs) {
   // Note: DSLX function.
   dslx::Function* dslx_fn = quickcheck->fn();
 
@@ -574,7 +657,7 @@ static absl::Status RunQuickCheck(AbstractRunComparator* run_comparator,
       DoQuickCheck(
           qc_fn.calling_convention == CallingConvention::kImplicitToken,
           dslx_fn_type, qc_fn.ir_function, qc_fn.ir_name, run_comparator, seed,
-          quickcheck->test_cases()));
+          quickcheck->test_cases(), num_jobs));
 
   // Extract the (inputs, outputs) from the results.
   const auto& [inputs, outputs] = qc_results;
@@ -630,7 +713,7 @@ static absl::Status RunQuickCheck(AbstractRunComparator* run_comparator,
 static absl::Status RunQuickChecksIfJitEnabled(
     const RE2* test_filter, Module* entry_module, TypeInfo* type_info,
     AbstractRunComparator* run_comparator, Package* ir_package,
-    std::optional<int64_t> seed, TestResultData& result,
+    std::optional<int64_t> seed, int64_t num_jobs, TestResultData& result,
     VirtualizableFilesystem& vfs) {
   if (run_comparator == nullptr) {
     // TODO(leary): 2024-02-08 Note that this skips /all/ the quickchecks so we
@@ -672,7 +755,8 @@ static absl::Status RunQuickChecksIfJitEnabled(
     std::cerr << "[ RUN QUICKCHECK        ] " << quickcheck_name
               << " cases: " << quickcheck->test_cases().ToString() << "\n";
     const absl::Status status =
-        RunQuickCheck(run_comparator, ir_package, quickcheck, type_info, *seed);
+        RunQuickCheck(run_comparator, ir_package, quickcheck, type_info, *seed,
+                      num_jobs);
     const absl::Duration duration = absl::Now() - test_case_start;
     if (!status.ok()) {
       HandleError(result, status, quickcheck_name, start_pos, test_case_start,
@@ -1054,8 +1138,8 @@ absl::StatusOr<TestResultData> AbstractTestRunner::ParseAndTest(
   if (!entry_module->GetQuickChecks().empty()) {
     XLS_RETURN_IF_ERROR(RunQuickChecksIfJitEnabled(
         options.test_filter, entry_module, tm->type_info,
-        options.run_comparator, ir_package.get(), options.seed, result,
-        import_data.vfs()));
+        options.run_comparator, ir_package.get(), options.seed,
+        options.quickcheck_jobs, result, import_data.vfs()));
   }
 
   result.Finish(
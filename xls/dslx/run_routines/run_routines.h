@@ -82,6 +82,17 @@ class AbstractRunComparator {
   virtual absl::StatusOr<InterpreterResult<xls::Value>> RunIrFunction(
       std::string_view ir_name, xls::Function* ir_function,
       absl::Span<const xls::Value> ir_args) = 0;
+
+  // Returns a comparator which can run `ir_function` concurrently with this
+  // one (i.e. from a different thread), or nullptr if concurrent execution is
+  // not supported. Any compilation required to run `ir_function` is performed
+  // by this call, so clones should be created serially before being handed to
+  // other threads.
+  virtual absl::StatusOr<std::unique_ptr<AbstractRunComparator>>
+  CloneForConcurrentUse(std::string_view ir_name,
+                        xls::Function* ir_function) const {
+    return nullptr;
+  }
 };
 
 // Optional arguments to ParseAndTest (that have sensible defaults).
@@ -92,6 +103,8 @@ class AbstractRunComparator {
 //    executions with a reference (e.g. IR execution).
 //   execute: Whether or not to execute the quickchecks and tests.
 //   seed: Seed for QuickCheck random input stimulus.
+//   quickcheck_jobs: Number of threads across which the cases of a QuickCheck
+//    are sharded. Results are identical to a serial run.
 //   convert_options: Options used in IR conversion, see `ConvertOptions` for
 //    details.
 //   parse_and_typecheck_options: Options used in parsing and typechecking,
@@ -103,6 +116,7 @@ struct ParseAndTestOptions {
   AbstractRunComparator* run_comparator = nullptr;
   bool execute = true;
   std::optional<int64_t> seed = std::nullopt;
+  int64_t quickcheck_jobs = 1;
   ConvertOptions convert_options;
 
   bool trace_channels = false;
@@ -289,11 +303,18 @@ struct QuickCheckResults {
 // xls_function is a predicate we're trying to find evidence to falsify, so if
 // this finds an example that falsifies the predicate, we early-return (i.e. the
 // length of the returned vectors may be < 1000).
+//
+// If num_jobs > 1 and the run comparator supports concurrent use, argument
+// sets are evaluated on the calling thread and up to num_jobs - 1 threads of
+// the shared `ThreadPool`, each with its own comparator. Argument sets are
+// still generated in order from the seed and results are truncated at the
+// first falsifying example, so the returned value is identical to a serial
+// run.
 absl::StatusOr<QuickCheckResults> DoQuickCheck(
     bool requires_implicit_token, dslx::FunctionType* dslx_fn_type,
     xls::Function* ir_function, std::string_view ir_name,
     AbstractRunComparator* run_comparator, int64_t seed,
-    QuickCheckTestCases test_cases);
+    QuickCheckTestCases test_cases, int64_t num_jobs = 1);
 
 }  // namespace xls::dslx
 
@@ -79,11 +79,13 @@ MATCHER_P4(IsTestResult, result, ran_count, skipped_count, failed_count, "") {
 }
 
 using ::absl_testing::StatusIs;
+using ::testing::ContainsRegex;
 using ::testing::HasSubstr;
 
 enum class RunnerType : int8_t {
   kDslxInterpreter,
   kIrJit,
+  kIrJitWithFallback,
   kIrInterpreter,
   kIrJitProcScoped,
   kIrInterpreterProcScoped,
@@ -98,6 +100,9 @@ void AbslStringify(Sink& sink, const RunnerType& v) {
     case RunnerType::kIrJit:
       absl::Format(&sink, "IrJitTestRunner");
       break;
+    case RunnerType::kIrJitWithFallback:
+      absl::Format(&sink, "IrJitTestRunnerWithFallback");
+      break;
     case RunnerType::kIrInterpreter:
       absl::Format(&sink, "IrInterpreterTestRunner");
       break;
@@ -119,6 +124,7 @@ class RunRoutinesTest : public testing::TestWithParam<RunnerType> {
     DslxInterpreterTestRunner dslx;
     IrInterpreterTestRunner ir;
     IrJitTestRunner jit;
+    IrJitTestRunner jit_with_fallback(/*fallback_to_dslx_interpreter=*/true);
     AbstractTestRunner* runner;
     ParseAndTestOptions options(original_options);
     switch (GetParam()) {
@@ -128,6 +134,9 @@ class RunRoutinesTest : public testing::TestWithParam<RunnerType> {
       case RunnerType::kIrJit:
         runner = &jit;
         break;
+      case RunnerType::kIrJitWithFallback:
+        runner = &jit_with_fallback;
+        break;
       case RunnerType::kIrInterpreter:
         runner = &ir;
         break;
@@ -481,6 +490,30 @@ fn trivial(x: u5) -> bool { false }
   EXPECT_THAT(result, IsTestResult(TestResult::kSomeFailed, 1, 0, 1));
 }
 
+// Assertion failures are reported at their DSLX source position regardless of
+// which evaluator ran the test.
+TEST_P(RunRoutinesTest, FailingAssertReportsDslxPosition) {
+  constexpr const char* kProgram = R"(
+#[test]
+fn test_fails() { assert_eq(u32:1, u32:2) }
+)";
+  ParseAndTestOptions options;
+  options.vfs_factory = [kProgram] {
+    return std::make_unique<UniformContentFilesystem>(kProgram, "test.x");
+  };
+  ::testing::internal::CaptureStderr();
+  XLS_ASSERT_OK_AND_ASSIGN(TestResultData result,
+                           ParseAndTest(kProgram, "test", "test.x", options));
+  std::string stderr_output = ::testing::internal::GetCapturedStderr();
+  EXPECT_THAT(result, IsTestResult(TestResult::kSomeFailed, 1, 0, 1));
+  std::vector<std::string> failures = result.GetFailureMessages();
+  ASSERT_EQ(failures.size(), 1);
+  EXPECT_THAT(failures[0], HasSubstr("FailureError:"));
+  // The positional error is printed starting with the span of the assertion,
+  // which is on the third line of the program.
+  EXPECT_THAT(stderr_output, ContainsRegex("(^|\n)test\\.x:3:"));
+}
+
 TEST_P(RunRoutinesTest, TwoNonParametricProcs) {
   constexpr std::string_view kProgram = R"(
 proc FirstProc {
@@ -848,6 +881,42 @@ TEST(QuickcheckTest, Seeding) {
   EXPECT_EQ(results1, results2);
 }
 
+// Sharding cases across threads must not change which cases are run or the
+// reported results, including truncation at the first falsifying example.
+TEST(QuickcheckTest, ConcurrentJobsMatchSerial) {
+  Package package("sometimes_false");
+  std::string ir_text = R"(
+  fn lt_limit(x: bits[16]) -> bits[1] {
+    literal.2: bits[16] = literal(value=65000)
+    ret ult.3: bits[1] = ult(x, literal.2)
+  }
+  )";
+  int64_t seed = 42;
+  QuickCheckTestCases test_cases = QuickCheckTestCases::Counted(10000);
+  XLS_ASSERT_OK_AND_ASSIGN(xls::Function * function,
+                           Parser::ParseFunction(ir_text, &package));
+  RunComparator jit_comparator(CompareMode::kJit);
+  std::vector<std::unique_ptr<dslx::Type>> params;
+
+  params.push_back(std::make_unique<dslx::BitsType>(false, 16));
+  auto return_type = std::make_unique<dslx::BitsType>(false, 1);
+  dslx::FunctionType fn_type(std::move(params), std::move(return_type));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto serial,
+      DoQuickCheck(/*requires_implicit_token=*/false, &fn_type, function,
+                   kFakeIrName, &jit_comparator, seed, test_cases));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto concurrent,
+      DoQuickCheck(/*requires_implicit_token=*/false, &fn_type, function,
+                   kFakeIrName, &jit_comparator, seed, test_cases,
+                   /*num_jobs=*/4));
+
+  EXPECT_EQ(serial.arg_sets, concurrent.arg_sets);
+  EXPECT_EQ(serial.results, concurrent.results);
+  EXPECT_EQ(concurrent.results.back(), Value(UBits(0, 1)));
+}
+
 TEST(QuickcheckTest, ProofFailure) {
   constexpr std::string_view kProgram = R"(
 #[quickcheck(exhaustive)]
@@ -1090,6 +1159,7 @@ INSTANTIATE_TEST_SUITE_P(RunRoutinesTest, RunRoutinesTest,
                          testing::Values(RunnerType::kDslxInterpreter,
                                          RunnerType::kIrInterpreter,
                                          RunnerType::kIrJit,
+                                         RunnerType::kIrJitWithFallback,
                                          RunnerType::kIrInterpreterProcScoped,
                                          RunnerType::kIrJitProcScoped),
                          testing::PrintToStringParamName());
@@ -1097,6 +1167,7 @@ INSTANTIATE_TEST_SUITE_P(ParseAndTestTest, ParseAndTestTest,
                          testing::Values(RunnerType::kDslxInterpreter,
                                          RunnerType::kIrInterpreter,
                                          RunnerType::kIrJit,
+                                         RunnerType::kIrJitWithFallback,
                                          RunnerType::kIrInterpreterProcScoped,
                                          RunnerType::kIrJitProcScoped),
                          testing::PrintToStringParamName());
@@ -361,8 +361,8 @@ class InferenceTableImpl : public InferenceTable {
     return result;
   }
 
-  bool MapToCanonicalInvocationTypeInfo(ParametricContext* parametric_context,
-                                        ParametricEnv env) override {
+  CanonicalInvocationResult MapToCanonicalInvocationTypeInfo(
+      ParametricContext* parametric_context, ParametricEnv env) override {
     CHECK(parametric_context->is_invocation());
 
     // `ParametricEnv` doesn't currently capture generic types, so for the time
@@ -370,7 +370,7 @@ class InferenceTableImpl : public InferenceTable {
     for (const ParametricBinding* binding :
          parametric_context->parametric_bindings()) {
       if (binding->type_annotation()->IsAnnotation<GenericTypeAnnotation>()) {
-        return false;
+        return CanonicalInvocationResult::kIneligible;
       }
     }
 
@@ -381,7 +381,7 @@ class InferenceTableImpl : public InferenceTable {
     if (it == canonical_parametric_context_.end()) {
       canonical_parametric_context_.emplace_hint(
           it, std::make_pair(details.callee, env), parametric_context);
-      return false;
+      return CanonicalInvocationResult::kCreated;
     }
 
     mutable_parametric_context_data_.at(parametric_context).canonical_context =
@@ -394,7 +394,7 @@ class InferenceTableImpl : public InferenceTable {
     parametric_context->SetParametricFreeFunctionType(
         std::get<ParametricInvocationDetails>(it->second->details())
             .parametric_free_function_type);
-    return true;
+    return CanonicalInvocationResult::kReused;
   }
 
   std::vector<const ParametricContext*> GetParametricInvocations()
@@ -334,6 +334,17 @@ class ParametricContextScopedExpr {
   const Expr* const expr_;
 };
 
+// The outcome of `InferenceTable::MapToCanonicalInvocationTypeInfo`.
+enum class CanonicalInvocationResult : uint8_t {
+  // The context now shares the type info of an existing canonical context.
+  kReused,
+  // The context became the canonical context for its callee and env.
+  kCreated,
+  // The callee has generic type parametrics, which `ParametricEnv` does not
+  // capture, so the context is not canonicalized.
+  kIneligible,
+};
+
 // A table that facilitates a type inference algorithm where unknowns during the
 // course of inference are represented using variables (which we call "inference
 // variables"). An inference variable may be internally fabricated by the
@@ -404,17 +415,25 @@ class InferenceTable {
   // `env`.
   //
   // If an existing context is found, updates the `TypeInfo` pointer associated
-  // with `context` to be one from the existing context, and returns true. The
-  // implication is that there is then no point in spending effort to populate
-  // the original `TypeInfo` that was associated with `context`. Whether or not
-  // the caller subsequently uses this information, the table will make use of
-  // it for internal cache optimization.
+  // with `context` to be one from the existing context, and returns `kReused`.
+  // The implication is that there is then no point in spending effort to
+  // populate the original `TypeInfo` that was associated with `context`.
+  // Whether or not the caller subsequently uses this information, the table
+  // will make use of it for internal cache optimization.
   //
   // If an existing matching context is not found, then this function captures
   // the `env`, makes `context` eligible to serve as a canonical context for
-  // that `env` in the future, and returns false.
-  virtual bool MapToCanonicalInvocationTypeInfo(ParametricContext* context,
-                                                ParametricEnv env) = 0;
+  // that `env` in the future, and returns `kCreated`.
+  //
+  // The key is the callee and `env`; argument types are not part of it. For an
+  // eligible callee the parametric-free function type is a function of the
+  // parametric values alone, so all invocations with the same env have the
+  // same parameter types, and an argument of any other type is a type error
+  // against that signature rather than a distinct instantiation. Argument
+  // types only select an instantiation when a binding is a generic type, and
+  // such callees are reported as `kIneligible` and not canonicalized.
+  virtual CanonicalInvocationResult MapToCanonicalInvocationTypeInfo(
+      ParametricContext* context, ParametricEnv env) = 0;
 
   // Retrieves all the parametric invocations that have been defined.
   virtual std::vector<const ParametricContext*> GetParametricInvocations()
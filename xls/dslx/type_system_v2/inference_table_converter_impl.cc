@@ -661,8 +661,14 @@ class InferenceTableConverterImpl : public InferenceTableConverter,
                          GenerateParametricFunctionEnv(
                              function_and_target_object.target_struct_context,
                              invocation_context, invocation));
-    const bool canonicalized = table_.MapToCanonicalInvocationTypeInfo(
-        invocation_context, std::move(env));
+    const CanonicalInvocationResult canonical_result =
+        table_.MapToCanonicalInvocationTypeInfo(invocation_context,
+                                                std::move(env));
+    const bool canonicalized =
+        canonical_result == CanonicalInvocationResult::kReused;
+    trace.SetUsedCache(canonicalized);
+    trace.SetPopulatedCache(canonical_result ==
+                            CanonicalInvocationResult::kCreated);
 
     // Skip adding type info for `map` invocations because the invocation type
     // info expected by IR conversion is that for the passed in mapper function,
@@ -646,8 +646,9 @@ TEST_F(InferenceTableTest, CachingForCanonicalizedParametricContext) {
                                *invocation1, *foo, bar,
                                /*parent_context=*/std::nullopt,
                                /*self_type=*/std::nullopt, CreateTypeInfo()));
-  EXPECT_FALSE(table_->MapToCanonicalInvocationTypeInfo(canonicalized_context1,
-                                                        canonical_env));
+  EXPECT_EQ(table_->MapToCanonicalInvocationTypeInfo(canonicalized_context1,
+                                                     canonical_env),
+            CanonicalInvocationResult::kCreated);
   const FunctionTypeAnnotation* function_type =
       module_->Make<FunctionTypeAnnotation>(
           std::vector<const TypeAnnotation*>{
@@ -659,8 +660,9 @@ TEST_F(InferenceTableTest, CachingForCanonicalizedParametricContext) {
                                *invocation2, *foo, bar,
                                /*parent_context=*/std::nullopt,
                                /*self_type=*/std::nullopt, CreateTypeInfo()));
-  EXPECT_TRUE(table_->MapToCanonicalInvocationTypeInfo(canonicalized_context2,
-                                                       canonical_env));
+  EXPECT_EQ(table_->MapToCanonicalInvocationTypeInfo(canonicalized_context2,
+                                                     canonical_env),
+            CanonicalInvocationResult::kReused);
   EXPECT_EQ(canonicalized_context1->type_info(),
             canonicalized_context2->type_info());
   EXPECT_EQ(
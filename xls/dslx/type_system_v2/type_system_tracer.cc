@@ -335,6 +335,14 @@ class TypeSystemTracerImpl : public TypeSystemTracer {
     absl::StrAppendFormat(
         &result, "Type variable unifications: %d (%d used global cache).\n\n",
         variable_unification_count_, cached_variable_unification_count_);
+    absl::StrAppendFormat(
+        &result,
+        "Parametric invocations: %d (%d reused canonical type info, %d "
+        "instantiated as canonical, %d ineligible for reuse).\n\n",
+        parametric_invocation_count_, reused_parametric_invocation_count_,
+        canonical_parametric_invocation_count_,
+        parametric_invocation_count_ - reused_parametric_invocation_count_ -
+            canonical_parametric_invocation_count_);
 
     for (auto& [node, node_stats] : stats) {
       std::string node_string = node->ToString();
@@ -382,6 +390,15 @@ class TypeSystemTracerImpl : public TypeSystemTracer {
         ++cached_variable_unification_count_;
       }
     }
+    if (impl->kind == TraceKind::kConvertInvocation &&
+        impl->used_cache.has_value()) {
+      ++parametric_invocation_count_;
+      if (*impl->used_cache) {
+        ++reused_parametric_invocation_count_;
+      } else if (impl->populated_cache.value_or(false)) {
+        ++canonical_parametric_invocation_count_;
+      }
+    }
     stack_.pop();
   }
 
@@ -412,6 +429,9 @@ class TypeSystemTracerImpl : public TypeSystemTracer {
   absl::flat_hash_map<const AstNode*, NodeStats> stats_;
   int variable_unification_count_ = 0;
   int cached_variable_unification_count_ = 0;
+  int parametric_invocation_count_ = 0;
+  int reused_parametric_invocation_count_ = 0;
+  int canonical_parametric_invocation_count_ = 0;
   bool time_every_action_;
 };
 
@@ -16,7 +16,9 @@
 
 #include <memory>
 #include <optional>
+#include <vector>
 
+#include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
@@ -32,6 +34,8 @@
 namespace xls::dslx {
 namespace {
 
+using ::testing::HasSubstr;
+
 class TypeSystemTracerTest : public ::testing::Test {
  public:
   void SetUp() override {
@@ -90,5 +94,41 @@ ConvertNode (%p, node: 2, kind: number)
                             one, one, one, u32, two));
 }
 
+TEST_F(TypeSystemTracerTest, ConvertStatsToStringCountsReusedInvocations) {
+  NameDef* name_def = module_->Make<NameDef>(Span::Fake(), "f", nullptr);
+  NameRef* callee = module_->Make<NameRef>(Span::Fake(), "f", name_def);
+  Invocation* invocation = module_->Make<Invocation>(
+      Span::Fake(), callee, std::vector<Expr*>{}, std::vector<ExprOrType>{});
+  {
+    TypeSystemTrace trace =
+        tracer_->TraceConvertInvocation(invocation, std::nullopt, std::nullopt);
+    trace.SetUsedCache(false);
+    trace.SetPopulatedCache(true);
+  }
+  // An invocation of a callee with generic type parametrics, which cannot be
+  // canonicalized.
+  {
+    TypeSystemTrace trace =
+        tracer_->TraceConvertInvocation(invocation, std::nullopt, std::nullopt);
+    trace.SetUsedCache(false);
+    trace.SetPopulatedCache(false);
+  }
+  for (int i = 0; i < 2; i++) {
+    TypeSystemTrace trace =
+        tracer_->TraceConvertInvocation(invocation, std::nullopt, std::nullopt);
+    trace.SetUsedCache(true);
+  }
+  // Non-parametric invocations do not set the cache flag and are not counted.
+  {
+    TypeSystemTrace trace =
+        tracer_->TraceConvertInvocation(invocation, std::nullopt, std::nullopt);
+  }
+
+  EXPECT_THAT(tracer_->ConvertStatsToString(file_table_),
+              HasSubstr("Parametric invocations: 4 (2 reused canonical type "
+                        "info, 1 instantiated as canonical, 1 ineligible for "
+                        "reuse)."));
+}
+
 }  // namespace
 }  // namespace xls::dslx
@@ -180,7 +180,8 @@ absl::StatusOr<std::filesystem::path> SaveCrasher(
 absl::StatusOr<CompletedSampleKind> RunSample(
     const Sample& smp, const std::filesystem::path& run_dir,
     const std::optional<std::filesystem::path>& summary_file,
-    std::optional<absl::Duration> generate_sample_elapsed) {
+    std::optional<absl::Duration> generate_sample_elapsed, bool in_process,
+    bool collect_pass_metrics) {
   XLS_ASSIGN_OR_RETURN(std::filesystem::path sample_runner_main_path,
                        GetXlsRunfilePath(kSampleRunnerMainPath));
 
@@ -227,7 +228,9 @@ cd "$RUNDIR"
 
   VLOG(1) << "Starting to run sample";
   VLOG(2) << smp.input_text();
-  SampleRunner runner(run_dir);
+  SampleRunner runner(run_dir, in_process ? SampleRunner::InProcessCommands()
+                                         : SampleRunner::Commands{});
+  runner.set_collect_pass_metrics(collect_pass_metrics);
   XLS_ASSIGN_OR_RETURN(auto fuzz_result,
                        runner.RunFromFiles(sample_file_name, options_file_name,
                                            testvector_path));
@@ -253,26 +256,20 @@ cd "$RUNDIR"
   return fuzz_result;
 }
 
-absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
-    dslx::FileTable& file_table, absl::BitGenRef bit_gen,
-    const dslx::AstGeneratorOptions& ast_generator_options,
-    const SampleOptions& sample_options, const std::filesystem::path& run_dir,
+absl::StatusOr<CompletedSampleKind> RunSampleAndSaveCrasher(
+    const Sample& smp, const std::filesystem::path& run_dir,
     const std::optional<std::filesystem::path>& crasher_dir,
     const std::optional<std::filesystem::path>& summary_file,
-    bool force_failure) {
-  Stopwatch stopwatch;
-  XLS_ASSIGN_OR_RETURN(
-      Sample smp, GenerateSample(ast_generator_options, sample_options, bit_gen,
-                                 file_table));
-  absl::Duration generate_sample_elapsed = stopwatch.GetElapsedTime();
-
+    std::optional<absl::Duration> generate_sample_elapsed, bool force_failure,
+    bool in_process, bool collect_pass_metrics) {
   absl::StatusOr<CompletedSampleKind> status =
-      RunSample(smp, run_dir, summary_file, generate_sample_elapsed);
+      RunSample(smp, run_dir, summary_file, generate_sample_elapsed,
+                in_process, collect_pass_metrics);
   if (force_failure) {
     status = absl::InternalError("Forced sample failure.");
   }
   if (status.ok()) {
-    return std::pair(smp, status.value());
+    return status;
   }
 
   LOG(ERROR) << "Sample failed: " << status.status();
@@ -283,9 +280,9 @@ absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
     if (!absl::IsDeadlineExceeded(status.status())) {
       LOG(INFO) << "Attempting to minimize IR...";
       std::optional<absl::Duration> timeout =
-          sample_options.timeout_seconds().has_value()
+          smp.options().timeout_seconds().has_value()
               ? std::optional<absl::Duration>(
-                    absl::Seconds(*sample_options.timeout_seconds()))
+                    absl::Seconds(*smp.options().timeout_seconds()))
               : std::nullopt;
       XLS_ASSIGN_OR_RETURN(
           std::optional<std::filesystem::path> minimized_path,
@@ -303,4 +300,25 @@ absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
   return status.status();
 }
 
+absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
+    dslx::FileTable& file_table, absl::BitGenRef bit_gen,
+    const dslx::AstGeneratorOptions& ast_generator_options,
+    const SampleOptions& sample_options, const std::filesystem::path& run_dir,
+    const std::optional<std::filesystem::path>& crasher_dir,
+    const std::optional<std::filesystem::path>& summary_file,
+    bool force_failure, bool in_process, bool collect_pass_metrics) {
+  Stopwatch stopwatch;
+  XLS_ASSIGN_OR_RETURN(
+      Sample smp, GenerateSample(ast_generator_options, sample_options, bit_gen,
+                                 file_table));
+  absl::Duration generate_sample_elapsed = stopwatch.GetElapsedTime();
+
+  XLS_ASSIGN_OR_RETURN(
+      CompletedSampleKind kind,
+      RunSampleAndSaveCrasher(smp, run_dir, crasher_dir, summary_file,
+                              generate_sample_elapsed, force_failure,
+                              in_process, collect_pass_metrics));
+  return std::pair(smp, kind);
+}
+
 }  // namespace xls
@@ -31,13 +31,29 @@ namespace xls {
 
 // Runs the given sample in `run_dir`. If `summary_file` is given, the sample
 // summary will be appended to this file; if `generate_sample_elapsed` is also
-// given, it will be recorded in the timings in the sample summary.
+// given, it will be recorded in the timings in the sample summary. If
+// `in_process` is true, the stages which support it run within this process
+// (see SampleRunner::InProcessCommands) rather than as subprocesses. If
+// `collect_pass_metrics` is true, the optimizer's pass pipeline metrics are
+// written to the run directory (see SampleRunner::set_collect_pass_metrics).
 //
 // `run_dir` must be an empty directory.
 absl::StatusOr<CompletedSampleKind> RunSample(
     const Sample& smp, const std::filesystem::path& run_dir,
     const std::optional<std::filesystem::path>& summary_file = std::nullopt,
-    std::optional<absl::Duration> generate_sample_elapsed = std::nullopt);
+    std::optional<absl::Duration> generate_sample_elapsed = std::nullopt,
+    bool in_process = false, bool collect_pass_metrics = false);
+
+// Runs the given sample in `run_dir` as RunSample does. If the sample fails and
+// `crasher_dir` is given, the sample is saved there as a crasher and its IR is
+// minimized. If `force_failure` is true, the sample is treated as failing.
+absl::StatusOr<CompletedSampleKind> RunSampleAndSaveCrasher(
+    const Sample& smp, const std::filesystem::path& run_dir,
+    const std::optional<std::filesystem::path>& crasher_dir = std::nullopt,
+    const std::optional<std::filesystem::path>& summary_file = std::nullopt,
+    std::optional<absl::Duration> generate_sample_elapsed = std::nullopt,
+    bool force_failure = false, bool in_process = false,
+    bool collect_pass_metrics = false);
 
 absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
     dslx::FileTable& file_table, absl::BitGenRef bit_gen,
@@ -45,7 +61,8 @@ absl::StatusOr<std::pair<Sample, CompletedSampleKind>> GenerateSampleAndRun(
     const SampleOptions& sample_options, const std::filesystem::path& run_dir,
     const std::optional<std::filesystem::path>& crasher_dir = std::nullopt,
     const std::optional<std::filesystem::path>& summary_file = std::nullopt,
-    bool force_failure = false);
+    bool force_failure = false, bool in_process = false,
+    bool collect_pass_metrics = false);
 
 }  // namespace xls
 
@@ -21,8 +21,10 @@
 #include <random>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
 #include "absl/random/distributions.h"
 #include "absl/random/random.h"
@@ -41,6 +43,8 @@
 #include "xls/fuzzer/ast_generator.h"
 #include "xls/fuzzer/run_fuzz.h"
 #include "xls/fuzzer/sample.h"
+#include "xls/fuzzer/sample_coverage.h"
+#include "xls/fuzzer/sample_generator.h"
 #include "xls/fuzzer/sample_runner.h"
 
 namespace xls {
@@ -56,6 +60,19 @@ static constexpr std::string_view kBlueText = "\033[34m";
 static constexpr std::string_view kRedText = "\033[31m";
 static constexpr std::string_view kDefaultColor = "\033[0m";
 
+// Maximum number of coverage-increasing samples kept for mutation.
+static constexpr int64_t kMaxCorpusSize = 1024;
+
+// Probability that a worker mutates a corpus sample rather than generating a
+// new one when fuzzing is coverage-guided.
+static constexpr double kMutationProbability = 0.5;
+
+// Shared state for coverage-guided fuzzing.
+struct CoverageState {
+  CoverageMap coverage;
+  SampleCorpus corpus{kMaxCorpusSize};
+};
+
 absl::StatusOr<FuzzResult> GenerateAndRunSamples(
     int64_t worker_number,
     const dslx::AstGeneratorOptions& ast_generator_options,
@@ -64,9 +81,11 @@ absl::StatusOr<FuzzResult> GenerateAndRunSamples(
     const std::optional<std::filesystem::path>& crasher_dir,
     const std::optional<std::filesystem::path>& summary_dir,
     std::optional<int64_t> sample_count,
-    const std::optional<absl::Duration>& duration, bool force_failure) {
+    const std::optional<absl::Duration>& duration, bool force_failure,
+    bool in_process, CoverageState* coverage_state) {
   int64_t crashers = 0;
   int64_t skipped = 0;
+  int64_t mutated = 0;
   LOG(INFO) << "--- Started worker " << worker_number;
   Stopwatch stopwatch;
 
@@ -104,9 +123,40 @@ absl::StatusOr<FuzzResult> GenerateAndRunSamples(
       run_dir = temp_run_dir->path();
     }
 
-    auto result = GenerateSampleAndRun(file_table, rng, ast_generator_options,
-                                       sample_options, run_dir, crasher_dir,
-                                       summary_file, force_failure);
+    std::optional<Sample> mutant;
+    if (coverage_state != nullptr && !ast_generator_options.generate_proc &&
+        absl::Bernoulli(rng, kMutationProbability)) {
+      if (std::optional<Sample> seed_sample =
+              coverage_state->corpus.Choose(rng);
+          seed_sample.has_value()) {
+        absl::StatusOr<Sample> mutated_sample = MutateSample(*seed_sample, rng);
+        if (mutated_sample.ok()) {
+          mutant = *std::move(mutated_sample);
+        } else {
+          VLOG(1) << "Failed to mutate corpus sample: "
+                  << mutated_sample.status();
+        }
+      }
+    }
+
+    absl::StatusOr<std::pair<Sample, CompletedSampleKind>> result;
+    if (mutant.has_value()) {
+      ++mutated;
+      absl::StatusOr<CompletedSampleKind> kind = RunSampleAndSaveCrasher(
+          *mutant, run_dir, crasher_dir, summary_file,
+          /*generate_sample_elapsed=*/std::nullopt, force_failure, in_process,
+          /*collect_pass_metrics=*/true);
+      if (kind.ok()) {
+        result = std::pair(*std::move(mutant), *kind);
+      } else {
+        result = kind.status();
+      }
+    } else {
+      result = GenerateSampleAndRun(
+          file_table, rng, ast_generator_options, sample_options, run_dir,
+          crasher_dir, summary_file, force_failure, in_process,
+          /*collect_pass_metrics=*/coverage_state != nullptr);
+    }
     if (!result.ok()) {
       LOG(INFO) << kRedText
                 << absl::StreamFormat(
@@ -118,11 +168,22 @@ absl::StatusOr<FuzzResult> GenerateAndRunSamples(
     if (result.ok() && result.value().second == CompletedSampleKind::kSkipped) {
       skipped++;
     }
+    if (coverage_state != nullptr && result.ok() &&
+        result->second != CompletedSampleKind::kSkipped) {
+      absl::StatusOr<absl::flat_hash_set<std::string>> features =
+          GetSampleCoverage(run_dir);
+      if (!features.ok()) {
+        LOG(WARNING) << "Failed to collect sample coverage: "
+                     << features.status();
+      } else if (coverage_state->coverage.Merge(*features) > 0) {
+        coverage_state->corpus.Add(std::move(result->first));
+      }
+    }
 
     absl::Duration elapsed = stopwatch.GetElapsedTime();
     if (sample > 0 && sample % 16 == 0) {
       std::vector<std::string> metrics;
-      metrics.reserve(3);
+      metrics.reserve(4);
       if (sample_count.has_value()) {
         metrics.push_back(
             absl::StrFormat("%d/%d samples", sample, *sample_count));
@@ -140,6 +201,11 @@ absl::StatusOr<FuzzResult> GenerateAndRunSamples(
         metrics.push_back(
             absl::StrFormat("running for %s", absl::FormatDuration(elapsed)));
       }
+      if (coverage_state != nullptr) {
+        metrics.push_back(absl::StrFormat(
+            "%d mutated, %d coverage features, %d corpus samples", mutated,
+            coverage_state->coverage.size(), coverage_state->corpus.size()));
+      }
       LOG(INFO) << absl::StreamFormat("--- Worker #%d: %s", worker_number,
                                       absl::StrJoin(metrics, ", "));
     }
@@ -182,7 +248,11 @@ absl::Status ParallelGenerateAndRunSamples(
     const std::optional<std::filesystem::path>& crasher_dir,
     const std::optional<std::filesystem::path>& summary_dir,
     std::optional<int64_t> sample_count, std::optional<absl::Duration> duration,
-    bool force_failure) {
+    bool force_failure, bool in_process, bool coverage_guided) {
+  std::optional<CoverageState> coverage_state;
+  if (coverage_guided) {
+    coverage_state.emplace();
+  }
   std::vector<std::unique_ptr<Thread>> workers;
   workers.resize(worker_count);
   std::vector<absl::StatusOr<FuzzResult>> worker_status;
@@ -198,7 +268,10 @@ absl::Status ParallelGenerateAndRunSamples(
       *status =
           GenerateAndRunSamples(i, ast_generator_options, sample_options, seed,
                                 top_run_dir, crasher_dir, summary_dir,
-                                worker_sample_count, duration, force_failure);
+                                worker_sample_count, duration, force_failure,
+                                in_process,
+                                coverage_state.has_value() ? &*coverage_state
+                                                           : nullptr);
     });
   }
 
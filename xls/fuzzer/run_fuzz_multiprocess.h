@@ -36,7 +36,14 @@ namespace xls {
 // written to `crasher_dir`, and summaries to `summary_dir`.
 //
 // If `force_failure` is true, every sample run will be considered a failure.
-// This is useful for testing failure paths.
+// This is useful for testing failure paths. If `in_process` is true, sample
+// stages which support it run within the worker threads instead of as
+// subprocesses; this is faster but a crashing stage takes down the fuzzer.
+//
+// If `coverage_guided` is true, the IR-level coverage of each sample (see
+// GetSampleCoverage) is collected, samples which add new coverage are kept in a
+// corpus shared by all workers, and workers mutate corpus samples in place of
+// generating new ones some of the time. Only function samples are mutated.
 absl::Status ParallelGenerateAndRunSamples(
     int64_t worker_count,
     const dslx::AstGeneratorOptions& ast_generator_options,
@@ -47,7 +54,8 @@ absl::Status ParallelGenerateAndRunSamples(
     const std::optional<std::filesystem::path>& summary_dir = std::nullopt,
     std::optional<int64_t> sample_count = std::nullopt,
     std::optional<absl::Duration> duration = std::nullopt,
-    bool force_failure = false);
+    bool force_failure = false, bool in_process = false,
+    bool coverage_guided = false);
 
 }  // namespace xls
 
@@ -0,0 +1,146 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/sample_coverage.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/random/bit_gen_ref.h"
+#include "absl/random/distributions.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/str_cat.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/math_util.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/fuzzer/sample.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/ir_parser.h"
+#include "xls/ir/node.h"
+#include "xls/ir/op.h"
+#include "xls/ir/package.h"
+#include "xls/ir/type.h"
+#include "xls/passes/pass_metrics.pb.h"
+
+namespace xls {
+namespace {
+
+std::string NodeFeature(const Node* node) {
+  const Type* type = node->GetType();
+  return absl::StrCat(OpToString(node->op()), ":",
+                      TypeKindToString(type->kind()), ":",
+                      CeilOfLog2(type->GetFlatBitCount()));
+}
+
+// Adds the op features of the IR package in `ir_path`, if it exists, to
+// `features`, prefixing each with `stage`.
+absl::Status AddIrFeatures(const std::filesystem::path& ir_path,
+                           std::string_view stage,
+                           absl::flat_hash_set<std::string>& features) {
+  if (!FileExists(ir_path).ok()) {
+    return absl::OkStatus();
+  }
+  XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(ir_path));
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       Parser::ParsePackage(ir_text, ir_path.string()));
+  for (FunctionBase* fb : package->GetFunctionBases()) {
+    for (Node* node : fb->nodes()) {
+      const std::string node_feature = NodeFeature(node);
+      features.insert(absl::StrCat(stage, ":", node_feature));
+      for (Node* operand : node->operands()) {
+        features.insert(absl::StrCat(stage, ":", node_feature, "<-",
+                                     OpToString(operand->op())));
+      }
+    }
+  }
+  return absl::OkStatus();
+}
+
+void AddPassFeatures(const PassMetricsProto& metrics,
+                     absl::flat_hash_set<std::string>& features) {
+  if (metrics.changed() > 0) {
+    features.insert(absl::StrCat("pass:", metrics.pass_name()));
+  }
+  for (const PassMetricsProto& nested : metrics.nested_results()) {
+    AddPassFeatures(nested, features);
+  }
+}
+
+}  // namespace
+
+absl::StatusOr<absl::flat_hash_set<std::string>> GetSampleCoverage(
+    const std::filesystem::path& run_dir) {
+  absl::flat_hash_set<std::string> features;
+  XLS_RETURN_IF_ERROR(AddIrFeatures(run_dir / "sample.ir", "unopt", features));
+  XLS_RETURN_IF_ERROR(
+      AddIrFeatures(run_dir / "sample.opt.ir", "opt", features));
+
+  std::filesystem::path metrics_path =
+      run_dir / "sample.opt.pass_metrics.textproto";
+  if (FileExists(metrics_path).ok()) {
+    PassPipelineMetricsProto metrics;
+    XLS_RETURN_IF_ERROR(ParseTextProtoFile(metrics_path, &metrics));
+    AddPassFeatures(metrics.pass_metrics(), features);
+  }
+  return features;
+}
+
+int64_t CoverageMap::Merge(const absl::flat_hash_set<std::string>& features) {
+  absl::MutexLock lock(&mutex_);
+  int64_t added = 0;
+  for (const std::string& feature : features) {
+    if (features_.insert(feature).second) {
+      ++added;
+    }
+  }
+  return added;
+}
+
+int64_t CoverageMap::size() const {
+  absl::MutexLock lock(&mutex_);
+  return features_.size();
+}
+
+void SampleCorpus::Add(Sample sample) {
+  absl::MutexLock lock(&mutex_);
+  if (samples_.size() < max_size_) {
+    samples_.push_back(std::move(sample));
+    return;
+  }
+  samples_[next_] = std::move(sample);
+  next_ = (next_ + 1) % max_size_;
+}
+
+std::optional<Sample> SampleCorpus::Choose(absl::BitGenRef bit_gen) const {
+  absl::MutexLock lock(&mutex_);
+  if (samples_.empty()) {
+    return std::nullopt;
+  }
+  return samples_[absl::Uniform<size_t>(bit_gen, 0, samples_.size())];
+}
+
+int64_t SampleCorpus::size() const {
+  absl::MutexLock lock(&mutex_);
+  return samples_.size();
+}
+
+}  // namespace xls
@@ -0,0 +1,83 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_FUZZER_SAMPLE_COVERAGE_H_
+#define XLS_FUZZER_SAMPLE_COVERAGE_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "absl/base/thread_annotations.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/random/bit_gen_ref.h"
+#include "absl/status/statusor.h"
+#include "absl/synchronization/mutex.h"
+#include "xls/fuzzer/sample.h"
+
+namespace xls {
+
+// Returns the coverage features exercised by the sample run in `run_dir`, as
+// recorded in the artifacts written by SampleRunner. A feature is a string
+// naming one of:
+//   * an IR op with its result type kind and log2-bucketed width, in the
+//     unoptimized or optimized IR;
+//   * an (op, operand op) edge in the unoptimized or optimized IR;
+//   * an optimization pass which changed the IR.
+// Missing artifacts (e.g. when the sample failed before optimization)
+// contribute no features.
+absl::StatusOr<absl::flat_hash_set<std::string>> GetSampleCoverage(
+    const std::filesystem::path& run_dir);
+
+// The set of coverage features seen so far across samples. Thread-safe.
+class CoverageMap {
+ public:
+  // Adds `features` to the map and returns how many were not already present.
+  int64_t Merge(const absl::flat_hash_set<std::string>& features);
+
+  int64_t size() const;
+
+ private:
+  mutable absl::Mutex mutex_;
+  absl::flat_hash_set<std::string> features_ ABSL_GUARDED_BY(mutex_);
+};
+
+// A bounded corpus of samples which increased coverage, from which samples are
+// chosen as seeds for mutation. Once full, the oldest sample is replaced.
+// Thread-safe.
+class SampleCorpus {
+ public:
+  explicit SampleCorpus(int64_t max_size) : max_size_(max_size) {}
+
+  void Add(Sample sample);
+
+  // Returns a uniformly chosen sample from the corpus, or std::nullopt if the
+  // corpus is empty.
+  std::optional<Sample> Choose(absl::BitGenRef bit_gen) const;
+
+  int64_t size() const;
+
+ private:
+  const int64_t max_size_;
+  mutable absl::Mutex mutex_;
+  std::vector<Sample> samples_ ABSL_GUARDED_BY(mutex_);
+  // Index of the next sample to replace once the corpus is full.
+  int64_t next_ ABSL_GUARDED_BY(mutex_) = 0;
+};
+
+}  // namespace xls
+
+#endif  // XLS_FUZZER_SAMPLE_COVERAGE_H_
@@ -0,0 +1,106 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/fuzzer/sample_coverage.h"
+
+#include <optional>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/status/status_matchers.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/fuzzer/sample.h"
+#include "xls/tests/testvector.pb.h"
+
+namespace xls {
+namespace {
+
+using ::absl_testing::IsOkAndHolds;
+using ::testing::Contains;
+using ::testing::IsEmpty;
+using ::testing::Not;
+
+TEST(SampleCoverageTest, CollectsIrAndPassFeatures) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory run_dir, TempDirectory::Create());
+  XLS_ASSERT_OK(SetFileContents(run_dir.path() / "sample.ir", R"(
+package sample
+
+top fn main(x: bits[8] id=1, y: bits[8] id=2) -> bits[8] {
+  ret add.3: bits[8] = add(x, y, id=3)
+}
+)"));
+  XLS_ASSERT_OK(
+      SetFileContents(run_dir.path() / "sample.opt.pass_metrics.textproto",
+                      R"(
+total_passes: 3
+pass_metrics {
+  pass_name: "ir"
+  changed: 1
+  nested_results { pass_name: "dce" changed: 1 }
+  nested_results { pass_name: "cse" changed: 0 }
+}
+)"));
+
+  XLS_ASSERT_OK_AND_ASSIGN(absl::flat_hash_set<std::string> features,
+                           GetSampleCoverage(run_dir.path()));
+  EXPECT_THAT(features, Contains("unopt:add:bits:3"));
+  EXPECT_THAT(features, Contains("unopt:add:bits:3<-param"));
+  EXPECT_THAT(features, Contains("unopt:param:bits:3"));
+  EXPECT_THAT(features, Contains("pass:dce"));
+  EXPECT_THAT(features, Not(Contains("pass:cse")));
+  // There is no optimized IR.
+  EXPECT_THAT(features, Not(Contains("opt:add:bits:3")));
+}
+
+TEST(SampleCoverageTest, EmptyRunDirectory) {
+  XLS_ASSERT_OK_AND_ASSIGN(TempDirectory run_dir, TempDirectory::Create());
+  EXPECT_THAT(GetSampleCoverage(run_dir.path()), IsOkAndHolds(IsEmpty()));
+}
+
+TEST(SampleCoverageTest, CoverageMapCountsNewFeatures) {
+  CoverageMap coverage;
+  EXPECT_EQ(coverage.Merge({"a", "b"}), 2);
+  EXPECT_EQ(coverage.Merge({"b", "c"}), 1);
+  EXPECT_EQ(coverage.Merge({"a", "c"}), 0);
+  EXPECT_EQ(coverage.size(), 3);
+}
+
+TEST(SampleCoverageTest, CorpusReplacesOldestSample) {
+  std::mt19937_64 rng;
+  SampleCorpus corpus(/*max_size=*/2);
+  EXPECT_FALSE(corpus.Choose(rng).has_value());
+
+  auto make_sample = [](std::string text) {
+    return Sample(std::move(text), SampleOptions(),
+                  testvector::SampleInputsProto());
+  };
+  corpus.Add(make_sample("first"));
+  corpus.Add(make_sample("second"));
+  corpus.Add(make_sample("third"));
+  EXPECT_EQ(corpus.size(), 2);
+  for (int i = 0; i < 16; ++i) {
+    std::optional<Sample> sample = corpus.Choose(rng);
+    ASSERT_TRUE(sample.has_value());
+    EXPECT_NE(sample->input_text(), "first");
+  }
+}
+
+}  // namespace
+}  // namespace xls
@@ -56,6 +56,7 @@
 #include "xls/dslx/virtualizable_file_system.h"
 #include "xls/dslx/warning_kind.h"
 #include "xls/fuzzer/ast_generator.h"
+#include "xls/fuzzer/dslx_mutator.h"
 #include "xls/fuzzer/sample.h"
 #include "xls/fuzzer/sample.pb.h"
 #include "xls/fuzzer/value_generator.h"
@@ -545,4 +546,38 @@ absl::StatusOr<Sample> GenerateSample(
                                 sample_options_copy, bit_gen, dslx_text);
 }
 
+absl::StatusOr<Sample> MutateSample(const Sample& sample,
+                                    absl::BitGenRef bit_gen,
+                                    int64_t max_attempts) {
+  constexpr std::string_view top_name = "main";
+  XLS_RET_CHECK(sample.options().input_is_dslx());
+  XLS_RET_CHECK(sample.options().IsFunctionSample())
+      << "Only function samples can be mutated.";
+
+  for (int64_t attempt = 0; attempt < max_attempts; ++attempt) {
+    XLS_ASSIGN_OR_RETURN(std::string dslx_text,
+                         dslx::RemoveDslxToken(sample.input_text(), bit_gen));
+    ImportData import_data(
+        dslx::CreateImportData(/*stdlib_path=*/"",
+                               /*additional_search_paths=*/{},
+                               /*enabled_warnings=*/dslx::kAllWarningsSet,
+                               std::make_unique<dslx::RealFilesystem>()));
+    absl::StatusOr<TypecheckedModule> tm =
+        ParseAndTypecheck(dslx_text, "sample.x", "sample", &import_data);
+    if (!tm.ok()) {
+      VLOG(2) << "Mutant failed to parse-and-typecheck: " << tm.status();
+      continue;
+    }
+    absl::StatusOr<dslx::Function*> function =
+        tm->module->GetMemberOrError<dslx::Function>(top_name);
+    if (!function.ok()) {
+      continue;
+    }
+    return GenerateFunctionSample(*function, *tm, sample.options(), bit_gen,
+                                  dslx_text);
+  }
+  return absl::NotFoundError(absl::StrFormat(
+      "No valid mutant of the sample found in %d attempts", max_attempts));
+}
+
 }  // namespace xls
@@ -15,6 +15,8 @@
 #ifndef XLS_FUZZER_SAMPLE_GENERATOR_H_
 #define XLS_FUZZER_SAMPLE_GENERATOR_H_
 
+#include <cstdint>
+
 #include "absl/random/bit_gen_ref.h"
 #include "absl/status/statusor.h"
 #include "xls/dslx/frontend/pos.h"
@@ -29,6 +31,15 @@ absl::StatusOr<Sample> GenerateSample(
     const SampleOptions& sample_options, absl::BitGenRef bit_gen,
     dslx::FileTable& file_table);
 
+// Returns a mutant of the function sample `sample` for coverage-guided
+// fuzzing: a random token is removed from its DSLX program, retrying up to
+// `max_attempts` times until the result typechecks with a `main` function, and
+// fresh arguments are generated for it. The sample's options are reused.
+// Returns a NotFound error if no attempt produced a valid program.
+absl::StatusOr<Sample> MutateSample(const Sample& sample,
+                                    absl::BitGenRef bit_gen,
+                                    int64_t max_attempts = 16);
+
 }  // namespace xls
 
 #endif  // XLS_FUZZER_SAMPLE_GENERATOR_H_
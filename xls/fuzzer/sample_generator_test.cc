@@ -82,6 +82,26 @@ TEST(SampleGeneratorTest, GenerateCodegenSample) {
   EXPECT_EQ(args_batch.size(), kCallsPerSample);
 }
 
+TEST(SampleGeneratorTest, MutateFunctionSample) {
+  dslx::FileTable file_table;
+  std::mt19937_64 rng;
+  SampleOptions sample_options;
+  constexpr int kCallsPerSample = 3;
+  sample_options.set_calls_per_sample(kCallsPerSample);
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Sample sample, GenerateSample(dslx::AstGeneratorOptions{}, sample_options,
+                                    rng, file_table));
+  XLS_ASSERT_OK_AND_ASSIGN(Sample mutant,
+                           MutateSample(sample, rng, /*max_attempts=*/64));
+  EXPECT_EQ(mutant.options(), sample.options());
+  EXPECT_LT(mutant.input_text().size(), sample.input_text().size());
+  EXPECT_THAT(mutant.input_text(), HasSubstr("fn main"));
+
+  std::vector<std::vector<dslx::InterpValue>> args_batch;
+  XLS_EXPECT_OK(mutant.GetArgsAndChannels(args_batch));
+  EXPECT_EQ(args_batch.size(), kCallsPerSample);
+}
+
 TEST(SampleGeneratorTest, GenerateChannelArgument) {
   std::mt19937_64 rng;
   std::vector<std::unique_ptr<dslx::Type>> param_types;
@@ -39,10 +39,13 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/ascii.h"
+#include "absl/strings/match.h"
+#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/strings/str_join.h"
 #include "absl/strings/str_split.h"
+#include "absl/strings/strip.h"
 #include "absl/time/time.h"
 #include "absl/types/span.h"
 #include "xls/common/file/filesystem.h"
@@ -64,6 +67,9 @@
 #include "xls/dslx/import_data.h"
 #include "xls/dslx/interp_value.h"
 #include "xls/dslx/interp_value_utils.h"
+#include "xls/dslx/ir_convert/conversion_info.h"
+#include "xls/dslx/ir_convert/convert_options.h"
+#include "xls/dslx/ir_convert/ir_converter.h"
 #include "xls/dslx/parse_and_typecheck.h"
 #include "xls/dslx/type_system/type.h"
 #include "xls/dslx/type_system/type_info.h"
@@ -72,13 +78,19 @@
 #include "xls/fuzzer/cpp_sample_runner.h"
 #include "xls/fuzzer/sample.h"
 #include "xls/fuzzer/sample.pb.h"
+#include "xls/interpreter/function_interpreter.h"
+#include "xls/ir/events.h"
 #include "xls/ir/format_preference.h"
+#include "xls/ir/function.h"
 #include "xls/ir/ir_parser.h"
+#include "xls/ir/package.h"
 #include "xls/ir/value.h"
+#include "xls/jit/function_jit.h"
 #include "xls/public/runtime_build_actions.h"
 #include "xls/simulation/check_simulator.h"
 #include "xls/tests/testvector.pb.h"
 #include "xls/tools/eval_utils.h"
+#include "xls/tools/opt.h"
 #include "re2/re2.h"
 
 // These are used to forward, but also see comment below.
@@ -102,6 +114,11 @@ static constexpr struct BinaryPaths {
 } kBinary;
 // clang-format on
 
+// Name of the file, within the run directory, holding the optimizer's pass
+// pipeline metrics.
+static constexpr std::string_view kPassMetricsFileName =
+    "sample.opt.pass_metrics.textproto";
+
 absl::StatusOr<ArgsBatch> ConvertFunctionKwargs(
     const dslx::Function* f, const dslx::ImportData& import_data,
     const dslx::TypecheckedModule& tm, const ArgsBatch& args_batch) {
@@ -259,6 +276,217 @@ SampleRunner::Commands::Callable CallableFromExecutable(
   };
 }
 
+// Returns `status` from an in-process tool invocation, or a FailedPrecondition
+// error if it matches one of the sample's known failures for `executable_name`.
+// This mirrors the stderr filtering performed by RunCommandFromExecutable.
+absl::Status FilterInProcessFailure(std::string_view executable_name,
+                                    const absl::Status& status,
+                                    const SampleOptions& options) {
+  if (status.ok()) {
+    return status;
+  }
+  const std::string basename =
+      std::filesystem::path(executable_name).filename();
+  for (const KnownFailure& filter : options.known_failures()) {
+    if ((filter.tool == nullptr || RE2::FullMatch(basename, *filter.tool)) &&
+        RE2::PartialMatch(status.message(), *filter.stderr_regex)) {
+      return absl::FailedPreconditionError(
+          absl::StrFormat("%s failed in-process but failure was suppressed "
+                          "due to stderr regexp: %s",
+                          basename, status.message()));
+    }
+  }
+  return status;
+}
+
+// Command-line arguments of a tool invocation split into `--name=value` flags
+// and positional arguments.
+struct ToolArgs {
+  absl::flat_hash_map<std::string, std::string> flags;
+  std::vector<std::filesystem::path> positional;
+
+  // Returns the value of the boolean flag `name` (or `default_value` if it was
+  // not given), or std::nullopt if the value is malformed.
+  std::optional<bool> GetBool(std::string_view name, bool default_value) const {
+    auto it = flags.find(name);
+    if (it == flags.end()) {
+      return default_value;
+    }
+    bool value;
+    if (!absl::SimpleAtob(it->second, &value)) {
+      return std::nullopt;
+    }
+    return value;
+  }
+};
+
+// Splits `args` into flags and positional arguments, resolving the latter
+// relative to `run_dir` (the working directory of the equivalent subprocess).
+// Boolean flags may be given as `--name` or `--noname`. Returns std::nullopt if
+// any flag is not in `supported_flags`, in which case the caller should defer
+// to the tool's binary.
+std::optional<ToolArgs> ParseToolArgs(
+    absl::Span<const std::string> args, const std::filesystem::path& run_dir,
+    absl::Span<const std::string_view> supported_flags) {
+  ToolArgs result;
+  for (std::string_view arg : args) {
+    if (!absl::ConsumePrefix(&arg, "--")) {
+      if (absl::StartsWith(arg, "-")) {
+        return std::nullopt;
+      }
+      result.positional.push_back(run_dir / arg);
+      continue;
+    }
+    std::string_view name = arg;
+    std::string_view value = "true";
+    if (size_t eq = arg.find('='); eq != std::string_view::npos) {
+      name = arg.substr(0, eq);
+      value = arg.substr(eq + 1);
+    } else if (absl::StartsWith(arg, "no") &&
+               absl::c_linear_search(supported_flags, arg.substr(2))) {
+      name = arg.substr(2);
+      value = "false";
+    }
+    if (!absl::c_linear_search(supported_flags, name)) {
+      return std::nullopt;
+    }
+    result.flags[std::string(name)] = std::string(value);
+  }
+  return result;
+}
+
+// In-process equivalent of ir_converter_main for the arguments passed by
+// DslxToIrFunction and DslxToIrProc.
+absl::StatusOr<std::string> ConvertDslxToIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  static constexpr std::string_view kSupportedFlags[] = {"top",
+                                                         "warnings_as_errors"};
+  std::optional<ToolArgs> tool_args =
+      ParseToolArgs(args, run_dir, kSupportedFlags);
+  std::optional<bool> warnings_as_errors =
+      tool_args.has_value() ? tool_args->GetBool("warnings_as_errors", true)
+                            : std::nullopt;
+  if (!tool_args.has_value() || tool_args->positional.size() != 1 ||
+      !warnings_as_errors.has_value()) {
+    return RunCommandFromExecutable(kBinary.ir_converter_main, args, run_dir,
+                                    options);
+  }
+
+  std::optional<std::string_view> top;
+  if (auto it = tool_args->flags.find("top"); it != tool_args->flags.end()) {
+    top = it->second;
+  }
+  const std::string input_path = tool_args->positional.front().string();
+  const std::vector<std::string_view> paths = {input_path};
+  const dslx::ConvertOptions convert_options = {
+      .warnings_as_errors = *warnings_as_errors,
+  };
+  absl::StatusOr<dslx::PackageConversionData> result =
+      dslx::ConvertFilesToPackage(paths, GetDefaultDslxStdlibPath(),
+                                  /*dslx_paths=*/{}, convert_options, top);
+  XLS_RETURN_IF_ERROR(FilterInProcessFailure(kBinary.ir_converter_main,
+                                             result.status(), options));
+  return result->DumpIr();
+}
+
+// In-process equivalent of opt_main for the arguments passed by OptimizeIr.
+absl::StatusOr<std::string> OptimizeIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  static constexpr std::string_view kSupportedFlags[] = {"pass_metrics_path"};
+  std::optional<ToolArgs> tool_args =
+      ParseToolArgs(args, run_dir, kSupportedFlags);
+  if (!tool_args.has_value() || tool_args->positional.size() != 1) {
+    return RunCommandFromExecutable(kBinary.ir_opt_main, args, run_dir,
+                                    options);
+  }
+
+  const std::filesystem::path& ir_path = tool_args->positional.front();
+  XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(ir_path));
+  tools::OptOptions opt_options = tools::OptMainDefaultOptions();
+  opt_options.ir_path = ir_path.string();
+  tools::OptMetadata metadata;
+  absl::StatusOr<std::string> opt_ir_text =
+      tools::OptimizeIrForTop(ir_text, opt_options, &metadata);
+  XLS_RETURN_IF_ERROR(FilterInProcessFailure(kBinary.ir_opt_main,
+                                             opt_ir_text.status(), options));
+  if (auto it = tool_args->flags.find("pass_metrics_path");
+      it != tool_args->flags.end()) {
+    XLS_RETURN_IF_ERROR(
+        SetTextProtoFile(run_dir / it->second, metadata.metrics));
+  }
+  return *std::move(opt_ir_text);
+}
+
+// Evaluates the top function of `ir_text` on each argument set of
+// `testvector`, returning one hex-formatted result per line as eval_ir_main
+// does.
+absl::StatusOr<std::string> EvaluateIrFunctionInProcess(
+    std::string_view ir_text, const std::filesystem::path& ir_path,
+    const testvector::SampleInputsProto& testvector, bool use_jit) {
+  if (!testvector.has_function_args()) {
+    return absl::InvalidArgumentError("Expected function_args in testvector");
+  }
+  XLS_ASSIGN_OR_RETURN(std::unique_ptr<Package> package,
+                       Parser::ParsePackage(ir_text, ir_path.string()));
+  XLS_ASSIGN_OR_RETURN(Function * f, package->GetTopAsFunction());
+  std::unique_ptr<FunctionJit> jit;
+  if (use_jit) {
+    XLS_ASSIGN_OR_RETURN(jit, FunctionJit::Create(f));
+  }
+
+  std::string results_text;
+  for (std::string_view arg_line : testvector.function_args().args()) {
+    std::vector<Value> args;
+    for (std::string_view value_string : absl::StrSplit(arg_line, ';')) {
+      XLS_ASSIGN_OR_RETURN(Value arg, Parser::ParseTypedValue(value_string));
+      args.push_back(std::move(arg));
+    }
+    Value result;
+    if (use_jit) {
+      XLS_ASSIGN_OR_RETURN(result, DropInterpreterEvents(jit->Run(args)));
+    } else {
+      XLS_ASSIGN_OR_RETURN(result,
+                           DropInterpreterEvents(InterpretFunction(f, args)));
+    }
+    absl::StrAppend(&results_text, result.ToString(FormatPreference::kHex),
+                    "\n");
+  }
+  return results_text;
+}
+
+// In-process equivalent of eval_ir_main for the arguments passed by
+// EvaluateIrFunction.
+absl::StatusOr<std::string> EvaluateIrInProcess(
+    const std::vector<std::string>& args, const std::filesystem::path& run_dir,
+    const SampleOptions& options) {
+  static constexpr std::string_view kSupportedFlags[] = {"testvector_textproto",
+                                                         "use_llvm_jit"};
+  std::optional<ToolArgs> tool_args =
+      ParseToolArgs(args, run_dir, kSupportedFlags);
+  std::optional<bool> use_jit =
+      tool_args.has_value() ? tool_args->GetBool("use_llvm_jit", true)
+                            : std::nullopt;
+  if (!tool_args.has_value() || tool_args->positional.size() != 1 ||
+      !tool_args->flags.contains("testvector_textproto") ||
+      !use_jit.has_value()) {
+    return RunCommandFromExecutable(kBinary.eval_ir_main, args, run_dir,
+                                    options);
+  }
+
+  const std::filesystem::path& ir_path = tool_args->positional.front();
+  XLS_ASSIGN_OR_RETURN(std::string ir_text, GetFileContents(ir_path));
+  testvector::SampleInputsProto testvector;
+  XLS_RETURN_IF_ERROR(ParseTextProtoFile(
+      run_dir / tool_args->flags.at("testvector_textproto"), &testvector));
+  absl::StatusOr<std::string> results_text =
+      EvaluateIrFunctionInProcess(ir_text, ir_path, testvector, *use_jit);
+  XLS_RETURN_IF_ERROR(FilterInProcessFailure(kBinary.eval_ir_main,
+                                             results_text.status(), options));
+  return *std::move(results_text);
+}
+
 // Runs the given command, returning the command's stdout if successful, and
 // attaching the command's stderr to the resulting status if not.
 absl::StatusOr<std::string> RunCommand(
@@ -391,20 +619,28 @@ absl::StatusOr<std::filesystem::path> Codegen(
   return verilog_path;
 }
 
-// Optimizes the IR file and returns the resulting filename.
+// Optimizes the IR file and returns the resulting filename. If
+// `collect_pass_metrics` is true, the optimizer's pass pipeline metrics are
+// also written to the run directory.
 absl::StatusOr<std::filesystem::path> OptimizeIr(
     const std::filesystem::path& ir_path, const SampleOptions& options,
     const std::filesystem::path& run_dir,
-    const SampleRunner::Commands& commands) {
+    const SampleRunner::Commands& commands, bool collect_pass_metrics) {
   std::optional<SampleRunner::Commands::Callable> command =
       commands.ir_opt_main;
   if (!command.has_value()) {
     command = CallableFromExecutable(kBinary.ir_opt_main);
   }
 
+  std::vector<std::string> args;
+  if (collect_pass_metrics) {
+    args.push_back(absl::StrCat("--pass_metrics_path=",
+                                (run_dir / kPassMetricsFileName).string()));
+  }
+  args.push_back(ir_path.string());
   XLS_ASSIGN_OR_RETURN(
       std::string opt_ir_text,
-      RunCommand("Optimizing IR", *command, {ir_path}, run_dir, options));
+      RunCommand("Optimizing IR", *command, args, run_dir, options));
   VLOG(3) << "Optimized IR:\n" << opt_ir_text;
   std::filesystem::path opt_ir_path = run_dir / "sample.opt.ir";
   XLS_RETURN_IF_ERROR(SetFileContents(opt_ir_path, opt_ir_text));
@@ -770,6 +1006,14 @@ SimulateProc(const std::filesystem::path& verilog_path,
 
 }  // namespace
 
+SampleRunner::Commands SampleRunner::InProcessCommands() {
+  return Commands{
+      .eval_ir_main = EvaluateIrInProcess,
+      .ir_converter_main = ConvertDslxToIrInProcess,
+      .ir_opt_main = OptimizeIrInProcess,
+  };
+}
+
 absl::StatusOr<CompletedSampleKind> SampleRunner::Run(const Sample& sample) {
   std::filesystem::path input_path = run_dir_;
 
@@ -909,7 +1153,8 @@ absl::Status SampleRunner::RunFunction(
   if (options.optimize_ir()) {
     Stopwatch t;
     XLS_ASSIGN_OR_RETURN(std::filesystem::path opt_ir_path,
-                         OptimizeIr(ir_path, options, run_dir_, commands_));
+                         OptimizeIr(ir_path, options, run_dir_, commands_,
+                                    collect_pass_metrics_));
     timing_.set_optimize_ns(absl::ToInt64Nanoseconds(t.GetElapsedTime()));
 
     if (args_batch.has_value()) {
@@ -1072,7 +1317,8 @@ absl::Status SampleRunner::RunProc(
   if (options.optimize_ir()) {
     Stopwatch t;
     XLS_ASSIGN_OR_RETURN(opt_ir_path,
-                         OptimizeIr(ir_path, options, run_dir_, commands_));
+                         OptimizeIr(ir_path, options, run_dir_, commands_,
+                                    collect_pass_metrics_));
     timing_.set_optimize_ns(absl::ToInt64Nanoseconds(t.GetElapsedTime()));
 
     if (args_batch.has_value()) {
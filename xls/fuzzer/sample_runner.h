@@ -71,6 +71,18 @@ class SampleRunner {
   SampleRunner(std::filesystem::path run_dir, Commands commands)
       : run_dir_(std::move(run_dir)), commands_(std::move(commands)) {}
 
+  // Returns commands which convert DSLX to IR, optimize IR and evaluate IR
+  // functions within the calling process rather than by launching the tool
+  // binaries, avoiding per-stage process startup costs. Codegen, simulation,
+  // and any invocation with arguments the in-process paths do not handle still
+  // run as subprocesses. A crash in an in-process stage takes down the caller.
+  static Commands InProcessCommands();
+
+  // If set, the optimizer also writes its pass pipeline metrics to
+  // `sample.opt.pass_metrics.textproto` in the run directory (as used for
+  // coverage-guided fuzzing).
+  void set_collect_pass_metrics(bool value) { collect_pass_metrics_ = value; }
+
   // Runs the provided sample, writing out files under the SampleRunner's
   // `run_dir` as appropriate.
   absl::StatusOr<CompletedSampleKind> Run(const Sample& sample);
@@ -96,6 +108,7 @@ class SampleRunner {
 
   const std::filesystem::path run_dir_;
   const Commands commands_;
+  bool collect_pass_metrics_ = false;
   fuzzer::SampleTimingProto timing_;
 };
 
@@ -537,6 +537,60 @@ TEST_F(SampleRunnerTest, InterpretOptIR) {
   EXPECT_THAT(absl::StrSplit(absl::StripAsciiWhitespace(opt_ir_results), "\n",
                              absl::SkipEmpty()),
               ElementsAre("bits[8]:0x8e"));
+  // Pass metrics are only collected on request.
+  EXPECT_TRUE(absl::IsNotFound(
+      FileExists(GetTempPath() / "sample.opt.pass_metrics.textproto")));
+}
+
+TEST_F(SampleRunnerTest, OptimizeIRCollectsPassMetrics) {
+  SampleRunner runner(GetTempPath());
+  runner.set_collect_pass_metrics(true);
+  constexpr std::string_view dslx_text =
+      "fn main(x: u8, y: u8) -> u8 { x + y }";
+  SampleOptions options;
+  options.set_input_is_dslx(true);
+  options.set_ir_converter_args({"--top=main"});
+  XLS_ASSERT_OK_AND_ASSIGN(ArgsBatch args_batch, ToArgsBatch({
+                                                     {
+                                                         "bits[8]:42",
+                                                         "bits[8]:100",
+                                                     },
+                                                 }));
+  XLS_ASSERT_OK(
+      runner.Run(Sample(std::string(dslx_text), options, args_batch)));
+  XLS_EXPECT_OK(
+      FileExists(GetTempPath() / "sample.opt.pass_metrics.textproto"));
+}
+
+TEST_F(SampleRunnerTest, InterpretOptIRInProcess) {
+  SampleRunner runner(GetTempPath(), SampleRunner::InProcessCommands());
+  constexpr std::string_view dslx_text =
+      "fn main(x: u8, y: u8) -> u8 { x + y }";
+  SampleOptions options;
+  options.set_input_is_dslx(true);
+  options.set_ir_converter_args({"--top=main"});
+  XLS_ASSERT_OK_AND_ASSIGN(ArgsBatch args_batch, ToArgsBatch({
+                                                     {
+                                                         "bits[8]:42",
+                                                         "bits[8]:100",
+                                                     },
+                                                 }));
+  XLS_ASSERT_OK(
+      runner.Run(Sample(std::string(dslx_text), options, args_batch)));
+  XLS_ASSERT_OK_AND_ASSIGN(std::string opt_ir,
+                           GetFileContents(GetTempPath() / "sample.opt.ir"));
+  EXPECT_THAT(opt_ir, HasSubstr("package sample"));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      std::string opt_ir_results,
+      GetFileContents(GetTempPath() / "sample.opt.ir.results"));
+  EXPECT_THAT(absl::StrSplit(absl::StripAsciiWhitespace(opt_ir_results), "\n",
+                             absl::SkipEmpty()),
+              ElementsAre("bits[8]:0x8e"));
+  // No tool binaries were launched for these stages.
+  EXPECT_TRUE(
+      absl::IsNotFound(FileExists(GetTempPath() / "opt_main.stderr")));
+  EXPECT_TRUE(
+      absl::IsNotFound(FileExists(GetTempPath() / "eval_ir_main.stderr")));
 }
 
 TEST_F(SampleRunnerTest, InterpretOptIRMiscompare) {
@@ -67,7 +67,7 @@ class BlockInterpreter final : public IrInterpreter {
         register_prefix_(register_prefix),
         reg_state_(reg_state),
         next_reg_state_(next_reg_state) {
-    NodeValuesMap().reserve(block->node_count());
+    NodeValuesMap().reserve(block->node_index_limit());
   }
 
   // Ports and InstantiationInputs/Outputs are handled by the
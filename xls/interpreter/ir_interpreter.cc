@@ -427,15 +427,15 @@ static absl::Status SetArrayElement(absl::Span<const Bits> indices,
   }
 
   // Index has multiple element. Peel off the first index and recurse into that
-  // element.
+  // element. Copying the elements only copies references to them, so the
+  // result shares all the elements which are not updated with the input.
   const Value& selected_element = (*elements)[index];
   std::vector<Value> subelements(selected_element.elements().begin(),
                                  selected_element.elements().end());
   XLS_RETURN_IF_ERROR(SetArrayElement(indices.subspan(1), value, &subelements));
   // Reconstruct the affected element as an array and assign it to the indexed
-  // slot.
-  XLS_ASSIGN_OR_RETURN(Value array_element, Value::Array(subelements));
-  (*elements)[index] = array_element;
+  // slot. The elements are known to have the same type as before.
+  (*elements)[index] = Value::ArrayOwned(std::move(subelements));
   return absl::OkStatus();
 }
 
@@ -482,8 +482,7 @@ absl::Status IrInterpreter::HandleArrayUpdate(ArrayUpdate* update) {
   }
   XLS_RETURN_IF_ERROR(
       SetArrayElement(index_vector, update_value, &array_elements));
-  XLS_ASSIGN_OR_RETURN(Value result, Value::Array(array_elements));
-  return SetValueResult(update, result);
+  return SetValueResult(update, Value::ArrayOwned(std::move(array_elements)));
 }
 
 absl::Status IrInterpreter::HandleArrayConcat(ArrayConcat* concat) {
@@ -19,7 +19,6 @@
 #include <optional>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
@@ -29,6 +28,7 @@
 #include "xls/ir/dfs_visitor.h"
 #include "xls/ir/events.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
@@ -64,7 +64,7 @@ class IrInterpreter : public DfsVisitor {
   // Constructor which takes an existing map of node values and events. Used for
   // continuations to enable stopping and restarting execution of a
   // FunctionBase.
-  IrInterpreter(absl::flat_hash_map<Node*, Value>* node_values,
+  IrInterpreter(NodeMap<Value>* node_values,
                 InterpreterEvents* events,
                 const EvaluatorOptions& options = EvaluatorOptions(),
                 std::optional<EvaluationObserver*> observer = std::nullopt,
@@ -77,7 +77,7 @@ class IrInterpreter : public DfsVisitor {
 
   // Sets the evaluated value for 'node' to the given Value. 'value' must be
   // passed in by value (ha!) because a use case is passing in a previously
-  // evaluated value and inserting a into flat_hash_map (done below) invalidates
+  // evaluated value and inserting a into the NodeMap (done below) invalidates
   // all references to Values in the map.
   absl::Status SetValueResult(Node* node, Value result);
 
@@ -221,10 +221,10 @@ class IrInterpreter : public DfsVisitor {
                                absl::Span<const Value* const> inputs);
 
   // Returns the map which maps Node* to the Value computed for that node.
-  absl::flat_hash_map<Node*, Value>& NodeValuesMap() {
+  NodeMap<Value>& NodeValuesMap() {
     return node_values_ptr_ != nullptr ? *node_values_ptr_ : node_values_;
   }
-  const absl::flat_hash_map<Node*, Value>& NodeValuesMap() const {
+  const NodeMap<Value>& NodeValuesMap() const {
     return node_values_ptr_ != nullptr ? *node_values_ptr_ : node_values_;
   }
 
@@ -232,8 +232,8 @@ class IrInterpreter : public DfsVisitor {
   // continuations, an existing map can either be passed in at construction time
   // (`node_values_ptr_` is not null), or a freshly constructed map is used
   // (`node_values_ptr` is null).
-  absl::flat_hash_map<Node*, Value>* node_values_ptr_;
-  absl::flat_hash_map<Node*, Value> node_values_;
+  NodeMap<Value>* node_values_ptr_;
+  NodeMap<Value> node_values_;
 
   // Events observed while interpreting (currently only trace messages). To
   // support continuations, an existing events object can either be passed in at
@@ -38,6 +38,7 @@
 #include "xls/ir/bits.h"
 #include "xls/ir/events.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/proc.h"
 #include "xls/ir/proc_elaboration.h"
@@ -101,8 +102,8 @@ class ProcInterpreterContinuation : public ProcContinuation {
   void SetNodeExecutionIndex(int64_t index) { node_index_ = index; }
 
   // Returns the map of node values computed in the tick so far.
-  absl::flat_hash_map<Node*, Value>& GetNodeValues() { return node_values_; }
-  const absl::flat_hash_map<Node*, Value>& GetNodeValues() const {
+  NodeMap<Value>& GetNodeValues() { return node_values_; }
+  const NodeMap<Value>& GetNodeValues() const {
     return node_values_;
   }
 
@@ -111,7 +112,7 @@ class ProcInterpreterContinuation : public ProcContinuation {
   std::vector<Value> state_;
 
   InterpreterEvents events_;
-  absl::flat_hash_map<Node*, Value> node_values_;
+  NodeMap<Value> node_values_;
   absl::flat_hash_map<StateElement*, std::vector<Next*>> active_next_values_;
 };
 
@@ -128,7 +129,7 @@ class ProcIrInterpreter : public IrInterpreter {
   //   events: events object to record events in (e.g, traces).
   //   queue_manager: manager for channel queues.
   ProcIrInterpreter(ProcInstance* proc_instance, absl::Span<const Value> state,
-                    absl::flat_hash_map<Node*, Value>* node_values,
+                    NodeMap<Value>* node_values,
                     InterpreterEvents* events,
                     ChannelQueueManager* queue_manager,
                     absl::flat_hash_map<StateElement*, std::vector<Next*>>*
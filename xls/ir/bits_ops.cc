@@ -25,6 +25,7 @@
 
 #include "absl/log/check.h"
 #include "absl/log/log.h"
+#include "absl/numeric/int128.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 #include "absl/types/span.h"
@@ -52,6 +53,103 @@ Bits TruncateOrSignExtend(Bits bits, int64_t bit_count) {
   return Truncate(std::move(bits), bit_count);
 }
 
+// Values which fit in one or two 64-bit words are operated on directly as
+// native integers, and wider values word-by-word, rather than through BigInt
+// or byte vectors.
+constexpr int64_t kWordBits = 64;
+
+// Returns the value of `bits`, which must be at most 64 bits wide.
+uint64_t SingleWord(const Bits& bits) { return bits.bitmap().GetWord(0); }
+
+// Returns the value of `bits`, which must be at most 64 bits wide, sign
+// extended to 64 bits.
+int64_t SignExtendedSingleWord(const Bits& bits) {
+  if (bits.bit_count() == 0) {
+    return 0;
+  }
+  const int64_t unused_bits = kWordBits - bits.bit_count();
+  return static_cast<int64_t>(SingleWord(bits) << unused_bits) >> unused_bits;
+}
+
+// Returns `word` truncated to `bit_count` bits, which must be at most 64.
+Bits FromSingleWord(uint64_t word, int64_t bit_count) {
+  return Bits::FromBitmap(InlineBitmap::FromWord(word, bit_count));
+}
+
+// Returns the value of `bits`, which must be at most 128 bits wide.
+absl::uint128 DoubleWord(const Bits& bits) {
+  const InlineBitmap& bitmap = bits.bitmap();
+  return absl::MakeUint128(bitmap.word_count() > 1 ? bitmap.GetWord(1) : 0,
+                           bitmap.GetWord(0));
+}
+
+// Returns `value` truncated to `bit_count` bits, which must be at most 128.
+Bits FromDoubleWord(absl::uint128 value, int64_t bit_count) {
+  InlineBitmap bitmap =
+      InlineBitmap::FromWord(absl::Uint128Low64(value), bit_count);
+  if (bitmap.word_count() > 1) {
+    bitmap.SetWord(1, absl::Uint128High64(value));
+  }
+  return Bits::FromBitmap(std::move(bitmap));
+}
+
+// Returns lhs + rhs, or lhs - rhs if `subtract` is true, modulo 2^bit_count
+// where both operands have the same bit count.
+Bits AddWords(const Bits& lhs, const Bits& rhs, bool subtract) {
+  const InlineBitmap& lhs_bitmap = lhs.bitmap();
+  const InlineBitmap& rhs_bitmap = rhs.bitmap();
+  InlineBitmap result(lhs.bit_count());
+  // Subtraction is lhs + ~rhs + 1.
+  uint64_t carry = subtract ? 1 : 0;
+  for (int64_t i = 0; i < result.word_count(); ++i) {
+    const uint64_t lhs_word = lhs_bitmap.GetWord(i);
+    const uint64_t rhs_word =
+        subtract ? ~rhs_bitmap.GetWord(i) : rhs_bitmap.GetWord(i);
+    uint64_t sum = lhs_word + rhs_word;
+    uint64_t carry_out = sum < lhs_word ? 1 : 0;
+    sum += carry;
+    carry_out |= sum < carry ? 1 : 0;
+    // SetWord drops the bits of the last word beyond the bit count.
+    result.SetWord(i, sum);
+    carry = carry_out;
+  }
+  return Bits::FromBitmap(std::move(result));
+}
+
+// Returns `bits` shifted right by `shift_amount` words and bits, filling the
+// vacated bits with the msb if `arithmetic` is true and with zeros otherwise.
+Bits ShiftRightWords(const Bits& bits, int64_t shift_amount, bool arithmetic) {
+  const InlineBitmap& bitmap = bits.bitmap();
+  const int64_t word_count = bitmap.word_count();
+  const bool fill = arithmetic && bits.bit_count() > 0 && bits.msb();
+  const uint64_t fill_word = fill ? ~uint64_t{0} : 0;
+  // The bits of the last word beyond the bit count are zero in the bitmap but
+  // are copies of the msb when shifting in from above.
+  const int64_t last_word_bits = bits.bit_count() % kWordBits;
+  const uint64_t last_word_fill =
+      fill && last_word_bits != 0 ? ~Mask(last_word_bits) : 0;
+  auto source_word = [&](int64_t wordno) -> uint64_t {
+    if (wordno < word_count - 1) {
+      return bitmap.GetWord(wordno);
+    }
+    if (wordno == word_count - 1) {
+      return bitmap.GetWord(wordno) | last_word_fill;
+    }
+    return fill_word;
+  };
+  const int64_t word_shift = shift_amount / kWordBits;
+  const int64_t bit_shift = shift_amount % kWordBits;
+  InlineBitmap result(bits.bit_count());
+  for (int64_t i = 0; i < word_count; ++i) {
+    uint64_t word = source_word(i + word_shift) >> bit_shift;
+    if (bit_shift != 0) {
+      word |= source_word(i + word_shift + 1) << (kWordBits - bit_shift);
+    }
+    result.SetWord(i, word);
+  }
+  return Bits::FromBitmap(std::move(result));
+}
+
 }  // namespace
 
 std::optional<int64_t> TryUnsignedBitsToInt64(const Bits& bits) {
@@ -69,15 +167,11 @@ int64_t UnsignedBitsToSaturatedInt64(const Bits& bits) {
 Bits And(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    return UBits(lhs.ToUint64().value() & rhs.ToUint64().value(),
-                 lhs.bit_count());
-  }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] & rhs_bytes[i];
+    return FromSingleWord(SingleWord(lhs) & SingleWord(rhs), lhs.bit_count());
   }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Intersect(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryAnd(absl::Span<const Bits> operands) {
@@ -91,17 +185,11 @@ Bits NaryAnd(absl::Span<const Bits> operands) {
 Bits Or(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    uint64_t lhs_int = lhs.ToUint64().value();
-    uint64_t rhs_int = rhs.ToUint64().value();
-    uint64_t result = (lhs_int | rhs_int);
-    return UBits(result, lhs.bit_count());
-  }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] | rhs_bytes[i];
+    return FromSingleWord(SingleWord(lhs) | SingleWord(rhs), lhs.bit_count());
   }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Union(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryOr(absl::Span<const Bits> operands) {
@@ -115,17 +203,11 @@ Bits NaryOr(absl::Span<const Bits> operands) {
 Bits Xor(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    uint64_t lhs_int = lhs.ToUint64().value();
-    uint64_t rhs_int = rhs.ToUint64().value();
-    uint64_t result = (lhs_int ^ rhs_int);
-    return UBits(result, lhs.bit_count());
-  }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = bytes[i] ^ rhs_bytes[i];
+    return FromSingleWord(SingleWord(lhs) ^ SingleWord(rhs), lhs.bit_count());
   }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.SymmetricDifference(rhs.bitmap());
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryXor(absl::Span<const Bits> operands) {
@@ -139,16 +221,13 @@ Bits NaryXor(absl::Span<const Bits> operands) {
 Bits Nand(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    return UBits(~(lhs.ToUint64().value() & rhs.ToUint64().value()) &
-                     Mask(lhs.bit_count()),
-                 lhs.bit_count());
+    return FromSingleWord(~(SingleWord(lhs) & SingleWord(rhs)),
+                          lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = ~(bytes[i] & rhs_bytes[i]);
-  }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Intersect(rhs.bitmap());
+  result.Complement();
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryNand(absl::Span<const Bits> operands) {
@@ -162,16 +241,13 @@ Bits NaryNand(absl::Span<const Bits> operands) {
 Bits Nor(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    return UBits(~(lhs.ToUint64().value() | rhs.ToUint64().value()) &
-                     Mask(lhs.bit_count()),
-                 lhs.bit_count());
+    return FromSingleWord(~(SingleWord(lhs) | SingleWord(rhs)),
+                          lhs.bit_count());
   }
-  std::vector<uint8_t> bytes = lhs.ToBytes();
-  std::vector<uint8_t> rhs_bytes = rhs.ToBytes();
-  for (int64_t i = 0; i < bytes.size(); ++i) {
-    bytes[i] = ~(bytes[i] | rhs_bytes[i]);
-  }
-  return Bits::FromBytes(bytes, lhs.bit_count());
+  InlineBitmap result = lhs.bitmap();
+  result.Union(rhs.bitmap());
+  result.Complement();
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits NaryNor(absl::Span<const Bits> operands) {
@@ -184,14 +260,11 @@ Bits NaryNor(absl::Span<const Bits> operands) {
 
 Bits Not(const Bits& bits) {
   if (bits.bit_count() <= 64) {
-    return UBits((~bits.ToUint64().value()) & Mask(bits.bit_count()),
-                 bits.bit_count());
+    return FromSingleWord(~SingleWord(bits), bits.bit_count());
   }
-  std::vector<uint8_t> bytes = bits.ToBytes();
-  for (uint8_t& byte : bytes) {
-    byte = ~byte;
-  }
-  return Bits::FromBytes(bytes, bits.bit_count());
+  InlineBitmap result = bits.bitmap();
+  result.Complement();
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits AndReduce(const Bits& operand) {
@@ -212,28 +285,23 @@ Bits XorReduce(const Bits& operand) {
 Bits Add(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    uint64_t lhs_int = lhs.ToUint64().value();
-    uint64_t rhs_int = rhs.ToUint64().value();
-    uint64_t result = (lhs_int + rhs_int) & Mask(lhs.bit_count());
-    return UBits(result, lhs.bit_count());
+    return FromSingleWord(SingleWord(lhs) + SingleWord(rhs), lhs.bit_count());
   }
-
-  Bits sum = BigInt::Add(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
-                 .ToSignedBits();
-  return TruncateOrSignExtend(std::move(sum), lhs.bit_count());
+  if (lhs.bit_count() <= 128) {
+    return FromDoubleWord(DoubleWord(lhs) + DoubleWord(rhs), lhs.bit_count());
+  }
+  return AddWords(lhs, rhs, /*subtract=*/false);
 }
 
 Bits Sub(const Bits& lhs, const Bits& rhs) {
   CHECK_EQ(lhs.bit_count(), rhs.bit_count());
   if (lhs.bit_count() <= 64) {
-    uint64_t lhs_int = lhs.ToUint64().value();
-    uint64_t rhs_int = rhs.ToUint64().value();
-    uint64_t result = (lhs_int - rhs_int) & Mask(lhs.bit_count());
-    return UBits(result, lhs.bit_count());
+    return FromSingleWord(SingleWord(lhs) - SingleWord(rhs), lhs.bit_count());
   }
-  Bits diff = BigInt::Sub(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
-                  .ToSignedBits();
-  return TruncateOrSignExtend(std::move(diff), lhs.bit_count());
+  if (lhs.bit_count() <= 128) {
+    return FromDoubleWord(DoubleWord(lhs) - DoubleWord(rhs), lhs.bit_count());
+  }
+  return AddWords(lhs, rhs, /*subtract=*/true);
 }
 
 Bits Increment(Bits x) {
@@ -265,10 +333,17 @@ Bits Decrement(Bits x) {
 Bits SMul(const Bits& lhs, const Bits& rhs) {
   const int64_t result_width = lhs.bit_count() + rhs.bit_count();
   if (result_width <= 64) {
-    int64_t lhs_int = lhs.ToInt64().value();
-    int64_t rhs_int = rhs.ToInt64().value();
-    int64_t result = lhs_int * rhs_int;
-    return SBits(result, result_width);
+    // The product of an n-bit and an m-bit value fits in n + m bits, so the
+    // (wrapping) unsigned product of the sign-extended operands is exact.
+    return FromSingleWord(
+        static_cast<uint64_t>(SignExtendedSingleWord(lhs)) *
+            static_cast<uint64_t>(SignExtendedSingleWord(rhs)),
+        result_width);
+  }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    absl::int128 product = absl::int128(SignExtendedSingleWord(lhs)) *
+                           absl::int128(SignExtendedSingleWord(rhs));
+    return FromDoubleWord(static_cast<absl::uint128>(product), result_width);
   }
 
   BigInt product =
@@ -279,10 +354,12 @@ Bits SMul(const Bits& lhs, const Bits& rhs) {
 Bits UMul(const Bits& lhs, const Bits& rhs) {
   const int64_t result_width = lhs.bit_count() + rhs.bit_count();
   if (result_width <= 64) {
-    uint64_t lhs_int = lhs.ToUint64().value();
-    uint64_t rhs_int = rhs.ToUint64().value();
-    uint64_t result = lhs_int * rhs_int;
-    return UBits(result, result_width);
+    return FromSingleWord(SingleWord(lhs) * SingleWord(rhs), result_width);
+  }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    return FromDoubleWord(
+        absl::uint128(SingleWord(lhs)) * absl::uint128(SingleWord(rhs)),
+        result_width);
   }
 
   BigInt product =
@@ -294,6 +371,9 @@ Bits UDiv(const Bits& lhs, const Bits& rhs) {
   if (rhs.IsZero()) {
     return Bits::AllOnes(lhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    return FromSingleWord(SingleWord(lhs) / SingleWord(rhs), lhs.bit_count());
+  }
   BigInt quotient =
       BigInt::Div(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs));
   return ZeroExtend(quotient.ToUnsignedBits(), lhs.bit_count());
@@ -303,6 +383,9 @@ Bits UMod(const Bits& lhs, const Bits& rhs) {
   if (rhs.IsZero()) {
     return Bits(rhs.bit_count());
   }
+  if (lhs.bit_count() <= 64 && rhs.bit_count() <= 64) {
+    return FromSingleWord(SingleWord(lhs) % SingleWord(rhs), rhs.bit_count());
+  }
   BigInt modulo =
       BigInt::Mod(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs));
   return ZeroExtend(modulo.ToUnsignedBits(), rhs.bit_count());
@@ -503,12 +586,14 @@ Bits Concat(absl::Span<const Bits> inputs) {
 }
 
 Bits Negate(const Bits& bits) {
-  if (bits.bit_count() < 64) {
-    return UBits((-bits.ToInt64().value()) & Mask(bits.bit_count()),
-                 bits.bit_count());
+  if (bits.bit_count() <= 64) {
+    return FromSingleWord(uint64_t{0} - SingleWord(bits), bits.bit_count());
   }
-  Bits negated = BigInt::Negate(BigInt::MakeSigned(bits)).ToSignedBits();
-  return TruncateOrSignExtend(std::move(negated), bits.bit_count());
+  if (bits.bit_count() <= 128) {
+    return FromDoubleWord(absl::uint128(0) - DoubleWord(bits),
+                          bits.bit_count());
+  }
+  return AddWords(Bits(bits.bit_count()), bits, /*subtract=*/true);
 }
 
 Bits Abs(const Bits& bits) {
@@ -517,24 +602,48 @@ Bits Abs(const Bits& bits) {
 
 Bits ShiftLeftLogical(const Bits& bits, int64_t shift_amount) {
   CHECK_GE(shift_amount, 0);
-  shift_amount = std::min(shift_amount, bits.bit_count());
-  return Concat(
-      {bits.Slice(0, bits.bit_count() - shift_amount), UBits(0, shift_amount)});
+  if (shift_amount >= bits.bit_count()) {
+    return Bits(bits.bit_count());
+  }
+  if (bits.bit_count() <= 64) {
+    return FromSingleWord(SingleWord(bits) << shift_amount, bits.bit_count());
+  }
+  const InlineBitmap& bitmap = bits.bitmap();
+  const int64_t word_shift = shift_amount / kWordBits;
+  const int64_t bit_shift = shift_amount % kWordBits;
+  InlineBitmap result(bits.bit_count());
+  for (int64_t i = word_shift; i < result.word_count(); ++i) {
+    uint64_t word = bitmap.GetWord(i - word_shift) << bit_shift;
+    if (bit_shift != 0 && i > word_shift) {
+      word |= bitmap.GetWord(i - word_shift - 1) >> (kWordBits - bit_shift);
+    }
+    result.SetWord(i, word);
+  }
+  return Bits::FromBitmap(std::move(result));
 }
 
 Bits ShiftRightLogical(const Bits& bits, int64_t shift_amount) {
   CHECK_GE(shift_amount, 0);
-  shift_amount = std::min(shift_amount, bits.bit_count());
-  return Concat({UBits(0, shift_amount),
-                 bits.Slice(shift_amount, bits.bit_count() - shift_amount)});
+  if (shift_amount >= bits.bit_count()) {
+    return Bits(bits.bit_count());
+  }
+  if (bits.bit_count() <= 64) {
+    return FromSingleWord(SingleWord(bits) >> shift_amount, bits.bit_count());
+  }
+  return ShiftRightWords(bits, shift_amount, /*arithmetic=*/false);
 }
 
 Bits ShiftRightArith(const Bits& bits, int64_t shift_amount) {
   CHECK_GE(shift_amount, 0);
   shift_amount = std::min(shift_amount, bits.bit_count());
-  return Concat(
-      {bits.msb() ? Bits::AllOnes(shift_amount) : UBits(0, shift_amount),
-       bits.Slice(shift_amount, bits.bit_count() - shift_amount)});
+  if (bits.bit_count() <= 64) {
+    // Shifting by 64 is undefined; shifting by 63 already fills the word.
+    return FromSingleWord(
+        static_cast<uint64_t>(SignExtendedSingleWord(bits) >>
+                              std::min<int64_t>(shift_amount, kWordBits - 1)),
+        bits.bit_count());
+  }
+  return ShiftRightWords(bits, shift_amount, /*arithmetic=*/true);
 }
 
 Bits OneHotLsbToMsb(const Bits& bits) {
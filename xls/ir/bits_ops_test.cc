@@ -14,6 +14,7 @@
 
 #include "xls/ir/bits_ops.h"
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <limits>
@@ -29,6 +30,7 @@
 #include "absl/strings/str_split.h"
 #include "xls/common/status/matchers.h"
 #include "xls/data_structures/inline_bitmap.h"
+#include "xls/ir/big_int.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/bits_test_utils.h"
 #include "xls/ir/format_preference.h"
@@ -1107,6 +1109,169 @@ TEST(BitsOpsTest, ToRawDigitsValue0x55U17) {
             "00055");
 }
 
+// Reference implementations in terms of BigInt, bit slices and single bits,
+// which the word-level kernels of bits_ops must match exactly.
+Bits ReferenceTruncateOrSignExtend(Bits bits, int64_t bit_count) {
+  if (bits.bit_count() < bit_count) {
+    return bits_ops::SignExtend(std::move(bits), bit_count);
+  }
+  return bits_ops::Truncate(std::move(bits), bit_count);
+}
+
+Bits ReferenceAdd(const Bits& lhs, const Bits& rhs) {
+  return ReferenceTruncateOrSignExtend(
+      BigInt::Add(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
+          .ToSignedBits(),
+      lhs.bit_count());
+}
+
+Bits ReferenceSub(const Bits& lhs, const Bits& rhs) {
+  return ReferenceTruncateOrSignExtend(
+      BigInt::Sub(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
+          .ToSignedBits(),
+      lhs.bit_count());
+}
+
+Bits ReferenceNegate(const Bits& bits) {
+  return ReferenceTruncateOrSignExtend(
+      BigInt::Negate(BigInt::MakeSigned(bits)).ToSignedBits(),
+      bits.bit_count());
+}
+
+Bits ReferenceUMul(const Bits& lhs, const Bits& rhs) {
+  return BigInt::Mul(BigInt::MakeUnsigned(lhs), BigInt::MakeUnsigned(rhs))
+      .ToUnsignedBitsWithBitCount(lhs.bit_count() + rhs.bit_count())
+      .value();
+}
+
+Bits ReferenceSMul(const Bits& lhs, const Bits& rhs) {
+  return BigInt::Mul(BigInt::MakeSigned(lhs), BigInt::MakeSigned(rhs))
+      .ToSignedBitsWithBitCount(lhs.bit_count() + rhs.bit_count())
+      .value();
+}
+
+template <typename F>
+Bits ReferenceBitwise(const Bits& lhs, const Bits& rhs, F f) {
+  InlineBitmap result(lhs.bit_count());
+  for (int64_t i = 0; i < lhs.bit_count(); ++i) {
+    result.Set(i, f(lhs.Get(i), rhs.Get(i)));
+  }
+  return Bits::FromBitmap(std::move(result));
+}
+
+Bits ReferenceShiftLeftLogical(const Bits& bits, int64_t shift_amount) {
+  shift_amount = std::min(shift_amount, bits.bit_count());
+  return bits_ops::Concat(
+      {bits.Slice(0, bits.bit_count() - shift_amount), UBits(0, shift_amount)});
+}
+
+Bits ReferenceShiftRightLogical(const Bits& bits, int64_t shift_amount) {
+  shift_amount = std::min(shift_amount, bits.bit_count());
+  return bits_ops::Concat(
+      {UBits(0, shift_amount),
+       bits.Slice(shift_amount, bits.bit_count() - shift_amount)});
+}
+
+Bits ReferenceShiftRightArith(const Bits& bits, int64_t shift_amount) {
+  shift_amount = std::min(shift_amount, bits.bit_count());
+  return bits_ops::Concat(
+      {bits.msb() ? Bits::AllOnes(shift_amount) : UBits(0, shift_amount),
+       bits.Slice(shift_amount, bits.bit_count() - shift_amount)});
+}
+
+void SameWidthOpsMatchReference(const Bits& lhs, const Bits& rhs) {
+  EXPECT_EQ(bits_ops::Add(lhs, rhs), ReferenceAdd(lhs, rhs));
+  EXPECT_EQ(bits_ops::Sub(lhs, rhs), ReferenceSub(lhs, rhs));
+  EXPECT_EQ(bits_ops::And(lhs, rhs),
+            ReferenceBitwise(lhs, rhs, [](bool a, bool b) { return a && b; }));
+  EXPECT_EQ(bits_ops::Or(lhs, rhs),
+            ReferenceBitwise(lhs, rhs, [](bool a, bool b) { return a || b; }));
+  EXPECT_EQ(bits_ops::Xor(lhs, rhs),
+            ReferenceBitwise(lhs, rhs, [](bool a, bool b) { return a != b; }));
+  EXPECT_EQ(
+      bits_ops::Nand(lhs, rhs),
+      ReferenceBitwise(lhs, rhs, [](bool a, bool b) { return !(a && b); }));
+  EXPECT_EQ(
+      bits_ops::Nor(lhs, rhs),
+      ReferenceBitwise(lhs, rhs, [](bool a, bool b) { return !(a || b); }));
+  if (!rhs.IsZero()) {
+    EXPECT_EQ(bits_ops::UDiv(lhs, rhs),
+              bits_ops::ZeroExtend(
+                  BigInt::Div(BigInt::MakeUnsigned(lhs),
+                              BigInt::MakeUnsigned(rhs))
+                      .ToUnsignedBits(),
+                  lhs.bit_count()));
+    EXPECT_EQ(bits_ops::UMod(lhs, rhs),
+              bits_ops::ZeroExtend(
+                  BigInt::Mod(BigInt::MakeUnsigned(lhs),
+                              BigInt::MakeUnsigned(rhs))
+                      .ToUnsignedBits(),
+                  rhs.bit_count()));
+  }
+}
+
+void MulMatchesReference(const Bits& lhs, const Bits& rhs) {
+  EXPECT_EQ(bits_ops::UMul(lhs, rhs), ReferenceUMul(lhs, rhs));
+  EXPECT_EQ(bits_ops::SMul(lhs, rhs), ReferenceSMul(lhs, rhs));
+}
+
+void UnaryOpsMatchReference(const Bits& bits, int64_t shift_amount) {
+  EXPECT_EQ(bits_ops::Negate(bits), ReferenceNegate(bits));
+  EXPECT_EQ(bits_ops::Not(bits),
+            ReferenceBitwise(bits, bits, [](bool a, bool) { return !a; }));
+  EXPECT_EQ(bits_ops::ShiftLeftLogical(bits, shift_amount),
+            ReferenceShiftLeftLogical(bits, shift_amount));
+  EXPECT_EQ(bits_ops::ShiftRightLogical(bits, shift_amount),
+            ReferenceShiftRightLogical(bits, shift_amount));
+  EXPECT_EQ(bits_ops::ShiftRightArith(bits, shift_amount),
+            ReferenceShiftRightArith(bits, shift_amount));
+}
+
+TEST(BitsOpsTest, WordKernelsMatchReferenceAtWordBoundaries) {
+  for (int64_t bit_count : {0, 1, 7, 32, 63, 64, 65, 100, 127, 128, 129, 191,
+                            192, 193, 300}) {
+    std::vector<Bits> values = {Bits(bit_count), Bits::AllOnes(bit_count),
+                                PrimeBits(bit_count)};
+    if (bit_count > 0) {
+      values.push_back(Bits::MinSigned(bit_count));
+      values.push_back(Bits::MaxSigned(bit_count));
+      values.push_back(Bits::PowerOfTwo(bit_count / 2, bit_count));
+    }
+    for (const Bits& lhs : values) {
+      for (const Bits& rhs : values) {
+        SameWidthOpsMatchReference(lhs, rhs);
+        MulMatchesReference(lhs, rhs);
+        MulMatchesReference(lhs, bits_ops::Truncate(rhs, rhs.bit_count() / 2));
+      }
+      for (int64_t shift_amount :
+           {int64_t{0}, int64_t{1}, bit_count / 2, bit_count - 1, bit_count,
+            bit_count + 1, int64_t{64}, int64_t{65}, int64_t{128}}) {
+        if (shift_amount >= 0) {
+          UnaryOpsMatchReference(lhs, shift_amount);
+        }
+      }
+    }
+  }
+}
+
+// Returns the bytes as a Bits with the same bit count as `like`.
+Bits BitsWithWidthOf(std::vector<uint8_t> bytes, const Bits& like) {
+  bytes.resize((like.bit_count() + 7) / 8);
+  return Bits::FromBytes(bytes, like.bit_count());
+}
+
+void SameWidthOpsMatchReferenceFuzz(const Bits& lhs,
+                                    std::vector<uint8_t> rhs_bytes) {
+  SameWidthOpsMatchReference(lhs,
+                             BitsWithWidthOf(std::move(rhs_bytes), lhs));
+}
+FUZZ_TEST(BitsOpsFuzzTest, SameWidthOpsMatchReferenceFuzz)
+    .WithDomains(ArbitraryBits(), fuzztest::Arbitrary<std::vector<uint8_t>>());
+FUZZ_TEST(BitsOpsFuzzTest, MulMatchesReference)
+    .WithDomains(ArbitraryBits(), ArbitraryBits());
+FUZZ_TEST(BitsOpsFuzzTest, UnaryOpsMatchReference)
+    .WithDomains(ArbitraryBits(), fuzztest::InRange<int64_t>(0, 1024));
+
 void BM_Increment(benchmark::State& state) {
   Bits f = Bits::AllOnes(state.range(0));
   for (auto _ : state) {
@@ -1228,5 +1393,74 @@ void BM_ZeroExtendMove(benchmark::State& state) {
 }
 BENCHMARK(BM_ZeroExtendMove)->Range(33, 1 << 20);
 
+// Benchmarks of the single-word (<= 64 bits), double-word (<= 128 bits) and
+// multi-word kernels. Widths are chosen to straddle the word boundaries.
+void WordBoundaryWidths(benchmark::internal::Benchmark* b) {
+  for (int64_t bit_count : {8, 32, 64, 65, 100, 128, 129, 256, 1024, 8192}) {
+    b->Arg(bit_count);
+  }
+}
+
+template <Bits (*kOp)(const Bits&, const Bits&)>
+void BM_BinaryOp(benchmark::State& state) {
+  Bits lhs = PrimeBits(state.range(0));
+  Bits rhs = Bits::AllOnes(state.range(0));
+  for (auto _ : state) {
+    auto v = kOp(lhs, rhs);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_BinaryOp<bits_ops::Add>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_BinaryOp<bits_ops::Sub>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_BinaryOp<bits_ops::And>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_BinaryOp<bits_ops::Xor>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_BinaryOp<bits_ops::Nor>)->Apply(WordBoundaryWidths);
+
+// Multiplies two operands of half the given width each so the product has the
+// given width.
+template <Bits (*kOp)(const Bits&, const Bits&)>
+void BM_Mul(benchmark::State& state) {
+  Bits lhs = PrimeBits(state.range(0) / 2);
+  Bits rhs = Bits::AllOnes(state.range(0) / 2);
+  for (auto _ : state) {
+    auto v = kOp(lhs, rhs);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_Mul<bits_ops::UMul>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_Mul<bits_ops::SMul>)->Apply(WordBoundaryWidths);
+
+void BM_Negate(benchmark::State& state) {
+  Bits bits = PrimeBits(state.range(0));
+  for (auto _ : state) {
+    auto v = bits_ops::Negate(bits);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_Negate)->Apply(WordBoundaryWidths);
+
+void BM_Not(benchmark::State& state) {
+  Bits bits = PrimeBits(state.range(0));
+  for (auto _ : state) {
+    auto v = bits_ops::Not(bits);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_Not)->Apply(WordBoundaryWidths);
+
+template <Bits (*kOp)(const Bits&, int64_t)>
+void BM_Shift(benchmark::State& state) {
+  Bits bits = Bits::AllOnes(state.range(0));
+  // Shift by a non-multiple of the word size to exercise the cross-word path.
+  const int64_t shift_amount = state.range(0) / 3;
+  for (auto _ : state) {
+    auto v = kOp(bits, shift_amount);
+    benchmark::DoNotOptimize(v);
+  }
+}
+BENCHMARK(BM_Shift<bits_ops::ShiftLeftLogical>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_Shift<bits_ops::ShiftRightLogical>)->Apply(WordBoundaryWidths);
+BENCHMARK(BM_Shift<bits_ops::ShiftRightArith>)->Apply(WordBoundaryWidths);
+
 }  // namespace
 }  // namespace xls
@@ -16,13 +16,17 @@
 #define XLS_IR_CHANGE_LISTENER_H_
 
 #include <cstdint>
+#include <optional>
+#include <string_view>
 
 #include "absl/types/span.h"
 
 namespace xls {
 
 class Function;
+class FunctionBase;
 class Node;
+class Param;
 class Proc;
 
 // A pure-virtual interface for listening to changes to XLS IR.
@@ -48,6 +52,20 @@ class ChangeListener {
   // last operand in the list).
   virtual void OperandAdded(Node* node) {}
 
+  // Called when `node`'s assigned name changed. `old_name` is the previously
+  // assigned name, or nullopt if the node had none.
+  virtual void NodeRenamed(Node* node,
+                           std::optional<std::string_view> old_name) {}
+
+  // Called when a property of `node` other than its operands and name was
+  // changed in place, e.g., the channel of a send or the label of an assert.
+  virtual void NodeAttributeChanged(Node* node) {}
+
+  // Called when `param` was moved from position `old_index` in the parameter
+  // list of `function_base`.
+  virtual void ParamMoved(FunctionBase* function_base, Param* param,
+                          int64_t old_index) {}
+
   virtual void ReturnValueChanged(Function* function_base,
                                   Node* old_return_value) {}
   virtual void NextStateElementChanged(Proc* proc, int64_t state_index,
@@ -17,9 +17,9 @@
 
 #include <cstdint>
 
-#include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 
 namespace xls {
@@ -144,10 +144,10 @@ class DfsVisitor {
 
  private:
   // Set of nodes which have been visited.
-  absl::flat_hash_set<Node*> visited_;
+  NodeSet visited_;
 
   // Set of nodes which are being traversed through.
-  absl::flat_hash_set<Node*> traversing_;
+  NodeSet traversing_;
 };
 
 // Visitor with a default action. If the Handle<Op> method is not overridden
@@ -107,8 +107,12 @@ absl::Status FunctionBase::MoveParamToIndex(Param* param, int64_t index) {
         "Given param is not a member of this function base: " +
         param->ToString());
   }
+  int64_t old_index = std::distance(params_.begin(), it);
   params_.erase(it);
   params_.insert(params_.begin() + index, param);
+  for (ChangeListener* listener : change_listeners_) {
+    listener->ParamMoved(this, param, old_index);
+  }
   return absl::OkStatus();
 }
 
@@ -160,7 +164,10 @@ absl::Status FunctionBase::RemoveNode(Node* node) {
   for (Node* operand : unique_operands) {
     operand->RemoveUser(node);
   }
+  int64_t side_table_index = -1;
   if (node->Is<Param>()) {
+    side_table_index = std::distance(
+        params_.begin(), std::find(params_.begin(), params_.end(), node));
     params_.erase(std::remove(params_.begin(), params_.end(), node),
                   params_.end());
   }
@@ -173,15 +180,64 @@ absl::Status FunctionBase::RemoveNode(Node* node) {
       StateRead* state_read = next->state_read()->As<StateRead>();
       next_values_by_state_read_.at(state_read).erase(next);
     }
+    side_table_index = std::distance(
+        next_values_.begin(),
+        std::find(next_values_.begin(), next_values_.end(), next));
     std::erase(next_values_, next);
   }
   for (ChangeListener* listener : change_listeners_) {
     listener->NodeDeleted(node);
   }
-  auto node_it = node_iterators_.find(node);
-  XLS_RET_CHECK(node_it != node_iterators_.end());
-  nodes_.erase(node_it->second);
-  node_iterators_.erase(node_it);
+  const int64_t node_index = node->node_index();
+  XLS_RET_CHECK(node->function_base() == this && node_index >= 0)
+      << node->GetName();
+  NodeList::iterator node_list_it = node_iterators_[node_index];
+  if (removed_node_sink_ != nullptr) {
+    NodeList::iterator successor_it = std::next(node_list_it);
+    Node* successor =
+        successor_it == nodes_.end() ? nullptr : successor_it->get();
+    removed_node_sink_->push_back(
+        RemovedNode{.node = std::move(*node_list_it),
+                    .successor = successor,
+                    .side_table_index = side_table_index});
+  }
+  nodes_.erase(node_list_it);
+  free_node_indices_.push_back(node_index);
+  return absl::OkStatus();
+}
+
+absl::Status FunctionBase::RestoreRemovedNode(RemovedNode removed) {
+  Node* node = removed.node.get();
+  XLS_RET_CHECK_EQ(node->function_base(), this);
+  XLS_RET_CHECK(!node->Is<StateRead>())
+      << "State reads cannot be restored: " << node->GetName();
+  VLOG(4) << absl::StrFormat("Restoring node to FunctionBase %s: %s", name(),
+                             node->ToString());
+  if (node->Is<Param>()) {
+    XLS_RET_CHECK_LE(removed.side_table_index, params_.size());
+    params_.insert(params_.begin() + removed.side_table_index,
+                   node->As<Param>());
+  }
+  if (node->Is<Next>()) {
+    Next* next = node->As<Next>();
+    XLS_RET_CHECK_LE(removed.side_table_index, next_values_.size());
+    next_values_.insert(next_values_.begin() + removed.side_table_index, next);
+    if (next->state_read()->Is<StateRead>()) {
+      next_values_by_state_read_.at(next->state_read()->As<StateRead>())
+          .insert(next);
+    }
+  }
+  for (Node* operand : node->operands()) {
+    operand->AddUser(node);
+  }
+  NodeList::iterator position =
+      removed.successor == nullptr
+          ? nodes_.end()
+          : node_iterators_[removed.successor->node_index()];
+  AssignNodeIndex(nodes_.insert(position, std::move(removed.node)));
+  for (ChangeListener* listener : change_listeners_) {
+    listener->NodeAdded(node);
+  }
   return absl::OkStatus();
 }
 
@@ -259,13 +315,25 @@ Node* FunctionBase::AddNodeInternal(std::unique_ptr<Node> node) {
     next_values_by_state_read_.at(state_read).insert(next);
   }
   Node* ptr = node.get();
-  node_iterators_[ptr] = nodes_.insert(nodes_.end(), std::move(node));
+  AssignNodeIndex(nodes_.insert(nodes_.end(), std::move(node)));
   for (ChangeListener* listener : change_listeners_) {
     listener->NodeAdded(ptr);
   }
   return ptr;
 }
 
+void FunctionBase::AssignNodeIndex(NodeList::iterator node_it) {
+  Node* node = node_it->get();
+  if (free_node_indices_.empty()) {
+    node->node_index_ = node_iterators_.size();
+    node_iterators_.push_back(node_it);
+  } else {
+    node->node_index_ = free_node_indices_.back();
+    free_node_indices_.pop_back();
+    node_iterators_[node->node_index_] = node_it;
+  }
+}
+
 /* static */ std::vector<std::string> FunctionBase::GetIrReservedWords() {
   std::vector<std::string> words(Token::GetKeywords().begin(),
                                  Token::GetKeywords().end());
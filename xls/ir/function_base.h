@@ -115,6 +115,11 @@ class FunctionBase {
 
   int64_t node_count() const { return nodes_.size(); }
 
+  // Returns one past the largest node index (Node::node_index) of any node
+  // which has been added to this function base. Indices of removed nodes are
+  // reused so this stays close to node_count().
+  int64_t node_index_limit() const { return node_iterators_.size(); }
+
   // Expose Nodes, so that transformation passes can operate
   // on this function.
   xabsl::iterator_range<UnwrappingIterator<NodeList::iterator>> nodes() {
@@ -233,6 +238,30 @@ class FunctionBase {
     std::erase(change_listeners_, listener);
   }
 
+  // A node which was removed from the function base while removed nodes were
+  // being retained (see PackageCheckpoint), along with what is needed to put
+  // it back where it was.
+  struct RemovedNode {
+    std::unique_ptr<Node> node;
+    // The node which followed the removed node in the node list, or nullptr if
+    // it was the last node.
+    Node* successor;
+    // The position of the node in params() or next_values(), if it is a param
+    // or next value node.
+    int64_t side_table_index;
+  };
+
+  // While `sink` is non-null, nodes removed by RemoveNode are moved into it
+  // rather than destroyed.
+  void SetRemovedNodeSink(std::vector<RemovedNode>* sink) {
+    removed_node_sink_ = sink;
+  }
+
+  // Puts a node retained by SetRemovedNodeSink back into the function base.
+  // The function base must otherwise be in the state it was in just after
+  // the node was removed.
+  absl::Status RestoreRemovedNode(RemovedNode removed);
+
   template <typename Sink>
   friend void AbslStringify(Sink& sink, const FunctionBase& fb) {
     absl::Format(&sink, "%s", fb.name());
@@ -271,6 +300,9 @@ class FunctionBase {
   // added node.
   virtual Node* AddNodeInternal(std::unique_ptr<Node> node);
 
+  // Assigns a node index to the node at `node_it` in the node list.
+  void AssignNodeIndex(NodeList::iterator node_it);
+
   // Returns a vector containing the reserved words in the IR.
   static std::vector<std::string> GetIrReservedWords();
 
@@ -279,10 +311,12 @@ class FunctionBase {
   std::optional<int64_t> initiation_interval_;
 
   // Store Nodes in std::list as they can be added and removed arbitrarily and
-  // we want a stable iteration order. Keep a map from instruction pointer to
-  // location in the list for fast lookup.
+  // we want a stable iteration order. Keep a vector indexed by node index
+  // holding the location of each node in the list for fast lookup, and the
+  // indices of removed nodes for reuse.
   NodeList nodes_;
-  absl::flat_hash_map<const Node*, NodeList::iterator> node_iterators_;
+  std::vector<NodeList::iterator> node_iterators_;
+  std::vector<int64_t> free_node_indices_;
 
   std::vector<Param*> params_;
   std::vector<Next*> next_values_;
@@ -295,6 +329,8 @@ class FunctionBase {
   std::optional<xls::ForeignFunctionData> foreign_function_;
 
   std::vector<ChangeListener*> change_listeners_;
+
+  std::vector<RemovedNode>* removed_node_sink_ = nullptr;
 };
 
 inline absl::Span<ChangeListener* const> GetChangeListeners(
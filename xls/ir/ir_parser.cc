@@ -81,7 +81,7 @@ absl::Status Parser::ParseKeywordArguments(
     XLS_ASSIGN_OR_RETURN(Token name,
                          scanner_.PopKeywordOrIdentToken("argument"));
     XLS_RETURN_IF_ERROR(scanner_.DropTokenOrError(LexicalTokenType::kEquals));
-    if (!seen_keywords.insert(name.value()).second) {
+    if (!seen_keywords.insert(std::string(name.value())).second) {
       return absl::InvalidArgumentError(
           absl::StrFormat("Duplicate keyword argument `%s` @ %s", name.value(),
                           name.pos().ToHumanString()));
@@ -143,8 +143,10 @@ absl::StatusOr<std::vector<Parser::TypedArgument>> Parser::ParseTypedArguments(
               name.pos().ToHumanString()));
         }
       }
-      args.push_back(TypedArgument{
-          .name = name.value(), .type = type, .id = id, .token = name});
+      args.push_back(TypedArgument{.name = std::string(name.value()),
+                                   .type = type,
+                                   .id = id,
+                                   .token = name});
     } while (scanner_.TryDropToken(LexicalTokenType::kComma));
   }
   return args;
@@ -413,7 +415,7 @@ absl::StatusOr<std::string> Parser::ParseIdentifier(TokenPos* pos) {
   if (pos != nullptr) {
     *pos = token.pos();
   }
-  return token.value();
+  return std::string(token.value());
 }
 
 absl::StatusOr<std::string> Parser::ParseQuotedString(TokenPos* pos) {
@@ -422,7 +424,7 @@ absl::StatusOr<std::string> Parser::ParseQuotedString(TokenPos* pos) {
   if (pos != nullptr) {
     *pos = token.pos();
   }
-  return token.value();
+  return std::string(token.value());
 }
 
 absl::StatusOr<BValue> Parser::ParseAndResolveIdentifier(
@@ -738,7 +740,8 @@ absl::StatusOr<BValue> Parser::ParseNode(
   // should be given when constructing the node as the name is autogenerated
   // (the node has no meaningful given name). Otherwise, output_name is the
   // name of the node.
-  std::string node_name = split_name.has_value() ? "" : output_name.value();
+  std::string node_name =
+      split_name.has_value() ? "" : std::string(output_name.value());
 
   std::vector<BValue> operands;
   switch (op) {
@@ -1365,7 +1368,7 @@ absl::StatusOr<BValue> Parser::ParseNode(
                         output_name.value(), op_token.pos().ToHumanString()));
   }
 
-  (*name_to_value)[output_name.value()] = bvalue;
+  (*name_to_value)[std::string(output_name.value())] = bvalue;
 
   if (bvalue.valid()) {
     Node* node = bvalue.node();
@@ -1478,7 +1481,7 @@ absl::StatusOr<ProcInstantiation*> Parser::ParseProcInstantiation(Proc* proc) {
     XLS_ASSIGN_OR_RETURN(Token channel_name,
                          scanner_.PopTokenOrError(LexicalTokenType::kIdent,
                                                   "channel reference name"));
-    channel_arg_names.push_back(channel_name.value());
+    channel_arg_names.push_back(std::string(channel_name.value()));
   } while (scanner_.TryDropToken(LexicalTokenType::kComma));
 
   // Then parse keyword arguments.
@@ -1627,7 +1630,7 @@ absl::StatusOr<Instantiation*> Parser::ParseInstantiation(Block* block) {
   handlers["channel"] = [&]() -> absl::Status {
     XLS_ASSIGN_OR_RETURN(Token channel_token,
                          scanner_.PopTokenOrError(LexicalTokenType::kIdent));
-    channel = channel_token.value();
+    channel = std::string(channel_token.value());
     return absl::OkStatus();
   };
 
@@ -1985,7 +1988,7 @@ absl::StatusOr<std::unique_ptr<ProcBuilder>> Parser::ParseProcSignature(
         }
 
         channel_interfaces.push_back(
-            ChannelInterfaceArg{.name = channel_name.value(),
+            ChannelInterfaceArg{.name = std::string(channel_name.value()),
                                 .type = type,
                                 .direction = direction});
       } while (scanner_.TryDropToken(LexicalTokenType::kComma));
@@ -2111,7 +2114,7 @@ absl::StatusOr<Parser::BlockSignature> Parser::ParseBlockSignature(
     if (!scanner_.TryDropKeyword("clock")) {
       XLS_ASSIGN_OR_RETURN(type, ParseType(package));
     }
-    signature.ports.push_back(Port{port_name.value(), type});
+    signature.ports.push_back(Port{std::string(port_name.value()), type});
     must_end = !scanner_.TryDropToken(LexicalTokenType::kComma);
   }
 
@@ -2126,7 +2129,7 @@ absl::StatusOr<std::string> Parser::ParsePackageName() {
   XLS_ASSIGN_OR_RETURN(
       Token package_name,
       scanner_.PopTokenOrError(LexicalTokenType::kIdent, "package name"));
-  return package_name.value();
+  return std::string(package_name.value());
 }
 
 absl::Status Parser::ParseFileNumber(
@@ -2776,7 +2779,7 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
     XLS_ASSIGN_OR_RETURN(int64_t value, ParseInt64());
     XLS_RETURN_IF_ERROR(
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
-    return IrAttribute{.name = attribute_name.value(),
+    return IrAttribute{.name = std::string(attribute_name.value()),
                        .payload = InitiationInterval{.value = value}};
   }
   if (attribute_name.value() == "ffi_proto") {
@@ -2790,7 +2793,8 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
     }
     XLS_RETURN_IF_ERROR(
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
-    return IrAttribute{.name = attribute_name.value(), .payload = ffi};
+    return IrAttribute{.name = std::string(attribute_name.value()),
+                       .payload = ffi};
   }
   if (attribute_name.value() == "channel_ports") {
     std::optional<std::string> channel_name;
@@ -2857,7 +2861,7 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
     XLS_RETURN_IF_ERROR(
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
 
-    return IrAttribute{.name = attribute_name.value(),
+    return IrAttribute{.name = std::string(attribute_name.value()),
                        .payload = ChannelPortMetadata{
                            .channel_name = channel_name.value(),
                            .type = type.value(),
@@ -2895,7 +2899,7 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
 
     return IrAttribute{
-        .name = attribute_name.value(),
+        .name = std::string(attribute_name.value()),
         .payload = ResetAttribute{
             .port_name = port.value(),
             .behavior = ResetBehavior{.asynchronous = asynchronous.value(),
@@ -2929,7 +2933,7 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
 
     return IrAttribute{
-        .name = attribute_name.value(),
+        .name = std::string(attribute_name.value()),
         .payload = BlockProvenance{.name = name.value(), .kind = kind.value()}};
   }
   if (attribute_name.value() == "signature") {
@@ -2945,7 +2949,8 @@ absl::StatusOr<IrAttribute> Parser::ParseAttribute(Package* package) {
     }
     XLS_RETURN_IF_ERROR(
         scanner_.DropTokenOrError(LexicalTokenType::kParenClose));
-    return IrAttribute{.name = attribute_name.value(), .payload = proto};
+    return IrAttribute{.name = std::string(attribute_name.value()),
+                       .payload = proto};
   }
   return absl::InvalidArgumentError(
       absl::StrCat("Unknown attribute: ", attribute_name.value()));
@@ -16,7 +16,7 @@
 
 #include <cctype>
 #include <cstdint>
-#include <functional>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -226,8 +226,8 @@ class Tokenizer {
   // starting at the current index. Current index is updated to one past the
   // last matching character. min_chars is the minimum number of characters
   // which are unconditionally captured.
-  std::string_view CaptureWhile(std::function<bool(char)> test_f,
-                                int64_t min_chars = 0) {
+  template <typename Predicate>
+  std::string_view CaptureWhile(Predicate test_f, int64_t min_chars = 0) {
     int64_t start = index();
     while (!EndOfString() &&
            ((index() < min_chars + start) || test_f(current()))) {
@@ -239,6 +239,9 @@ class Tokenizer {
   // Tokenizes the internal string.
   absl::StatusOr<std::vector<Token>> Tokenize() {
     std::vector<Token> tokens;
+    // IR text averages a few characters per token; reserving up front avoids
+    // repeatedly reallocating (and moving) the token vector for large inputs.
+    tokens.reserve(str_.size() / kCharsPerTokenEstimate);
     while (!EndOfString()) {
       if (DropWhiteSpace() || DropEndOfLineComment()) {
         continue;
@@ -257,8 +260,8 @@ class Tokenizer {
         std::string_view value = CaptureWhile(
             [](char c) { return absl::ascii_isalnum(c) || c == '_'; },
             /*min_chars=*/1);
-        tokens.push_back(Token(LexicalTokenType::kLiteral, value, start_lineno,
-                               start_colno));
+        tokens.emplace_back(LexicalTokenType::kLiteral, value, start_lineno,
+                            start_colno);
         continue;
       }
 
@@ -273,8 +276,8 @@ class Tokenizer {
 
       // Look for multi-character tokens.
       if (MatchSubstring("->")) {
-        tokens.push_back(Token(LexicalTokenType::kRightArrow, "->",
-                               start_lineno, start_colno));
+        tokens.emplace_back(LexicalTokenType::kRightArrow, "->", start_lineno,
+                            start_colno);
         Advance(2);
         continue;
       }
@@ -286,15 +289,15 @@ class Tokenizer {
       XLS_ASSIGN_OR_RETURN(
           content, MatchQuotedString("\"\"\"", /*allow_multiline=*/true));
       if (content.has_value()) {
-        tokens.push_back(Token(LexicalTokenType::kQuotedString, content.value(),
-                               start_lineno, start_colno));
+        tokens.emplace_back(LexicalTokenType::kQuotedString, content.value(),
+                            start_lineno, start_colno);
         continue;
       }
       XLS_ASSIGN_OR_RETURN(content,
                            MatchQuotedString("\"", /*allow_multiline=*/false));
       if (content.has_value()) {
-        tokens.push_back(Token(LexicalTokenType::kQuotedString, content.value(),
-                               start_lineno, start_colno));
+        tokens.emplace_back(LexicalTokenType::kQuotedString, content.value(),
+                            start_lineno, start_colno);
         continue;
       }
 
@@ -359,7 +362,7 @@ class Tokenizer {
               "Invalid character in IR text \"%s\" @ %s", char_str,
               TokenPos{lineno(), colno()}.ToHumanString()));
       }
-      tokens.push_back(Token(token_type, lineno(), colno()));
+      tokens.emplace_back(token_type, lineno(), colno());
       Advance();
     }
     return tokens;
@@ -387,6 +390,8 @@ class Tokenizer {
  private:
   explicit Tokenizer(std::string_view str) : str_(str) {}
 
+  static constexpr int64_t kCharsPerTokenEstimate = 4;
+
   // The string being tokenized.
   std::string_view str_;
 
@@ -405,8 +410,9 @@ absl::StatusOr<std::vector<Token>> TokenizeString(std::string_view str) {
 }
 
 absl::StatusOr<Scanner> Scanner::Create(std::string_view text) {
-  XLS_ASSIGN_OR_RETURN(auto tokens, TokenizeString(text));
-  return Scanner(std::move(tokens));
+  auto owned_text = std::make_unique<const std::string>(text);
+  XLS_ASSIGN_OR_RETURN(std::vector<Token> tokens, TokenizeString(*owned_text));
+  return Scanner(std::move(owned_text), std::move(tokens));
 }
 
 absl::StatusOr<Token> Scanner::PeekToken() const {
@@ -428,7 +434,7 @@ absl::StatusOr<Token> Scanner::PopTokenOrError(std::string_view context) {
 
 bool Scanner::TryDropToken(LexicalTokenType target) {
   if (PeekTokenIs(target)) {
-    PopToken();
+    ++token_idx_;
     return true;
   }
   return false;
@@ -443,8 +449,16 @@ absl::Status Scanner::DropTokenOrError(LexicalTokenType target,
         absl::StrFormat("Expected token of type %s%s; found EOF.",
                         LexicalTokenTypeToString(target), context_str));
   }
-  XLS_ASSIGN_OR_RETURN(Token dropped, PopTokenOrError(target, context));
-  (void)dropped;
+  const Token& token = PeekTokenOrDie();
+  if (token.type() != target) {
+    std::string context_str =
+        context.empty() ? std::string("") : absl::StrCat(" in ", context);
+    return absl::InvalidArgumentError(
+        absl::StrFormat("Expected token of type \"%s\"%s @ %s, but found: %s",
+                        LexicalTokenTypeToString(target), context_str,
+                        token.pos().ToHumanString(), token.ToString()));
+  }
+  ++token_idx_;
   return absl::OkStatus();
 }
 
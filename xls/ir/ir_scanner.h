@@ -16,9 +16,11 @@
 #define XLS_IR_IR_SCANNER_H_
 
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "absl/base/no_destructor.h"
@@ -98,7 +100,8 @@ class Token {
       : type_(type), value_(value), pos_({lineno, colno}) {}
 
   LexicalTokenType type() const { return type_; }
-  const std::string& value() const { return value_; }
+  // The value is a view of the text the token was scanned from.
+  std::string_view value() const { return value_; }
   const TokenPos& pos() const { return pos_; }
 
   // Returns the token as a (u)int64_t value. Token must be a literal. The
@@ -122,7 +125,7 @@ class Token {
 
  private:
   LexicalTokenType type_;
-  std::string value_;
+  std::string_view value_;
   TokenPos pos_;
 };
 
@@ -135,6 +138,9 @@ inline std::ostream& operator<<(std::ostream& os, const Token& token) {
 // source location information.  Right now this is a eager implementation - it
 // tokenizes the whole input. This can be easily changed later to a more demand
 // driven tokenization.
+//
+// The values of the returned tokens are views of `str`, which must outlive
+// them.
 absl::StatusOr<std::vector<Token>> TokenizeString(std::string_view str);
 
 class Scanner {
@@ -163,7 +169,8 @@ class Scanner {
            tokens_[token_idx_ + n].type() == target;
   }
 
-  // Pop the current token, advance token pointer to next token.
+  // Pop the current token, advance token pointer to next token. The token's
+  // value remains valid for the lifetime of the scanner.
   Token PopToken() {
     VLOG(6) << "Popping token: " << tokens_[token_idx_];
     return tokens_.at(token_idx_++);
@@ -175,7 +182,10 @@ class Scanner {
 
   // As above, but the caller must ensure we are not possibly at EOF: if we are,
   // then the program will CHECK-fail.
-  void DropTokenOrDie() { CHECK_OK(PopTokenOrError().status()); }
+  void DropTokenOrDie() {
+    CHECK(!AtEof()) << "Expected token, but found EOF.";
+    ++token_idx_;
+  }
 
   // Attempts to drop a token with type "target" from the token stream, and
   // returns true if it is possible to do so; otherwise, returns false.
@@ -207,8 +217,8 @@ class Scanner {
   // method above.
   absl::StatusOr<Token> PopLiteralOrStringToken(std::string_view context);
 
-  // Wrapper around PopTokenOrError(target) above that can be used with
-  // XLS_RETURN_IF_ERROR.
+  // Drops the token if it is of type "target", or returns an error otherwise.
+  // The token is not consumed on error.
   absl::Status DropTokenOrError(LexicalTokenType target,
                                 std::string_view context = "");
 
@@ -221,8 +231,12 @@ class Scanner {
   bool AtEof() const { return token_idx_ >= tokens_.size(); }
 
  private:
-  explicit Scanner(std::vector<Token> tokens) : tokens_(tokens) {}
+  Scanner(std::unique_ptr<const std::string> text, std::vector<Token> tokens)
+      : text_(std::move(text)), tokens_(std::move(tokens)) {}
 
+  // The scanned text, which token values point into. Held by pointer so the
+  // values stay valid when the scanner is moved.
+  std::unique_ptr<const std::string> text_;
   int64_t token_idx_ = 0;
   std::vector<Token> tokens_;
 };
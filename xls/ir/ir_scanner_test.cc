@@ -15,6 +15,7 @@
 #include "xls/ir/ir_scanner.h"
 
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "gmock/gmock.h"
@@ -35,7 +36,7 @@ using ::testing::HasSubstr;
 std::vector<std::string> TokensToStrings(absl::Span<const Token> tokens) {
   std::vector<std::string> strs;
   for (const Token& token : tokens) {
-    strs.push_back(token.value());
+    strs.push_back(std::string(token.value()));
   }
   return strs;
 }
@@ -179,5 +180,48 @@ TEST(IrScannerTest, UnterminatedTripleQuotedStrings) {
                HasSubstr("Unterminated quoted string starting at 1:1")));
 }
 
+TEST(IrScannerTest, ScannerPopsAndDropsTokens) {
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Scanner scanner,
+      Scanner::Create("fn a_long_identifier_name.42(x: bits[8]) -> bits[8]"));
+  XLS_ASSERT_OK(scanner.DropKeywordOrError("fn"));
+  XLS_ASSERT_OK_AND_ASSIGN(Token name, scanner.PeekToken());
+  EXPECT_EQ(name.value(), "a_long_identifier_name.42");
+  XLS_ASSERT_OK_AND_ASSIGN(name,
+                           scanner.PopTokenOrError(LexicalTokenType::kIdent));
+  EXPECT_EQ(name.value(), "a_long_identifier_name.42");
+  EXPECT_EQ(name.pos().colno, 3);
+  EXPECT_TRUE(scanner.TryDropToken(LexicalTokenType::kParenOpen));
+  EXPECT_FALSE(scanner.TryDropToken(LexicalTokenType::kParenOpen));
+  EXPECT_THAT(scanner.DropTokenOrError(LexicalTokenType::kColon),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("Expected token of type \":\"")));
+  // The failed drop does not consume the token.
+  XLS_ASSERT_OK_AND_ASSIGN(Token x, scanner.PeekToken());
+  EXPECT_EQ(x.value(), "x");
+  XLS_ASSERT_OK(scanner.PopTokenOrError(LexicalTokenType::kIdent).status());
+  XLS_EXPECT_OK(scanner.DropTokenOrError(LexicalTokenType::kColon));
+  EXPECT_TRUE(scanner.TryDropKeyword("bits"));
+  while (!scanner.AtEof()) {
+    scanner.DropTokenOrDie();
+  }
+  EXPECT_THAT(scanner.DropTokenOrError(LexicalTokenType::kParenClose),
+              StatusIs(absl::StatusCode::kInvalidArgument,
+                       HasSubstr("found EOF")));
+}
+
+TEST(IrScannerTest, TokenValuesOutliveMovedScanner) {
+  std::string text = "fn f(x: bits[8]) -> bits[8]";
+  XLS_ASSERT_OK_AND_ASSIGN(Scanner scanner, Scanner::Create(text));
+  // The scanner owns a copy of the text which its token values view.
+  text.clear();
+  Scanner moved = std::move(scanner);
+  XLS_ASSERT_OK(moved.DropKeywordOrError("fn"));
+  XLS_ASSERT_OK_AND_ASSIGN(Token name,
+                           moved.PopTokenOrError(LexicalTokenType::kIdent));
+  EXPECT_EQ(name.value(), "f");
+  EXPECT_EQ(name.pos().colno, 3);
+}
+
 }  // namespace
 }  // namespace xls
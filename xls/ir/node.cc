@@ -501,18 +501,40 @@ std::string_view Node::GetNameView() const {
 
 void Node::SetName(std::string_view name) {
   if (name.empty()) {
-    name_.reset();
+    ReplaceName(nullptr);
   } else {
-    name_ =
-        std::make_unique<std::string>(function_base()->UniquifyNodeName(name));
+    ReplaceName(
+        std::make_unique<std::string>(function_base()->UniquifyNodeName(name)));
   }
 }
 
 void Node::SetNameDirectly(std::string_view name) {
   if (name.empty()) {
-    name_.reset();
+    ReplaceName(nullptr);
   } else {
-    name_ = std::make_unique<std::string>(name);
+    ReplaceName(std::make_unique<std::string>(name));
+  }
+}
+
+void Node::ReplaceName(std::unique_ptr<std::string> name) {
+  std::unique_ptr<std::string> old_name = std::exchange(name_, std::move(name));
+  absl::Span<ChangeListener* const> listeners =
+      GetChangeListeners(function_base_);
+  if (listeners.empty()) {
+    return;
+  }
+  std::optional<std::string_view> old_name_view;
+  if (old_name != nullptr) {
+    old_name_view = *old_name;
+  }
+  for (ChangeListener* listener : listeners) {
+    listener->NodeRenamed(this, old_name_view);
+  }
+}
+
+void Node::NotifyAttributeChanged() {
+  for (ChangeListener* listener : GetChangeListeners(function_base_)) {
+    listener->NodeAttributeChanged(this);
   }
 }
 
@@ -521,7 +543,7 @@ void Node::ClearName() {
   CHECK(!Is<Param>());
   CHECK(!Is<InputPort>());
   CHECK(!Is<OutputPort>());
-  name_.reset();
+  ReplaceName(nullptr);
 }
 
 void Node::SetLoc(const SourceInfo& loc) { loc_ = loc; }
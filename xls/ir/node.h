@@ -292,6 +292,12 @@ class Node {
 
   int64_t id() const { return id_; }
 
+  // Returns the index of the node within its function base. Indices are dense
+  // in [0, FunctionBase::node_index_limit()) and are recycled when nodes are
+  // removed, so they are suitable for indexing side tables (see node_map.h).
+  // Returns -1 if the node has not been added to its function base.
+  int64_t node_index() const { return node_index_; }
+
   // Sets the id of the node. Mutates the user sets of the operands of the node
   // because user sets are sorted by id.  Note: this should only be used by the
   // parser and ideally not even there.
@@ -352,12 +358,21 @@ class Node {
   void AddUser(Node* user);
   void RemoveUser(Node* user);
 
+  // Replaces the assigned name of the node (nullptr clears it) and notifies
+  // change listeners.
+  void ReplaceName(std::unique_ptr<std::string> name);
+
+  // Notifies change listeners that a property of the node other than its
+  // operands or name was changed in place.
+  void NotifyAttributeChanged();
+
   // The number of users that we consider small enough to perform linear-time
   // algorithms on.
   static constexpr int64_t kSmallUserCount = 8;
 
   FunctionBase* function_base_;
   int64_t id_;
+  int64_t node_index_ = -1;
   Op op_;
   Type* type_;
   SourceInfo loc_;
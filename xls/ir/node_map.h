@@ -0,0 +1,248 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_NODE_MAP_H_
+#define XLS_IR_NODE_MAP_H_
+
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "xls/ir/node.h"
+
+namespace xls {
+
+namespace internal {
+
+inline void CheckAdded(const Node* node) {
+  CHECK_GE(node->node_index(), 0)
+      << "Node must be added to a function base before it is inserted into a "
+         "NodeMap or NodeSet: "
+      << node->GetName();
+}
+
+}  // namespace internal
+
+// Containers keyed by Node* which store their entries in vectors indexed by
+// the nodes' function-local index (Node::node_index) rather than hashing the
+// node pointers. A lookup is an array access and a pointer comparison.
+//
+// A container is bound to the function base of the first node inserted into
+// it (and unbound when cleared). Nodes of other function bases are kept in a
+// fallback hash table, so the containers accept nodes of any function base
+// like their absl counterparts. Inserting a node which has not yet been added
+// to a function base CHECK-fails: adding it later would assign it an index
+// and its entry would no longer be found.
+//
+// As with a hash table keyed by pointer, entries for nodes removed from the
+// function are not erased automatically. Such a stale entry is dropped when
+// its index is reused by a node that is then inserted into the container.
+
+// Map from Node* to T.
+template <typename T>
+class NodeMap {
+ public:
+  NodeMap() = default;
+
+  bool contains(const Node* node) const {
+    if (IsIndexed(node)) {
+      return node->node_index() < static_cast<int64_t>(slots_.size()) &&
+             slots_[node->node_index()].key == node;
+    }
+    return fallback_.contains(node);
+  }
+
+  // Returns the value for `node`, which must be present in the map.
+  T& at(const Node* node) {
+    if (IsIndexed(node)) {
+      CHECK(contains(node)) << "Node not in NodeMap: " << node->GetName();
+      return *slots_[node->node_index()].value;
+    }
+    return fallback_.at(node);
+  }
+  const T& at(const Node* node) const {
+    if (IsIndexed(node)) {
+      CHECK(contains(node)) << "Node not in NodeMap: " << node->GetName();
+      return *slots_[node->node_index()].value;
+    }
+    return fallback_.at(node);
+  }
+
+  // Returns the value for `node`, inserting a default-constructed value if it
+  // is not present.
+  T& operator[](Node* node) { return *emplace(node).first; }
+
+  // Inserts a value constructed from `args` for `node` if it is not already
+  // present. Returns a pointer to the value for `node` and whether it was
+  // inserted.
+  template <typename... Args>
+  std::pair<T*, bool> emplace(Node* node, Args&&... args) {
+    internal::CheckAdded(node);
+    if (function_base_ == nullptr) {
+      function_base_ = node->function_base();
+    }
+    if (!IsIndexed(node)) {
+      auto [it, inserted] =
+          fallback_.try_emplace(node, std::forward<Args>(args)...);
+      return {&it->second, inserted};
+    }
+    Slot& slot = GetOrCreateSlot(node->node_index());
+    if (slot.key == node) {
+      return {&*slot.value, false};
+    }
+    if (slot.key == nullptr) {
+      ++indexed_size_;
+    }
+    slot.key = node;
+    slot.value.emplace(std::forward<Args>(args)...);
+    return {&*slot.value, true};
+  }
+
+  // Removes the entry for `node`, if any. Returns the number of entries
+  // removed.
+  int64_t erase(const Node* node) {
+    if (!IsIndexed(node)) {
+      return fallback_.erase(node);
+    }
+    if (!contains(node)) {
+      return 0;
+    }
+    Slot& slot = slots_[node->node_index()];
+    slot.key = nullptr;
+    slot.value.reset();
+    --indexed_size_;
+    return 1;
+  }
+
+  // Removes all entries. The storage is retained for reuse.
+  void clear() {
+    slots_.clear();
+    fallback_.clear();
+    indexed_size_ = 0;
+    function_base_ = nullptr;
+  }
+
+  // Reserves space for nodes with indices up to `size`, e.g.
+  // FunctionBase::node_index_limit().
+  void reserve(int64_t size) { slots_.reserve(size); }
+
+  int64_t size() const { return indexed_size_ + fallback_.size(); }
+  bool empty() const { return size() == 0; }
+
+ private:
+  struct Slot {
+    const Node* key = nullptr;
+    std::optional<T> value;
+  };
+
+  bool IsIndexed(const Node* node) const {
+    return node->node_index() >= 0 && node->function_base() == function_base_;
+  }
+
+
+  Slot& GetOrCreateSlot(int64_t index) {
+    if (index >= static_cast<int64_t>(slots_.size())) {
+      slots_.resize(index + 1);
+    }
+    return slots_[index];
+  }
+
+  const FunctionBase* function_base_ = nullptr;
+  std::vector<Slot> slots_;
+  int64_t indexed_size_ = 0;
+  absl::flat_hash_map<const Node*, T> fallback_;
+};
+
+// Set of Node*.
+class NodeSet {
+ public:
+  NodeSet() = default;
+
+  bool contains(const Node* node) const {
+    if (IsIndexed(node)) {
+      return node->node_index() < static_cast<int64_t>(slots_.size()) &&
+             slots_[node->node_index()] == node;
+    }
+    return fallback_.contains(node);
+  }
+
+  // Inserts `node`. Returns true if it was not already present.
+  bool insert(const Node* node) {
+    internal::CheckAdded(node);
+    if (function_base_ == nullptr) {
+      function_base_ = node->function_base();
+    }
+    if (!IsIndexed(node)) {
+      return fallback_.insert(node).second;
+    }
+    if (node->node_index() >= static_cast<int64_t>(slots_.size())) {
+      slots_.resize(node->node_index() + 1, nullptr);
+    }
+    const Node*& slot = slots_[node->node_index()];
+    if (slot == node) {
+      return false;
+    }
+    if (slot == nullptr) {
+      ++indexed_size_;
+    }
+    slot = node;
+    return true;
+  }
+
+  // Removes `node`. Returns the number of nodes removed.
+  int64_t erase(const Node* node) {
+    if (!IsIndexed(node)) {
+      return fallback_.erase(node);
+    }
+    if (!contains(node)) {
+      return 0;
+    }
+    slots_[node->node_index()] = nullptr;
+    --indexed_size_;
+    return 1;
+  }
+
+  // Removes all nodes. The storage is retained for reuse.
+  void clear() {
+    slots_.clear();
+    fallback_.clear();
+    indexed_size_ = 0;
+    function_base_ = nullptr;
+  }
+
+  void reserve(int64_t size) { slots_.reserve(size); }
+
+  int64_t size() const { return indexed_size_ + fallback_.size(); }
+  bool empty() const { return size() == 0; }
+
+ private:
+  bool IsIndexed(const Node* node) const {
+    return node->node_index() >= 0 && node->function_base() == function_base_;
+  }
+
+  const FunctionBase* function_base_ = nullptr;
+  // The node stored at each index, or nullptr. Storing the node rather than a
+  // bit distinguishes a member from a node which has reused its index.
+  std::vector<const Node*> slots_;
+  int64_t indexed_size_ = 0;
+  absl::flat_hash_set<const Node*> fallback_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_NODE_MAP_H_
@@ -0,0 +1,200 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/node_map.h"
+
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/container/flat_hash_map.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/benchmark_support.h"
+#include "xls/ir/bits.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/package.h"
+#include "xls/ir/source_location.h"
+#include "xls/ir/value.h"
+
+namespace xls {
+namespace {
+
+class NodeMapTest : public IrTestBase {};
+
+TEST_F(NodeMapTest, NodeIndicesAreDenseAndRecycled) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue neg = fb.Negate(x);
+  BValue unused = fb.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(neg));
+  EXPECT_EQ(x.node()->node_index(), 0);
+  EXPECT_EQ(neg.node()->node_index(), 1);
+  EXPECT_EQ(unused.node()->node_index(), 2);
+  EXPECT_EQ(f->node_index_limit(), 3);
+
+  XLS_ASSERT_OK(f->RemoveNode(unused.node()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * literal, f->MakeNode<Literal>(SourceInfo(), Value(UBits(1, 8))));
+  EXPECT_EQ(literal->node_index(), 2);
+  EXPECT_EQ(f->node_index_limit(), 3);
+}
+
+TEST_F(NodeMapTest, InsertLookupAndErase) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue neg = fb.Negate(x);
+  XLS_ASSERT_OK(fb.BuildWithReturnValue(neg).status());
+
+  NodeMap<int64_t> map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(x.node()));
+  map[neg.node()] = 42;
+  EXPECT_TRUE(map.emplace(x.node(), 7).second);
+  EXPECT_FALSE(map.emplace(x.node(), 8).second);
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at(x.node()), 7);
+  EXPECT_EQ(map.at(neg.node()), 42);
+
+  EXPECT_EQ(map.erase(x.node()), 1);
+  EXPECT_EQ(map.erase(x.node()), 0);
+  EXPECT_FALSE(map.contains(x.node()));
+  EXPECT_EQ(map.size(), 1);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_FALSE(map.contains(neg.node()));
+}
+
+TEST_F(NodeMapTest, NodesOfOtherFunctionsAndUnaddedNodes) {
+  auto p = CreatePackage();
+  FunctionBuilder fb1("f1", p.get());
+  BValue x1 = fb1.Param("x", p->GetBitsType(8));
+  XLS_ASSERT_OK(fb1.BuildWithReturnValue(x1).status());
+  FunctionBuilder fb2("f2", p.get());
+  BValue x2 = fb2.Param("x", p->GetBitsType(8));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f2, fb2.BuildWithReturnValue(x2));
+  // Both params have index zero in their respective functions.
+  ASSERT_EQ(x1.node()->node_index(), x2.node()->node_index());
+  Literal unadded(SourceInfo(), Value(UBits(0, 8)), "unadded", f2);
+  ASSERT_EQ(unadded.node_index(), -1);
+
+  NodeMap<int64_t> map;
+  map[x1.node()] = 1;
+  map[x2.node()] = 2;
+  EXPECT_EQ(map.size(), 2);
+  EXPECT_EQ(map.at(x1.node()), 1);
+  EXPECT_EQ(map.at(x2.node()), 2);
+  EXPECT_FALSE(map.contains(&unadded));
+  // Its entry would be lost once it is added to `f2` and assigned an index.
+  EXPECT_DEATH(map[&unadded] = 3, "must be added to a function base");
+
+  NodeSet set;
+  EXPECT_TRUE(set.insert(x1.node()));
+  EXPECT_TRUE(set.insert(x2.node()));
+  EXPECT_FALSE(set.insert(x2.node()));
+  EXPECT_EQ(set.size(), 2);
+  EXPECT_EQ(set.erase(x2.node()), 1);
+  EXPECT_TRUE(set.contains(x1.node()));
+  EXPECT_FALSE(set.contains(x2.node()));
+  EXPECT_DEATH(set.insert(&unadded), "must be added to a function base");
+}
+
+TEST_F(NodeMapTest, RecycledIndexReplacesStaleEntry) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue unused = fb.Not(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(x));
+
+  NodeMap<int64_t> map;
+  NodeSet set;
+  map[unused.node()] = 1;
+  set.insert(unused.node());
+  XLS_ASSERT_OK(f->RemoveNode(unused.node()));
+  XLS_ASSERT_OK_AND_ASSIGN(
+      Node * literal, f->MakeNode<Literal>(SourceInfo(), Value(UBits(1, 8))));
+  ASSERT_EQ(literal->node_index(), 1);
+
+  // The removed node's entry is replaced rather than counted separately.
+  map[literal] = 2;
+  set.insert(literal);
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_EQ(map.at(literal), 2);
+  EXPECT_EQ(set.size(), 1);
+  EXPECT_TRUE(set.contains(literal));
+}
+
+// Returns the nodes of a function with 2^depth leaves in a shuffled-looking
+// but deterministic order so lookups are not purely sequential.
+std::vector<Node*> BenchmarkNodes(Package* p, int64_t depth) {
+  Function* f = benchmark_support::GenerateBalancedTree(
+                    p, depth, /*fan_out=*/2,
+                    benchmark_support::strategy::BinaryAdd(),
+                    benchmark_support::strategy::DistinctLiteral())
+                    .value();
+  std::vector<Node*> nodes(f->nodes().begin(), f->nodes().end());
+  int64_t node_count = nodes.size();
+  for (int64_t i = 0; i < node_count; ++i) {
+    std::swap(nodes[i], nodes[(i * 7919) % node_count]);
+  }
+  return nodes;
+}
+
+void BM_NodeMapInsertAndLookup(benchmark::State& state) {
+  auto p = std::make_unique<Package>("benchmark");
+  std::vector<Node*> nodes = BenchmarkNodes(p.get(), state.range(0));
+  for (auto _ : state) {
+    NodeMap<int64_t> map;
+    for (Node* node : nodes) {
+      map[node] = node->id();
+    }
+    int64_t sum = 0;
+    for (Node* node : nodes) {
+      sum += map.at(node);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+void BM_FlatHashMapInsertAndLookup(benchmark::State& state) {
+  auto p = std::make_unique<Package>("benchmark");
+  std::vector<Node*> nodes = BenchmarkNodes(p.get(), state.range(0));
+  for (auto _ : state) {
+    absl::flat_hash_map<Node*, int64_t> map;
+    for (Node* node : nodes) {
+      map[node] = node->id();
+    }
+    int64_t sum = 0;
+    for (Node* node : nodes) {
+      sum += map.at(node);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+}
+
+BENCHMARK(BM_NodeMapInsertAndLookup)->DenseRange(4, 16, 4);
+BENCHMARK(BM_FlatHashMapInsertAndLookup)->DenseRange(4, 16, 4);
+
+}  // namespace
+}  // namespace xls
@@ -513,6 +513,7 @@ absl::Status ChannelNode::ReplaceChannel(std::string_view new_channel_name) {
     XLS_RETURN_IF_ERROR(package()->GetChannel(new_channel_name).status());
   }
   channel_name_ = new_channel_name;
+  NotifyAttributeChanged();
   return absl::OkStatus();
 }
 
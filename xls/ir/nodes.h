@@ -141,7 +141,10 @@ class ArrayIndex final : public Node {
 
   // Mark/unmark this array-index as having all of its bounds statically known
   // to be good.
-  void SetAssumedInBounds(bool value = true) { assumed_in_bounds_ = value; }
+  void SetAssumedInBounds(bool value = true) {
+    assumed_in_bounds_ = value;
+    NotifyAttributeChanged();
+  }
 
   bool IsDefinitelyEqualTo(const Node* other) const final;
 
@@ -203,7 +206,10 @@ class ArrayUpdate final : public Node {
 
   // Mark/unmark this array-index as having all of its bounds statically known
   // to be good.
-  void SetAssumedInBounds(bool value = true) { assumed_in_bounds_ = value; }
+  void SetAssumedInBounds(bool value = true) {
+    assumed_in_bounds_ = value;
+    NotifyAttributeChanged();
+  }
 
   bool IsDefinitelyEqualTo(const Node* other) const final;
 
@@ -235,7 +241,10 @@ class Assert final : public Node {
 
   Node* condition() const { return operand(1); }
 
-  void set_label(std::string new_label) { label_ = std::move(new_label); }
+  void set_label(std::string new_label) {
+    label_ = std::move(new_label);
+    NotifyAttributeChanged();
+  }
 
   bool IsDefinitelyEqualTo(const Node* other) const final;
 
@@ -396,7 +405,10 @@ class Cover final : public Node {
 
   Node* condition() const { return operand(0); }
 
-  void set_label(std::string new_label) { label_ = std::move(new_label); }
+  void set_label(std::string new_label) {
+    label_ = std::move(new_label);
+    NotifyAttributeChanged();
+  }
 
   bool IsDefinitelyEqualTo(const Node* other) const final;
 
@@ -552,6 +564,7 @@ class PortNode : public Node {
 
   void set_system_verilog_type(std::optional<std::string> value) {
     system_verilog_type_ = value;
+    NotifyAttributeChanged();
   }
 
  private:
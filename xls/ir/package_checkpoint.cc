@@ -0,0 +1,283 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/package_checkpoint.h"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/strings/str_format.h"
+#include "absl/types/span.h"
+#include "xls/common/status/ret_check.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/visitor.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/package.h"
+#include "xls/ir/proc.h"
+
+namespace xls {
+
+PackageCheckpoint::PackageCheckpoint(Package* package) : package_(package) {
+  Attach();
+}
+
+PackageCheckpoint::~PackageCheckpoint() { Detach(); }
+
+void PackageCheckpoint::Attach() {
+  function_bases_ = package_->GetFunctionBases();
+  channel_count_ = package_->channels().size();
+  state_element_counts_.clear();
+  for (FunctionBase* fb : function_bases_) {
+    fb->RegisterChangeListener(this);
+    if (fb->IsProc()) {
+      state_element_counts_.push_back(
+          fb->AsProcOrDie()->GetStateElementCount());
+    }
+    if (!fb->IsBlock()) {
+      fb->SetRemovedNodeSink(&removed_nodes_);
+    }
+  }
+}
+
+void PackageCheckpoint::Detach() {
+  // Function bases may have been removed from the package since the
+  // checkpoint attached to them.
+  std::vector<FunctionBase*> current = package_->GetFunctionBases();
+  absl::flat_hash_set<FunctionBase*> live(current.begin(), current.end());
+  for (FunctionBase* fb : function_bases_) {
+    if (live.contains(fb)) {
+      fb->UnregisterChangeListener(this);
+      fb->SetRemovedNodeSink(nullptr);
+    }
+  }
+  function_bases_.clear();
+}
+
+void PackageCheckpoint::Commit() {
+  Detach();
+  changes_.clear();
+  added_nodes_.clear();
+  removed_nodes_.clear();
+  unsupported_change_.reset();
+  Attach();
+}
+
+absl::Status PackageCheckpoint::CheckCanRollback() const {
+  if (unsupported_change_.has_value()) {
+    return absl::FailedPreconditionError(absl::StrFormat(
+        "Cannot roll back package %s: %s", package_->name(),
+        *unsupported_change_));
+  }
+  if (package_->GetFunctionBases() != function_bases_) {
+    return absl::FailedPreconditionError(absl::StrFormat(
+        "Cannot roll back package %s: functions, procs or blocks were added "
+        "or removed",
+        package_->name()));
+  }
+  if (package_->channels().size() != static_cast<size_t>(channel_count_)) {
+    return absl::FailedPreconditionError(absl::StrFormat(
+        "Cannot roll back package %s: channels were added or removed",
+        package_->name()));
+  }
+  std::vector<int64_t> state_element_counts;
+  for (FunctionBase* fb : function_bases_) {
+    if (fb->IsProc()) {
+      state_element_counts.push_back(fb->AsProcOrDie()->GetStateElementCount());
+    }
+  }
+  if (state_element_counts != state_element_counts_) {
+    return absl::FailedPreconditionError(absl::StrFormat(
+        "Cannot roll back package %s: proc state elements were added or "
+        "removed",
+        package_->name()));
+  }
+  return absl::OkStatus();
+}
+
+absl::Status PackageCheckpoint::Rollback() {
+  XLS_RETURN_IF_ERROR(CheckCanRollback());
+  VLOG(2) << absl::StreamFormat("Rolling back %d changes to package %s",
+                                changes_.size(), package_->name());
+  // Stop recording (and retaining removed nodes) while undoing.
+  Detach();
+  for (auto it = changes_.rbegin(); it != changes_.rend(); ++it) {
+    XLS_RETURN_IF_ERROR(Undo(*it));
+  }
+  changes_.clear();
+  added_nodes_.clear();
+  removed_nodes_.clear();
+  Attach();
+  return absl::OkStatus();
+}
+
+absl::Status PackageCheckpoint::Undo(Change& change) {
+  return std::visit(
+      Visitor{
+          [](NodeAddedChange& c) -> absl::Status {
+            return c.node->function_base()->RemoveNode(c.node);
+          },
+          [&](NodeDeletedChange& c) -> absl::Status {
+            XLS_RET_CHECK_LT(c.removed_node_index, removed_nodes_.size());
+            return c.function_base->RestoreRemovedNode(
+                std::move(removed_nodes_[c.removed_node_index]));
+          },
+          [](OperandChangedChange& c) -> absl::Status {
+            for (auto it = c.operand_nos.rbegin(); it != c.operand_nos.rend();
+                 ++it) {
+              XLS_RETURN_IF_ERROR(c.node->ReplaceOperandNumber(
+                  *it, c.old_operand, /*type_must_match=*/false));
+            }
+            return absl::OkStatus();
+          },
+          [](NodeRenamedChange& c) -> absl::Status {
+            c.node->SetNameDirectly(c.old_name.value_or(""));
+            return absl::OkStatus();
+          },
+          [](ParamMovedChange& c) -> absl::Status {
+            return c.function_base->MoveParamToIndex(c.param, c.old_index);
+          },
+          [](ReturnValueChangedChange& c) -> absl::Status {
+            return c.function->set_return_value(c.old_return_value);
+          },
+      },
+      change);
+}
+
+bool PackageCheckpoint::IsTracked(const Node* node) {
+  if (node->node_index() < 0) {
+    return false;
+  }
+  if (node->function_base()->IsBlock()) {
+    MarkUnsupported(absl::StrFormat("block %s was modified",
+                                    node->function_base()->name()));
+    return false;
+  }
+  return true;
+}
+
+void PackageCheckpoint::MarkUnsupported(std::string_view reason) {
+  if (!unsupported_change_.has_value()) {
+    VLOG(2) << "Package checkpoint can no longer be rolled back: " << reason;
+    unsupported_change_ = std::string(reason);
+  }
+}
+
+void PackageCheckpoint::NodeAdded(Node* node) {
+  if (IsTracked(node)) {
+    changes_.push_back(NodeAddedChange{.node = node});
+    added_nodes_.insert(node);
+  }
+}
+
+void PackageCheckpoint::NodeDeleted(Node* node) {
+  if (!IsTracked(node)) {
+    return;
+  }
+  if (node->Is<StateRead>()) {
+    MarkUnsupported(
+        absl::StrFormat("state read %s was removed", node->GetName()));
+    return;
+  }
+  // The function base moves the node into `removed_nodes_` right after
+  // notifying listeners.
+  changes_.push_back(
+      NodeDeletedChange{.function_base = node->function_base(),
+                        .removed_node_index =
+                            static_cast<int64_t>(removed_nodes_.size())});
+}
+
+void PackageCheckpoint::OperandChanged(Node* node, Node* old_operand,
+                                       absl::Span<const int64_t> operand_nos) {
+  if (IsTracked(node)) {
+    changes_.push_back(OperandChangedChange{
+        .node = node,
+        .old_operand = old_operand,
+        .operand_nos = absl::InlinedVector<int64_t, 2>(operand_nos.begin(),
+                                                       operand_nos.end())});
+  }
+}
+
+void PackageCheckpoint::OperandRemoved(Node* node, Node* old_operand) {
+  if (IsTracked(node)) {
+    MarkUnsupported(absl::StrFormat("operand %s was removed from %s",
+                                    old_operand->GetName(), node->GetName()));
+  }
+}
+
+void PackageCheckpoint::OperandAdded(Node* node) {
+  // Operands are added to new nodes as they are constructed, before the node
+  // is added to its function base.
+  if (IsTracked(node)) {
+    MarkUnsupported(
+        absl::StrFormat("an operand was added to %s", node->GetName()));
+  }
+}
+
+void PackageCheckpoint::NodeRenamed(Node* node,
+                                    std::optional<std::string_view> old_name) {
+  if (IsTracked(node)) {
+    changes_.push_back(NodeRenamedChange{
+        .node = node,
+        .old_name = old_name.has_value()
+                        ? std::make_optional(std::string(*old_name))
+                        : std::nullopt});
+  }
+}
+
+void PackageCheckpoint::NodeAttributeChanged(Node* node) {
+  if (IsTracked(node) && !added_nodes_.contains(node)) {
+    MarkUnsupported(
+        absl::StrFormat("node %s was changed in place", node->GetName()));
+  }
+}
+
+void PackageCheckpoint::ParamMoved(FunctionBase* function_base, Param* param,
+                                   int64_t old_index) {
+  if (IsTracked(param)) {
+    changes_.push_back(ParamMovedChange{.function_base = function_base,
+                                        .param = param,
+                                        .old_index = old_index});
+  }
+}
+
+void PackageCheckpoint::ReturnValueChanged(Function* function_base,
+                                           Node* old_return_value) {
+  if (old_return_value == nullptr) {
+    MarkUnsupported(absl::StrFormat("return value of %s was set",
+                                    function_base->name()));
+    return;
+  }
+  changes_.push_back(ReturnValueChangedChange{
+      .function = function_base, .old_return_value = old_return_value});
+}
+
+void PackageCheckpoint::NextStateElementChanged(Proc* proc,
+                                                int64_t state_index,
+                                                Node* old_next_state_element) {
+  MarkUnsupported(absl::StrFormat("next state element %d of proc %s changed",
+                                  state_index, proc->name()));
+}
+
+}  // namespace xls
@@ -0,0 +1,168 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef XLS_IR_PACKAGE_CHECKPOINT_H_
+#define XLS_IR_PACKAGE_CHECKPOINT_H_
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/container/inlined_vector.h"
+#include "absl/status/status.h"
+#include "absl/types/span.h"
+#include "xls/ir/change_listener.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/package.h"
+#include "xls/ir/proc.h"
+
+namespace xls {
+
+// Records the changes made to the nodes of a package in an undo log so that a
+// speculative transformation can be rolled back in time proportional to the
+// size of the change rather than cloning the whole package up front.
+//
+// Changes reported through ChangeListener to the functions and procs of the
+// package are supported: nodes being added, removed (removed nodes are
+// retained by the checkpoint until it is committed) and renamed, operands
+// being replaced, parameters being reordered, and return values being changed.
+// Changes to blocks, adding or removing operands of existing nodes, changing
+// other properties of existing nodes in place (e.g., Assert::set_label or
+// ChannelNode::ReplaceChannel), removing state reads, and changes to the set of
+// function bases, channels or proc state elements cannot be undone; after any
+// of these CanRollback() returns false and the caller must fall back to a clone
+// of the package.
+//
+// Example:
+//
+//   PackageCheckpoint checkpoint(package);
+//   XLS_ASSIGN_OR_RETURN(bool changed, pass.Run(package, ...));
+//   if (!IsImprovement(package)) {
+//     XLS_RETURN_IF_ERROR(checkpoint.Rollback());
+//   }
+//
+// The package must outlive the checkpoint. Destroying the checkpoint commits
+// any changes not rolled back.
+class PackageCheckpoint : public ChangeListener {
+ public:
+  explicit PackageCheckpoint(Package* package);
+  ~PackageCheckpoint() override;
+
+  PackageCheckpoint(const PackageCheckpoint&) = delete;
+  PackageCheckpoint& operator=(const PackageCheckpoint&) = delete;
+
+  // Returns true if all changes recorded since the checkpoint was taken can be
+  // undone by Rollback.
+  bool CanRollback() const { return CheckCanRollback().ok(); }
+
+  // Undoes all changes since the checkpoint was taken (or last committed or
+  // rolled back). Returns an error, leaving the package unchanged, if
+  // CanRollback() is false. The checkpoint remains active afterwards.
+  absl::Status Rollback();
+
+  // Keeps all changes since the checkpoint was taken and starts recording
+  // anew from the current state of the package.
+  void Commit();
+
+  // Returns the number of changes recorded since the checkpoint was taken.
+  int64_t change_count() const { return changes_.size(); }
+
+  // ChangeListener implementation.
+  void NodeAdded(Node* node) override;
+  void NodeDeleted(Node* node) override;
+  void OperandChanged(Node* node, Node* old_operand,
+                      absl::Span<const int64_t> operand_nos) override;
+  void OperandRemoved(Node* node, Node* old_operand) override;
+  void OperandAdded(Node* node) override;
+  void NodeRenamed(Node* node,
+                   std::optional<std::string_view> old_name) override;
+  void NodeAttributeChanged(Node* node) override;
+  void ParamMoved(FunctionBase* function_base, Param* param,
+                  int64_t old_index) override;
+  void ReturnValueChanged(Function* function_base,
+                          Node* old_return_value) override;
+  void NextStateElementChanged(Proc* proc, int64_t state_index,
+                               Node* old_next_state_element) override;
+
+ private:
+  struct NodeAddedChange {
+    Node* node;
+  };
+  struct NodeDeletedChange {
+    FunctionBase* function_base;
+    // Index of the retained node in `removed_nodes_`.
+    int64_t removed_node_index;
+  };
+  struct OperandChangedChange {
+    Node* node;
+    Node* old_operand;
+    absl::InlinedVector<int64_t, 2> operand_nos;
+  };
+  struct NodeRenamedChange {
+    Node* node;
+    std::optional<std::string> old_name;
+  };
+  struct ParamMovedChange {
+    FunctionBase* function_base;
+    Param* param;
+    int64_t old_index;
+  };
+  struct ReturnValueChangedChange {
+    Function* function;
+    Node* old_return_value;
+  };
+  using Change =
+      std::variant<NodeAddedChange, NodeDeletedChange, OperandChangedChange,
+                   NodeRenamedChange, ParamMovedChange,
+                   ReturnValueChangedChange>;
+
+  // Registers the checkpoint with the function bases of the package and
+  // records the package structure which must not change.
+  void Attach();
+  // Unregisters the checkpoint from the function bases it was registered with
+  // which still exist.
+  void Detach();
+
+  absl::Status CheckCanRollback() const;
+  absl::Status Undo(Change& change);
+
+  // Returns true if changes to `node` need to be recorded: changes to nodes
+  // which have not been added to their function base yet are subsumed by the
+  // NodeAdded change.
+  bool IsTracked(const Node* node);
+  void MarkUnsupported(std::string_view reason);
+
+  Package* package_;
+  std::vector<FunctionBase*> function_bases_;
+  int64_t channel_count_ = 0;
+  std::vector<int64_t> state_element_counts_;
+
+  std::vector<Change> changes_;
+  // The nodes added since the checkpoint was taken, whose in-place changes are
+  // undone by removing them.
+  absl::flat_hash_set<Node*> added_nodes_;
+  std::vector<FunctionBase::RemovedNode> removed_nodes_;
+  std::optional<std::string> unsupported_change_;
+};
+
+}  // namespace xls
+
+#endif  // XLS_IR_PACKAGE_CHECKPOINT_H_
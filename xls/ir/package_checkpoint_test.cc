@@ -0,0 +1,182 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "xls/ir/package_checkpoint.h"
+
+#include <memory>
+#include <string>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "xls/common/status/matchers.h"
+#include "xls/ir/function.h"
+#include "xls/ir/function_builder.h"
+#include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
+#include "xls/ir/nodes.h"
+#include "xls/ir/op.h"
+#include "xls/ir/package.h"
+
+namespace xls {
+namespace {
+
+using ::absl_testing::StatusIs;
+using ::testing::HasSubstr;
+
+class PackageCheckpointTest : public IrTestBase {};
+
+TEST_F(PackageCheckpointTest, RollbackReplacedAndRemovedNodes) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn f(x: bits[8], y: bits[8]) -> bits[8] {
+  add: bits[8] = add(x, y)
+  ret neg: bits[8] = neg(add)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, p->GetFunction("f"));
+  std::string before = p->DumpIr();
+
+  PackageCheckpoint checkpoint(p.get());
+  Node* neg = f->return_value();
+  Node* add = neg->operand(0);
+  XLS_ASSERT_OK(neg->ReplaceUsesWithNew<UnOp>(add, Op::kNot).status());
+  XLS_ASSERT_OK(f->RemoveNode(neg));
+  XLS_ASSERT_OK(add->ReplaceUsesWithNew<BinOp>(add->operand(1),
+                                              add->operand(0), Op::kSub)
+                    .status());
+  XLS_ASSERT_OK(f->RemoveNode(add));
+  ASSERT_NE(p->DumpIr(), before);
+  EXPECT_GT(checkpoint.change_count(), 0);
+
+  ASSERT_TRUE(checkpoint.CanRollback());
+  XLS_ASSERT_OK(checkpoint.Rollback());
+  EXPECT_EQ(p->DumpIr(), before);
+  EXPECT_EQ(f->return_value(), neg);
+  EXPECT_EQ(neg->operand(0), add);
+  EXPECT_EQ(checkpoint.change_count(), 0);
+}
+
+TEST_F(PackageCheckpointTest, RollbackRemovedParamAndRename) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn f(x: bits[8], unused: bits[8], y: bits[8]) -> bits[8] {
+  ret add: bits[8] = add(x, y)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, p->GetFunction("f"));
+  std::string before = p->DumpIr();
+
+  PackageCheckpoint checkpoint(p.get());
+  XLS_ASSERT_OK_AND_ASSIGN(Param * unused, f->GetParamByName("unused"));
+  XLS_ASSERT_OK(f->RemoveNode(unused));
+  f->return_value()->SetName("sum");
+  ASSERT_EQ(f->params().size(), 2);
+
+  XLS_ASSERT_OK(checkpoint.Rollback());
+  EXPECT_EQ(p->DumpIr(), before);
+  EXPECT_EQ(f->params().size(), 3);
+  EXPECT_EQ(f->param(1), unused);
+}
+
+TEST_F(PackageCheckpointTest, CommitKeepsChanges) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue neg = fb.Negate(x);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(neg));
+
+  PackageCheckpoint checkpoint(p.get());
+  XLS_ASSERT_OK(neg.node()->ReplaceUsesWithNew<UnOp>(x.node(), Op::kNot)
+                    .status());
+  XLS_ASSERT_OK(f->RemoveNode(neg.node()));
+  std::string after = p->DumpIr();
+  checkpoint.Commit();
+  EXPECT_EQ(checkpoint.change_count(), 0);
+
+  // Rolling back now undoes nothing.
+  XLS_ASSERT_OK(checkpoint.Rollback());
+  EXPECT_EQ(p->DumpIr(), after);
+}
+
+TEST_F(PackageCheckpointTest, UnsupportedChangesPreventRollback) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  XLS_ASSERT_OK(fb.BuildWithReturnValue(x).status());
+
+  PackageCheckpoint checkpoint(p.get());
+  EXPECT_TRUE(checkpoint.CanRollback());
+  FunctionBuilder fb2("other", p.get());
+  XLS_ASSERT_OK(
+      fb2.BuildWithReturnValue(fb2.Param("y", p->GetBitsType(8))).status());
+  EXPECT_FALSE(checkpoint.CanRollback());
+  EXPECT_THAT(checkpoint.Rollback(),
+              StatusIs(absl::StatusCode::kFailedPrecondition,
+                       HasSubstr("were added or removed")));
+}
+
+TEST_F(PackageCheckpointTest, RollbackMovedParam) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn f(x: bits[8], y: bits[8], z: bits[8]) -> bits[8] {
+  ret add: bits[8] = add(x, z)
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, p->GetFunction("f"));
+  std::string before = p->DumpIr();
+
+  PackageCheckpoint checkpoint(p.get());
+  Param* x = f->param(0);
+  XLS_ASSERT_OK(f->MoveParamToIndex(x, 2));
+  ASSERT_EQ(f->param(2), x);
+
+  XLS_ASSERT_OK(checkpoint.Rollback());
+  EXPECT_EQ(p->DumpIr(), before);
+  EXPECT_EQ(f->param(0), x);
+}
+
+TEST_F(PackageCheckpointTest, InPlaceChangesToExistingNodesPreventRollback) {
+  XLS_ASSERT_OK_AND_ASSIGN(auto p, ParsePackage(R"(
+package test
+
+fn f(a: bits[8][4], i: bits[2]) -> bits[8] {
+  ret array_index.1: bits[8] = array_index(a, indices=[i])
+}
+)"));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, p->GetFunction("f"));
+  ArrayIndex* array_index = f->return_value()->As<ArrayIndex>();
+
+  PackageCheckpoint checkpoint(p.get());
+  // Changes to nodes added since the checkpoint are undone by removing them.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      ArrayIndex * added,
+      f->MakeNode<ArrayIndex>(array_index->loc(), array_index->array(),
+                              array_index->indices()));
+  added->SetAssumedInBounds();
+  EXPECT_TRUE(checkpoint.CanRollback());
+
+  array_index->SetAssumedInBounds();
+  EXPECT_FALSE(checkpoint.CanRollback());
+  EXPECT_THAT(checkpoint.Rollback(),
+              StatusIs(absl::StatusCode::kFailedPrecondition,
+                       HasSubstr("was changed in place")));
+}
+
+}  // namespace
+}  // namespace xls
@@ -14,8 +14,11 @@
 
 #include "xls/ir/value.h"
 
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -23,6 +26,8 @@
 #include <vector>
 
 #include "absl/algorithm/container.h"
+#include "absl/base/no_destructor.h"
+#include "absl/hash/hash.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -43,6 +48,30 @@
 
 namespace xls {
 
+/* static */ Value::AggregatePtr Value::MakeAggregate(
+    std::vector<Value>&& elements) {
+  if (elements.empty()) {
+    static const absl::NoDestructor<AggregatePtr> kEmpty(
+        std::make_shared<const Aggregate>(std::vector<Value>()));
+    return *kEmpty;
+  }
+  return std::make_shared<const Aggregate>(std::move(elements));
+}
+
+size_t Value::ElementsHash() const {
+  const Aggregate& aggregate = *std::get<AggregatePtr>(payload_);
+  // Racing computations store the same value, so relaxed ordering suffices.
+  size_t hash = aggregate.hash.load(std::memory_order_relaxed);
+  if (hash == kUnhashed) {
+    hash = absl::HashOf(aggregate.elements);
+    if (hash == kUnhashed) {
+      hash = kUnhashed + 1;
+    }
+    aggregate.hash.store(hash, std::memory_order_relaxed);
+  }
+  return hash;
+}
+
 /* static */ absl::StatusOr<Value> Value::Array(
     absl::Span<const Value> elements) {
   if (elements.empty()) {
@@ -270,7 +299,10 @@ absl::Status Value::PopulateFrom(BitmapView bitmap) {
       //
       // Here we iterate through values in reverse order so that the bit slicing
       // can ascend from least significant bit up to most significant bit.
-      auto& values = std::get<std::vector<Value>>(payload_);
+      //
+      // The elements may be shared with other values so they are copied (which
+      // only copies references to their own elements) before being modified.
+      std::vector<Value> values(elements().begin(), elements().end());
       int64_t bit_index = 0;
       for (int64_t i = values.size() - 1; i >= 0; --i) {
         int64_t element_bit_count = values[i].GetFlatBitCount();
@@ -279,6 +311,7 @@ absl::Status Value::PopulateFrom(BitmapView bitmap) {
         bit_index += element_bit_count;
       }
       XLS_RET_CHECK_EQ(bit_index, bitmap.bit_count());
+      payload_ = MakeAggregate(std::move(values));
       return absl::OkStatus();
     }
     case ValueKind::kToken:
@@ -291,7 +324,7 @@ absl::Status Value::PopulateFrom(BitmapView bitmap) {
 }
 
 absl::StatusOr<std::vector<Value>> Value::GetElements() const {
-  if (!std::holds_alternative<std::vector<Value>>(payload_)) {
+  if (!std::holds_alternative<AggregatePtr>(payload_)) {
     return absl::InvalidArgumentError("Value does not hold elements.");
   }
   return std::vector<Value>(elements().begin(), elements().end());
@@ -505,12 +538,25 @@ bool Value::operator==(const Value& other) const {
     return bits() == other.bits();
   }
 
-  // All non-Bits types are container types -- should have a size attribute.
-  if (size() != other.size()) {
-    return false;
+  if (kind() == ValueKind::kInvalid) {
+    return true;
   }
 
-  return absl::c_equal(elements(), other.elements());
+  // All other types are container types.
+  const AggregatePtr& lhs = std::get<AggregatePtr>(payload_);
+  const AggregatePtr& rhs = std::get<AggregatePtr>(other.payload_);
+  if (lhs == rhs) {
+    return true;
+  }
+  if (lhs->elements.size() != rhs->elements.size()) {
+    return false;
+  }
+  const size_t lhs_hash = lhs->hash.load(std::memory_order_relaxed);
+  const size_t rhs_hash = rhs->hash.load(std::memory_order_relaxed);
+  if (lhs_hash != kUnhashed && rhs_hash != kUnhashed && lhs_hash != rhs_hash) {
+    return false;
+  }
+  return absl::c_equal(lhs->elements, rhs->elements);
 }
 
 void FuzzTestPrintSourceCode(const std::vector<Value>& v, std::ostream* os) {
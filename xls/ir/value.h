@@ -15,8 +15,10 @@
 #ifndef XLS_IR_VALUE_H_
 #define XLS_IR_VALUE_H_
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <utility>
@@ -61,6 +63,12 @@ inline std::ostream& operator<<(std::ostream& os, ValueKind kind) {
 // values, or arrays or values. Arrays are represented similarly to tuples, but
 // are monomorphic and potentially multi-dimensional.
 //
+// The elements of tuples and arrays are immutable and reference counted, so
+// copying an aggregate value is O(1) and copies share their elements (as do
+// values built from the elements of others, e.g. the result of an array
+// update shares all the elements which were not updated). The hash of an
+// aggregate is computed once and cached with its elements.
+//
 // TODO(leary): 2019-04-04 Arrays are not currently multi-dimensional, we had
 // some discussion around this, maybe they should be?
 class Value {
@@ -108,7 +116,7 @@ class Value {
   }
 
   static Value Token() {
-    return Value(ValueKind::kToken, std::vector<Value>({}));
+    return Value(ValueKind::kToken, std::vector<Value>());
   }
   static Value Bool(bool enabled) {
     return Value(
@@ -148,7 +156,7 @@ class Value {
   absl::StatusOr<std::vector<Value>> GetElements() const;
 
   absl::Span<const Value> elements() const {
-    return std::get<std::vector<Value>>(payload_);
+    return std::get<AggregatePtr>(payload_)->elements;
   }
   const Value& element(int64_t i) const { return elements().at(i); }
   int64_t size() const { return elements().size(); }
@@ -195,19 +203,44 @@ class Value {
 
   template <typename H>
   friend H AbslHashValue(H h, const Value& v) {
-    return H::combine(std::move(h), v.kind_, v.payload_);
+    if (v.IsBits()) {
+      return H::combine(std::move(h), v.kind_, v.bits());
+    }
+    if (std::holds_alternative<AggregatePtr>(v.payload_)) {
+      return H::combine(std::move(h), v.kind_, v.ElementsHash());
+    }
+    return H::combine(std::move(h), v.kind_);
   }
 
  private:
+  static constexpr size_t kUnhashed = 0;
+
+  // The shared, immutable elements of a tuple, array or token.
+  struct Aggregate {
+    explicit Aggregate(std::vector<Value>&& values)
+        : elements(std::move(values)) {}
+
+    const std::vector<Value> elements;
+    // Hash of `elements`, or kUnhashed if not yet computed.
+    mutable std::atomic<size_t> hash{kUnhashed};
+  };
+  using AggregatePtr = std::shared_ptr<const Aggregate>;
+
   Value(ValueKind kind, absl::Span<const Value> elements)
-      : kind_(kind),
-        payload_(std::vector<Value>(elements.begin(), elements.end())) {}
+      : Value(kind, std::vector<Value>(elements.begin(), elements.end())) {}
 
   Value(ValueKind kind, std::vector<Value>&& elements)
-      : kind_(kind), payload_(std::move(elements)) {}
+      : kind_(kind), payload_(MakeAggregate(std::move(elements))) {}
+
+  // Returns the shared aggregate holding `elements`. All empty aggregates
+  // share a single allocation.
+  static AggregatePtr MakeAggregate(std::vector<Value>&& elements);
+
+  // Returns the (cached) hash of the elements of this tuple, array or token.
+  size_t ElementsHash() const;
 
   ValueKind kind_;
-  std::variant<std::nullptr_t, std::vector<Value>, Bits> payload_;
+  std::variant<std::nullptr_t, AggregatePtr, Bits> payload_;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Value& value) {
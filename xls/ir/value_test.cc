@@ -23,6 +23,8 @@
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "xls/common/fuzzing/fuzztest.h"
+#include "absl/hash/hash.h"
+#include "absl/hash/hash_testing.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
@@ -822,6 +824,55 @@ TEST(ValueTest, FuzzTestPrintSourceCode) {
             "Value::TupleOwned({Value(Bits::AllOnes(300))})");
 }
 
+TEST(ValueTest, CopiesShareElements) {
+  XLS_ASSERT_OK_AND_ASSIGN(Value table,
+                           Value::UBitsArray({1, 2, 3, 4, 5, 6, 7, 8}, 32));
+  Value tuple = Value::Tuple({table, Value(UBits(0, 1))});
+
+  Value copy = table;
+  EXPECT_EQ(copy, table);
+  EXPECT_EQ(copy.elements().data(), table.elements().data());
+  // Building a value from other values shares their elements too.
+  EXPECT_EQ(tuple.element(0).elements().data(), table.elements().data());
+}
+
+TEST(ValueTest, PopulateFromDoesNotAffectCopies) {
+  XLS_ASSERT_OK_AND_ASSIGN(Value original, Value::UBitsArray({1, 2}, 8));
+  XLS_ASSERT_OK_AND_ASSIGN(Value expected, Value::UBitsArray({3, 1}, 8));
+  BitPushBuffer push_buffer;
+  expected.FlattenTo(&push_buffer);
+  InlineBitmap bitmap = push_buffer.ToBitmap();
+
+  Value copy = original;
+  XLS_ASSERT_OK(copy.PopulateFrom(BitmapView(bitmap)));
+  EXPECT_EQ(copy, expected);
+  XLS_ASSERT_OK_AND_ASSIGN(Value unchanged, Value::UBitsArray({1, 2}, 8));
+  EXPECT_EQ(original, unchanged);
+}
+
+TEST(ValueTest, Hash) {
+  XLS_ASSERT_OK_AND_ASSIGN(Value array, Value::UBitsArray({1, 2, 3}, 8));
+  XLS_ASSERT_OK_AND_ASSIGN(Value equal_array, Value::UBitsArray({1, 2, 3}, 8));
+  XLS_ASSERT_OK_AND_ASSIGN(Value other_array, Value::UBitsArray({1, 2, 4}, 8));
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      Value(),
+      Value(UBits(1, 8)),
+      Value::Token(),
+      Value::Tuple({}),
+      array,
+      equal_array,
+      other_array,
+      Value::Tuple({array, Value(UBits(0, 1))}),
+      Value::Tuple({equal_array, Value(UBits(0, 1))}),
+  }));
+
+  // Comparisons of values with cached hashes give the same results.
+  EXPECT_EQ(absl::HashOf(array), absl::HashOf(equal_array));
+  EXPECT_NE(absl::HashOf(array), absl::HashOf(other_array));
+  EXPECT_EQ(array, equal_array);
+  EXPECT_NE(array, other_array);
+}
+
 }  // namespace
 
 }  // namespace xls
@@ -25,6 +25,7 @@
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/log/log.h"
@@ -38,8 +39,10 @@
 #include "xls/common/logging/log_lines.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/common/thread_pool.h"
 #include "xls/ir/block.h"
 #include "xls/ir/block_elaboration.h"
+#include "xls/ir/change_listener.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/code_template.h"
 #include "xls/ir/dfs_visitor.h"
@@ -103,6 +106,40 @@ absl::Status VerifyName(FunctionBase* function_base) {
   return absl::OkStatus();
 }
 
+// Visitor which only checks that the visited nodes are not part of a cycle,
+// which DfsVisitor does as it traverses the graph.
+class CycleChecker : public DfsVisitorWithDefault {
+  absl::Status DefaultHandler(Node* node) override { return absl::OkStatus(); }
+};
+
+// Verify the set of parameter nodes is exactly Function::params(), and that
+// the parameter names are unique.
+absl::Status VerifyParams(FunctionBase* function) {
+  absl::flat_hash_set<std::string> param_names;
+  absl::flat_hash_set<Node*> param_set;
+  for (Node* param : function->params()) {
+    XLS_RET_CHECK(param_set.insert(param).second)
+        << "Param appears more than once in Function::params()";
+    XLS_RET_CHECK(param_names.insert(param->GetName()).second)
+        << "Param name `" << param->GetName()
+        << "` is duplicated in Function::params()";
+  }
+  int64_t param_node_count = 0;
+  for (Node* node : function->nodes()) {
+    if (node->Is<Param>()) {
+      XLS_RET_CHECK(param_set.contains(node))
+          << "Param `" << node->GetName() << "` is not in Function::params()";
+      param_node_count++;
+    }
+  }
+  XLS_RET_CHECK_EQ(param_set.size(), param_node_count)
+      << "Number of param nodes not equal to Function::params() size for "
+         "function "
+      << function->name();
+
+  return absl::OkStatus();
+}
+
 // Verify common invariants to function-level constructs.
 absl::Status VerifyFunctionBase(FunctionBase* function) {
   VLOG(2) << absl::StreamFormat("Verifying function %s:", function->name());
@@ -124,11 +161,6 @@ absl::Status VerifyFunctionBase(FunctionBase* function) {
   }
 
   // Verify that there are no cycles in the node graph.
-  class CycleChecker : public DfsVisitorWithDefault {
-    absl::Status DefaultHandler(Node* node) override {
-      return absl::OkStatus();
-    }
-  };
   CycleChecker cycle_checker;
   XLS_RETURN_IF_ERROR(function->Accept(&cycle_checker));
 
@@ -137,31 +169,7 @@ absl::Status VerifyFunctionBase(FunctionBase* function) {
     XLS_RETURN_IF_ERROR(VerifyNode(node));
   }
 
-  // Verify the set of parameter nodes is exactly Function::params(), and that
-  // the parameter names are unique.
-  absl::flat_hash_set<std::string> param_names;
-  absl::flat_hash_set<Node*> param_set;
-  for (Node* param : function->params()) {
-    XLS_RET_CHECK(param_set.insert(param).second)
-        << "Param appears more than once in Function::params()";
-    XLS_RET_CHECK(param_names.insert(param->GetName()).second)
-        << "Param name `" << param->GetName()
-        << "` is duplicated in Function::params()";
-  }
-  int64_t param_node_count = 0;
-  for (Node* node : function->nodes()) {
-    if (node->Is<Param>()) {
-      XLS_RET_CHECK(param_set.contains(node))
-          << "Param `" << node->GetName() << "` is not in Function::params()";
-      param_node_count++;
-    }
-  }
-  XLS_RET_CHECK_EQ(param_set.size(), param_node_count)
-      << "Number of param nodes not equal to Function::params() size for "
-         "function "
-      << function->name();
-
-  return absl::OkStatus();
+  return VerifyParams(function);
 }
 
 // Verify various invariants about the channels owned by the given package.
@@ -496,28 +504,9 @@ absl::Status VerifyBlockProvenance(Package* package) {
   return absl::OkStatus();
 }
 
-}  // namespace
-
-absl::Status VerifyPackage(
-    Package* package, bool codegen,
-    std::function<std::vector<Node*>(FunctionBase*)> topo_sort) {
-  VLOG(4) << absl::StreamFormat("Verifying package %s:\n", package->name());
-  XLS_VLOG_LINES(4, package->DumpIr());
-
-  for (auto& function : package->functions()) {
-    XLS_RETURN_IF_ERROR(VerifyFunction(function.get(), codegen));
-  }
-
-  for (auto& proc : package->procs()) {
-    XLS_RETURN_IF_ERROR(VerifyProc(proc.get(), codegen));
-  }
-
-  for (auto& block : package->blocks()) {
-    XLS_RETURN_IF_ERROR(VerifyBlock(block.get(), codegen));
-  }
-
-  // Verify node IDs are unique within the package and uplinks point to this
-  // package.
+// Verify node IDs are unique within the package and uplinks point to this
+// package.
+absl::Status VerifyNodeIds(Package* package) {
   std::vector<bool> ids_seen(package->next_node_id());
   int64_t max_id_seen = -1;
   for (FunctionBase* function : package->GetFunctionBases()) {
@@ -531,8 +520,11 @@ absl::Status VerifyPackage(
   // Ensure that the package's "next ID" is not in the space of IDs currently
   // occupied by the package's nodes.
   XLS_RET_CHECK_GT(package->next_node_id(), max_id_seen);
+  return absl::OkStatus();
+}
 
-  // Verify function, proc, block names are unique among functions/procs/blocks.
+// Verify function, proc, block names are unique among functions/procs/blocks.
+absl::Status VerifyFunctionBaseNames(Package* package) {
   absl::flat_hash_set<FunctionBase*> function_bases;
   absl::flat_hash_set<std::string> function_names;
   absl::flat_hash_set<std::string> proc_names;
@@ -557,7 +549,78 @@ absl::Status VerifyPackage(
         << " appears more than once in within package" << package->name();
     function_bases.insert(function_base);
   }
+  return absl::OkStatus();
+}
+
+// Functions and procs with fewer nodes than this in total are verified on the
+// calling thread, as handing them to other threads would cost more than it
+// saves.
+constexpr int64_t kMinNodesPerVerificationThread = 4096;
 
+absl::Status VerifyFunctionOrProc(FunctionBase* function_base, bool codegen) {
+  if (function_base->IsFunction()) {
+    return VerifyFunction(function_base->AsFunctionOrDie(), codegen);
+  }
+  return VerifyProc(function_base->AsProcOrDie(), codegen);
+}
+
+// Verifies the given functions and procs, in parallel on the shared thread
+// pool if they are large enough for it to pay off. Verifying a function or
+// proc only reads the package. Returns the error of the first failing function
+// base in the given order, as verifying them one after another would.
+absl::Status VerifyFunctionsAndProcs(
+    absl::Span<FunctionBase* const> function_bases, bool codegen) {
+  int64_t node_count = 0;
+  for (FunctionBase* function_base : function_bases) {
+    node_count += function_base->node_count();
+  }
+  int64_t max_threads = node_count / kMinNodesPerVerificationThread;
+  // The shared pool is only started once a package large enough to use it is
+  // seen.
+  if (max_threads <= 1 || function_bases.size() <= 1) {
+    for (FunctionBase* function_base : function_bases) {
+      XLS_RETURN_IF_ERROR(VerifyFunctionOrProc(function_base, codegen));
+    }
+    return absl::OkStatus();
+  }
+
+  VLOG(3) << absl::StreamFormat(
+      "Verifying %d functions and procs (%d nodes) on up to %d threads",
+      function_bases.size(), node_count, max_threads);
+  std::vector<absl::Status> statuses(function_bases.size());
+  ParallelFor(ThreadPool::Shared(), function_bases.size(), max_threads,
+              [&](int64_t i) {
+                statuses[i] = VerifyFunctionOrProc(function_bases[i], codegen);
+              });
+  for (absl::Status& status : statuses) {
+    XLS_RETURN_IF_ERROR(status);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
+absl::Status VerifyPackage(
+    Package* package, bool codegen,
+    std::function<std::vector<Node*>(FunctionBase*)> topo_sort) {
+  VLOG(4) << absl::StreamFormat("Verifying package %s:\n", package->name());
+  XLS_VLOG_LINES(4, package->DumpIr());
+
+  std::vector<FunctionBase*> functions_and_procs;
+  for (auto& function : package->functions()) {
+    functions_and_procs.push_back(function.get());
+  }
+  for (auto& proc : package->procs()) {
+    functions_and_procs.push_back(proc.get());
+  }
+  XLS_RETURN_IF_ERROR(VerifyFunctionsAndProcs(functions_and_procs, codegen));
+
+  for (auto& block : package->blocks()) {
+    XLS_RETURN_IF_ERROR(VerifyBlock(block.get(), codegen));
+  }
+
+  XLS_RETURN_IF_ERROR(VerifyNodeIds(package));
+  XLS_RETURN_IF_ERROR(VerifyFunctionBaseNames(package));
   XLS_RETURN_IF_ERROR(VerifyChannels(package, codegen, topo_sort));
   XLS_RETURN_IF_ERROR(VerifyElaboration(package));
   XLS_RETURN_IF_ERROR(VerifyBlockProvenance(package));
@@ -570,6 +633,16 @@ absl::Status VerifyPackage(
   return absl::OkStatus();
 }
 
+// Verify invariants of a node which are specific to functions.
+static absl::Status VerifyFunctionNode(Node* node) {
+  if (node->Is<Send>() || node->Is<Receive>()) {
+    return absl::InternalError(absl::StrFormat(
+        "Send and receive nodes can only be in procs, not functions (%s)",
+        node->GetName()));
+  }
+  return absl::OkStatus();
+}
+
 absl::Status VerifyFunction(Function* function, bool codegen) {
   VLOG(4) << "Verifying function:\n";
   XLS_VLOG_LINES(4, function->DumpIr());
@@ -577,11 +650,7 @@ absl::Status VerifyFunction(Function* function, bool codegen) {
   XLS_RETURN_IF_ERROR(VerifyFunctionBase(function));
 
   for (Node* node : function->nodes()) {
-    if (node->Is<Send>() || node->Is<Receive>()) {
-      return absl::InternalError(absl::StrFormat(
-          "Send and receive nodes can only be in procs, not functions (%s)",
-          node->GetName()));
-    }
+    XLS_RETURN_IF_ERROR(VerifyFunctionNode(node));
   }
 
   return absl::OkStatus();
@@ -1195,4 +1264,234 @@ absl::Status VerifyBlock(Block* block, bool codegen) {
   return absl::OkStatus();
 }
 
+// Records the nodes of a function base changed since the last verification.
+class IncrementalVerifier::ChangeTracker : public ChangeListener {
+ public:
+  explicit ChangeTracker(FunctionBase* function_base)
+      : function_base_(function_base) {
+    function_base_->RegisterChangeListener(this);
+  }
+  ~ChangeTracker() override {
+    if (function_base_ != nullptr) {
+      function_base_->UnregisterChangeListener(this);
+    }
+  }
+
+  ChangeTracker(const ChangeTracker&) = delete;
+  ChangeTracker& operator=(const ChangeTracker&) = delete;
+
+  // Forgets the function base without unregistering from it, as it has been
+  // destroyed.
+  void Release() { function_base_ = nullptr; }
+
+  // Returns true if the tracker is registered with `function_base`, which
+  // might instead be a new function base allocated where the tracked one was.
+  bool IsRegisteredWith(FunctionBase* function_base) const {
+    return function_base == function_base_ &&
+           absl::c_linear_search(GetChangeListeners(function_base), this);
+  }
+
+  bool changed() const { return changed_; }
+  bool channel_nodes_changed() const { return channel_nodes_changed_; }
+
+  void Reset() {
+    changed_nodes_.clear();
+    changed_ = false;
+    params_changed_ = false;
+    channel_nodes_changed_ = false;
+  }
+
+  // Verifies the changed nodes, their users, and the invariants of the
+  // function or proc the changes may affect.
+  absl::Status VerifyChanges() const {
+    VLOG(3) << absl::StreamFormat("Verifying %d changed nodes of %s",
+                                  changed_nodes_.size(),
+                                  function_base_->name());
+    absl::flat_hash_set<Node*> to_verify(changed_nodes_.begin(),
+                                         changed_nodes_.end());
+    for (Node* node : changed_nodes_) {
+      to_verify.insert(node->users().begin(), node->users().end());
+    }
+    // Verify in a deterministic order so the same error is reported for the
+    // same changes.
+    std::vector<Node*> nodes(to_verify.begin(), to_verify.end());
+    std::sort(nodes.begin(), nodes.end(),
+              [](Node* a, Node* b) { return a->id() < b->id(); });
+
+    Package* package = function_base_->package();
+    for (Node* node : nodes) {
+      XLS_RET_CHECK(node->function_base() == function_base_);
+      XLS_RET_CHECK(package->IsOwnedType(node->GetType()));
+      XLS_RET_CHECK(node->package() == package);
+      XLS_RET_CHECK_LT(node->id(), package->next_node_id());
+      XLS_RETURN_IF_ERROR(VerifyNode(node));
+      if (function_base_->IsFunction()) {
+        XLS_RETURN_IF_ERROR(VerifyFunctionNode(node));
+      }
+    }
+
+    // Any cycle created by the changes passes through a changed node.
+    CycleChecker cycle_checker;
+    for (Node* node : nodes) {
+      XLS_RETURN_IF_ERROR(node->Accept(&cycle_checker));
+    }
+
+    if (params_changed_) {
+      XLS_RETURN_IF_ERROR(VerifyParams(function_base_));
+    }
+    if (function_base_->IsProc()) {
+      Proc* proc = function_base_->AsProcOrDie();
+      if (proc->is_new_style_proc()) {
+        if (channel_nodes_changed_) {
+          XLS_RETURN_IF_ERROR(VerifyProcScopedChannels(proc));
+        }
+        XLS_RETURN_IF_ERROR(VerifyProcInstantiations(proc));
+      }
+      XLS_RET_CHECK(proc->params().empty());
+    }
+    return absl::OkStatus();
+  }
+
+  void NodeAdded(Node* node) override { MarkChanged(node); }
+  void NodeDeleted(Node* node) override {
+    changed_ = true;
+    changed_nodes_.erase(node);
+    // The operands have lost a user.
+    for (Node* operand : node->operands()) {
+      MarkChanged(operand);
+    }
+    params_changed_ |= node->Is<Param>();
+    channel_nodes_changed_ |= node->Is<ChannelNode>();
+  }
+  void OperandChanged(Node* node, Node* old_operand,
+                      absl::Span<const int64_t> operand_nos) override {
+    MarkChanged(node);
+    MarkChanged(old_operand);
+  }
+  void OperandRemoved(Node* node, Node* old_operand) override {
+    MarkChanged(node);
+    MarkChanged(old_operand);
+  }
+  void OperandAdded(Node* node) override { MarkChanged(node); }
+  void NodeRenamed(Node* node,
+                   std::optional<std::string_view> old_name) override {
+    changed_ = true;
+    params_changed_ |= node->Is<Param>();
+  }
+  void NodeAttributeChanged(Node* node) override { MarkChanged(node); }
+  void ParamMoved(FunctionBase* function_base, Param* param,
+                  int64_t old_index) override {
+    changed_ = true;
+    params_changed_ = true;
+  }
+  void ReturnValueChanged(Function* function_base,
+                          Node* old_return_value) override {
+    changed_ = true;
+  }
+  void NextStateElementChanged(Proc* proc, int64_t state_index,
+                               Node* old_next_state_element) override {
+    changed_ = true;
+  }
+
+ private:
+  void MarkChanged(Node* node) {
+    // Nodes still under construction are recorded when they are added.
+    if (node->node_index() < 0) {
+      return;
+    }
+    changed_ = true;
+    changed_nodes_.insert(node);
+    channel_nodes_changed_ |= node->Is<ChannelNode>();
+  }
+
+  FunctionBase* function_base_;
+  absl::flat_hash_set<Node*> changed_nodes_;
+  bool changed_ = false;
+  bool params_changed_ = false;
+  bool channel_nodes_changed_ = false;
+};
+
+IncrementalVerifier::IncrementalVerifier(Package* package)
+    : package_(package) {}
+
+IncrementalVerifier::~IncrementalVerifier() = default;
+
+void IncrementalVerifier::Abandon(FunctionBase* function_base) {
+  trackers_.erase(function_base);
+}
+
+absl::Status IncrementalVerifier::Verify(
+    bool codegen, std::function<std::vector<Node*>(FunctionBase*)> topo_sort) {
+  std::vector<FunctionBase*> function_bases = package_->GetFunctionBases();
+
+  // Drop the trackers of function bases which were removed from the package
+  // without being abandoned. They have been destroyed, so the trackers must
+  // not unregister from them.
+  absl::flat_hash_set<FunctionBase*> live(function_bases.begin(),
+                                          function_bases.end());
+  absl::erase_if(trackers_, [&](const auto& entry) {
+    const auto& [function_base, tracker] = entry;
+    if (live.contains(function_base) &&
+        tracker->IsRegisteredWith(function_base)) {
+      return false;
+    }
+    tracker->Release();
+    return true;
+  });
+
+  if (!verified_) {
+    XLS_RETURN_IF_ERROR(VerifyPackage(package_, codegen, topo_sort));
+  } else {
+    const bool structure_changed =
+        function_bases != function_bases_ ||
+        static_cast<int64_t>(package_->channels().size()) != channel_count_ ||
+        package_->GetTop() != top_;
+    bool channel_nodes_changed = structure_changed;
+    std::vector<FunctionBase*> new_functions_and_procs;
+    for (FunctionBase* function_base : function_bases) {
+      auto it = trackers_.find(function_base);
+      if (it != trackers_.end() && !it->second->changed()) {
+        continue;
+      }
+      if (function_base->IsBlock()) {
+        // Blocks have many invariants spanning their nodes, so they are
+        // verified in full if anything changed.
+        XLS_RETURN_IF_ERROR(
+            VerifyBlock(function_base->AsBlockOrDie(), codegen));
+      } else if (it == trackers_.end()) {
+        new_functions_and_procs.push_back(function_base);
+      } else {
+        channel_nodes_changed |= it->second->channel_nodes_changed();
+        XLS_RETURN_IF_ERROR(it->second->VerifyChanges());
+      }
+    }
+    XLS_RETURN_IF_ERROR(
+        VerifyFunctionsAndProcs(new_functions_and_procs, codegen));
+
+    if (structure_changed) {
+      XLS_RETURN_IF_ERROR(VerifyNodeIds(package_));
+    }
+    XLS_RETURN_IF_ERROR(VerifyFunctionBaseNames(package_));
+    if (channel_nodes_changed) {
+      XLS_RETURN_IF_ERROR(VerifyChannels(package_, codegen, topo_sort));
+      XLS_RETURN_IF_ERROR(VerifyElaboration(package_));
+    }
+    XLS_RETURN_IF_ERROR(VerifyBlockProvenance(package_));
+  }
+
+  for (FunctionBase* function_base : function_bases) {
+    std::unique_ptr<ChangeTracker>& tracker = trackers_[function_base];
+    if (tracker == nullptr) {
+      tracker = std::make_unique<ChangeTracker>(function_base);
+    } else {
+      tracker->Reset();
+    }
+  }
+  function_bases_ = std::move(function_bases);
+  channel_count_ = package_->channels().size();
+  top_ = package_->GetTop();
+  verified_ = true;
+  return absl::OkStatus();
+}
+
 }  // namespace xls
@@ -15,9 +15,13 @@
 #ifndef XLS_IR_VERIFIER_H_
 #define XLS_IR_VERIFIER_H_
 
+#include <cstdint>
 #include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 
+#include "absl/container/flat_hash_map.h"
 #include "absl/status/status.h"
 #include "xls/ir/topo_sort.h"
 
@@ -31,7 +35,8 @@ class Package;
 class FunctionBase;
 
 // Verifies numerous invariants of the IR for the given IR construct. Returns a
-// error status if a violation is found.
+// error status if a violation is found. Functions and procs of a large package
+// are verified in parallel, on the calling thread and ThreadPool::Shared().
 absl::Status VerifyPackage(
     Package* package, bool codegen = false,
     std::function<std::vector<Node*>(FunctionBase*)> topo_sort =
@@ -40,6 +45,54 @@ absl::Status VerifyFunction(Function* function, bool codegen = false);
 absl::Status VerifyProc(Proc* Proc, bool codegen = false);
 absl::Status VerifyBlock(Block* Block, bool codegen = false);
 
+// Verifies a package repeatedly while it is being transformed, re-checking
+// only what may have changed since the previous verification.
+//
+// The first call to Verify verifies the whole package like VerifyPackage.
+// Later calls verify the nodes added or changed since the previous successful
+// call (as reported through ChangeListener) along with their operands and
+// users, function bases added since then in full, and the package-level
+// invariants which the changes may affect. Blocks with any change are
+// verified in full.
+//
+// Changes which are not reported through ChangeListener, such as changing
+// the properties of a channel, are not detected; use VerifyPackage where a
+// complete check is required.
+//
+// The verifier registers change listeners with the function bases of the
+// package, so Abandon must be called before removing a function base from the
+// package, and the verifier must be destroyed before the package.
+class IncrementalVerifier {
+ public:
+  explicit IncrementalVerifier(Package* package);
+  ~IncrementalVerifier();
+
+  IncrementalVerifier(const IncrementalVerifier&) = delete;
+  IncrementalVerifier& operator=(const IncrementalVerifier&) = delete;
+
+  absl::Status Verify(
+      bool codegen = false,
+      std::function<std::vector<Node*>(FunctionBase*)> topo_sort =
+          [](FunctionBase* fb) { return TopoSort(fb); });
+
+  // Stops tracking changes to `function_base`, which is about to be removed
+  // from the package.
+  void Abandon(FunctionBase* function_base);
+
+ private:
+  class ChangeTracker;
+
+  Package* package_;
+  bool verified_ = false;
+  // Trackers of the changes made since the last successful verification.
+  absl::flat_hash_map<FunctionBase*, std::unique_ptr<ChangeTracker>>
+      trackers_;
+  // The package-level state as of the last successful verification.
+  std::vector<FunctionBase*> function_bases_;
+  int64_t channel_count_ = 0;
+  std::optional<FunctionBase*> top_;
+};
+
 }  // namespace xls
 
 #endif  // XLS_IR_VERIFIER_H_
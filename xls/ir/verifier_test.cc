@@ -14,21 +14,27 @@
 
 #include "xls/ir/verifier.h"
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/status.h"
 #include "absl/status/status_matchers.h"
+#include "absl/strings/str_cat.h"
 #include "absl/strings/substitute.h"
 #include "absl/types/span.h"
 #include "xls/common/status/matchers.h"
+#include "xls/common/thread.h"
 #include "xls/ir/bits.h"
 #include "xls/ir/channel.h"
+#include "xls/ir/function.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
+#include "xls/ir/node.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/package.h"
 #include "xls/ir/source_location.h"
@@ -827,5 +833,139 @@ proc my_new_proc<>() {}
                                  "proc-scoped channels")));
 }
 
+// Builds a function with a chain of `length` negations of param `x` and an
+// unused bits[16] param `y`. The result is named `result_name`.
+Function* BuildNegateChain(Package* p, std::string_view name,
+                           std::string_view result_name, int64_t length) {
+  FunctionBuilder fb(name, p);
+  BValue value = fb.Param("x", p->GetBitsType(8));
+  fb.Param("y", p->GetBitsType(16));
+  for (int64_t i = 1; i < length; ++i) {
+    value = fb.Negate(value);
+  }
+  return fb.BuildWithReturnValue(fb.Negate(value, SourceInfo(), result_name))
+      .value();
+}
+
+TEST_F(VerifierTest, ParallelVerificationReportsFirstError) {
+  // Not a VerifiedPackage as the package is left invalid.
+  auto p = std::make_unique<Package>(TestName());
+  std::vector<Function*> functions;
+  for (int64_t i = 0; i < 8; ++i) {
+    functions.push_back(BuildNegateChain(p.get(), absl::StrCat("f", i),
+                                         absl::StrCat("result", i), 1024));
+  }
+  XLS_ASSERT_OK(VerifyPackage(p.get()));
+
+  for (int64_t i : {3, 6}) {
+    XLS_ASSERT_OK_AND_ASSIGN(Param * y, functions[i]->GetParamByName("y"));
+    XLS_ASSERT_OK(functions[i]->return_value()->ReplaceOperandNumber(
+        0, y, /*type_must_match=*/false));
+  }
+  EXPECT_THAT(VerifyPackage(p.get()),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("Expected operand 0 of result3")));
+}
+
+TEST_F(VerifierTest, ConcurrentParallelVerificationsShareThreads) {
+  // Each package is large enough to be verified in parallel; every other one
+  // is invalid.
+  constexpr int64_t kPackageCount = 6;
+  std::vector<std::unique_ptr<Package>> packages;
+  for (int64_t i = 0; i < kPackageCount; ++i) {
+    auto p = std::make_unique<Package>(absl::StrCat(TestName(), i));
+    std::vector<Function*> functions;
+    for (int64_t j = 0; j < 8; ++j) {
+      functions.push_back(BuildNegateChain(p.get(), absl::StrCat("f", j),
+                                           absl::StrCat("result", j), 1024));
+    }
+    if (i % 2 == 1) {
+      XLS_ASSERT_OK_AND_ASSIGN(Param * y, functions[5]->GetParamByName("y"));
+      XLS_ASSERT_OK(functions[5]->return_value()->ReplaceOperandNumber(
+          0, y, /*type_must_match=*/false));
+    }
+    packages.push_back(std::move(p));
+  }
+
+  std::vector<absl::Status> statuses(kPackageCount);
+  {
+    std::vector<std::unique_ptr<Thread>> threads;
+    for (int64_t i = 0; i < kPackageCount; ++i) {
+      threads.push_back(std::make_unique<Thread>(
+          [&, i]() { statuses[i] = VerifyPackage(packages[i].get()); }));
+    }
+    for (std::unique_ptr<Thread>& thread : threads) {
+      thread->Join();
+    }
+  }
+  for (int64_t i = 0; i < kPackageCount; ++i) {
+    if (i % 2 == 1) {
+      EXPECT_THAT(statuses[i],
+                  StatusIs(absl::StatusCode::kInternal,
+                           HasSubstr("Expected operand 0 of result5")));
+    } else {
+      XLS_EXPECT_OK(statuses[i]);
+    }
+  }
+}
+
+TEST_F(VerifierTest, IncrementalVerifierChecksChangedNodes) {
+  auto p = CreatePackage();
+  Function* f = BuildNegateChain(p.get(), "f", "result", 16);
+  IncrementalVerifier verifier(p.get());
+  XLS_ASSERT_OK(verifier.Verify());
+  XLS_ASSERT_OK(verifier.Verify());
+
+  XLS_ASSERT_OK_AND_ASSIGN(Param * y, f->GetParamByName("y"));
+  Node* operand = f->return_value()->operand(0);
+  XLS_ASSERT_OK(f->return_value()->ReplaceOperandNumber(
+      0, y, /*type_must_match=*/false));
+  EXPECT_THAT(verifier.Verify(),
+              StatusIs(absl::StatusCode::kInternal,
+                       HasSubstr("Expected operand 0 of result")));
+
+  // The failed change is reported until it is fixed.
+  EXPECT_THAT(verifier.Verify(), StatusIs(absl::StatusCode::kInternal));
+  XLS_ASSERT_OK(f->return_value()->ReplaceOperandNumber(0, operand));
+  XLS_EXPECT_OK(verifier.Verify());
+}
+
+TEST_F(VerifierTest, IncrementalVerifierDetectsCycle) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  BValue x = fb.Param("x", p->GetBitsType(8));
+  BValue a = fb.Negate(x);
+  BValue b = fb.Negate(a);
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.BuildWithReturnValue(b));
+  IncrementalVerifier verifier(p.get());
+  XLS_ASSERT_OK(verifier.Verify());
+
+  XLS_ASSERT_OK(a.node()->ReplaceOperandNumber(0, b.node()));
+  EXPECT_THAT(verifier.Verify(), StatusIs(absl::StatusCode::kInternal,
+                                          HasSubstr("Cycle detected")));
+  XLS_ASSERT_OK(a.node()->ReplaceOperandNumber(0, f->param(0)));
+  XLS_EXPECT_OK(verifier.Verify());
+}
+
+TEST_F(VerifierTest, IncrementalVerifierHandlesAddedAndRemovedFunctions) {
+  auto p = CreatePackage();
+  BuildNegateChain(p.get(), "f", "result", 4);
+  IncrementalVerifier verifier(p.get());
+  XLS_ASSERT_OK(verifier.Verify());
+
+  Function* g = BuildNegateChain(p.get(), "g", "result", 4);
+  XLS_ASSERT_OK(verifier.Verify());
+
+  verifier.Abandon(g);
+  XLS_ASSERT_OK(p->RemoveFunction(g));
+  XLS_ASSERT_OK(verifier.Verify());
+
+  // Removing a function without abandoning it is detected as well.
+  Function* h = BuildNegateChain(p.get(), "h", "result", 4);
+  XLS_ASSERT_OK(verifier.Verify());
+  XLS_ASSERT_OK(p->RemoveFunction(h));
+  XLS_ASSERT_OK(verifier.Verify());
+}
+
 }  // namespace
 }  // namespace xls
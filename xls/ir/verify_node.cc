@@ -42,6 +42,28 @@
 
 namespace xls {
 namespace {
+
+// VerifyNode must not create types: creating a type modifies the package's
+// type table and the nodes of different function bases may be verified
+// concurrently. Types are interned, so comparing them by pointer is
+// equivalent to comparing against a constructed type.
+
+bool IsBitsOfWidth(Type* type, int64_t bit_count) {
+  return type->IsBits() && type->AsBitsOrDie()->bit_count() == bit_count;
+}
+
+// Returns the string FunctionType::ToString would give for the type of
+// `function`.
+std::string SignatureString(Function* function) {
+  return absl::StrFormat(
+      "(%s) -> %s",
+      absl::StrJoin(function->params(), ", ",
+                    [](std::string* out, Param* param) {
+                      absl::StrAppend(out, param->GetType()->ToString());
+                    }),
+      function->return_value()->GetType()->ToString());
+}
+
 // Visitor which verifies various properties of Nodes including the types of the
 // operands and the type of the result.
 class NodeChecker : public DfsVisitor {
@@ -171,17 +193,17 @@ class NodeChecker : public DfsVisitor {
             receive->channel_name(), receive->GetName()));
       }
     }
-    Type* expected_type =
-        receive->is_blocking()
-            ? receive->package()->GetTupleType(
-                  {receive->package()->GetTokenType(), channel_type})
-            : receive->package()->GetTupleType(
-                  {receive->package()->GetTokenType(), channel_type,
-                   receive->package()->GetBitsType(1)});
-    if (receive->GetType() != expected_type) {
+    Type* type = receive->GetType();
+    const int64_t expected_size = receive->is_blocking() ? 2 : 3;
+    if (!type->IsTuple() || type->AsTupleOrDie()->size() != expected_size ||
+        !type->AsTupleOrDie()->element_type(0)->IsToken() ||
+        type->AsTupleOrDie()->element_type(1) != channel_type ||
+        (!receive->is_blocking() &&
+         !IsBitsOfWidth(type->AsTupleOrDie()->element_type(2), 1))) {
       return absl::InternalError(absl::StrFormat(
-          "Expected %s to have type %s, has type %s", receive->GetName(),
-          expected_type->ToString(), receive->GetType()->ToString()));
+          "Expected %s to have type (token, %s%s), has type %s",
+          receive->GetName(), channel_type->ToString(),
+          receive->is_blocking() ? "" : ", bits[1]", type->ToString()));
     }
     return absl::OkStatus();
   }
@@ -343,7 +365,7 @@ class NodeChecker : public DfsVisitor {
           "Function %s used as counted_for body should have "
           "%d parameters, got %d instead; body type: %s; node: %s",
           body->name(), expected_param_count, actual_param_count,
-          body->GetType()->ToString(), counted_for->ToString()));
+          SignatureString(body), counted_for->ToString()));
     }
 
     // Verify i is of type bits with a sufficient width and at least 1 bit
@@ -705,7 +727,7 @@ class NodeChecker : public DfsVisitor {
           "parameter count (%d); function name: %s; signature: %s; arg types: "
           "[%s]",
           invoke->operand_count(), func->params().size(), func->name(),
-          func->GetType()->ToString(), arg_types_str));
+          SignatureString(func), arg_types_str));
     }
     for (int64_t i = 0; i < invoke->operand_count(); ++i) {
       XLS_RETURN_IF_ERROR(
@@ -1165,8 +1187,7 @@ class NodeChecker : public DfsVisitor {
           reg_write->GetRegister()->name(), reg_write->GetName()));
     }
     if (reg_write->reset().has_value() &&
-        reg_write->reset().value()->GetType() !=
-            reg_write->package()->GetBitsType(1)) {
+        !IsBitsOfWidth(reg_write->reset().value()->GetType(), 1)) {
       return absl::InternalError(absl::StrFormat(
           "Expected reset operand of register write operation %s to have "
           "bits[1] type, is %s",
@@ -1174,8 +1195,7 @@ class NodeChecker : public DfsVisitor {
           reg_write->reset().value()->GetType()->ToString()));
     }
     if (reg_write->load_enable().has_value() &&
-        reg_write->load_enable().value()->GetType() !=
-            reg_write->package()->GetBitsType(1)) {
+        !IsBitsOfWidth(reg_write->load_enable().value()->GetType(), 1)) {
       return absl::InternalError(absl::StrFormat(
           "Expected load enable operand of register write operation %s to "
           "have bits[1] type, is %s",
@@ -30,6 +30,7 @@
 #include "xls/ir/events.h"
 #include "xls/ir/function.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/value.h"
 #include "xls/jit/function_jit.h"
@@ -88,9 +89,9 @@ SwitchableFunctionJit::Create(Function* xls_function, ExecutionType execution,
 }
 
 namespace {
-absl::StatusOr<absl::flat_hash_map<Node*, Value>> ToValueMap(
-    absl::Span<const Value> args, Function* f) {
-  absl::flat_hash_map<Node*, Value> res;
+absl::StatusOr<NodeMap<Value>> ToValueMap(absl::Span<const Value> args,
+                                          Function* f) {
+  NodeMap<Value> res;
   XLS_RET_CHECK_EQ(args.size(), f->params().size())
       << "Wrong number of parameters";
   int64_t i = 0;
@@ -100,9 +101,9 @@ absl::StatusOr<absl::flat_hash_map<Node*, Value>> ToValueMap(
   return res;
 }
 
-absl::StatusOr<absl::flat_hash_map<Node*, Value>> ToValueMap(
+absl::StatusOr<NodeMap<Value>> ToValueMap(
     const absl::flat_hash_map<std::string, Value>& args, Function* f) {
-  absl::flat_hash_map<Node*, Value> res;
+  NodeMap<Value> res;
   for (Param* p : f->params()) {
     XLS_RET_CHECK(args.contains(p->name()))
         << "No value for param called '" << p->name() << "' given!";
@@ -120,8 +121,8 @@ class MemoizedIrInterpreter : public IrInterpreter {
   }
 };
 
-absl::StatusOr<InterpreterResult<Value>> Interpret(
-    absl::flat_hash_map<Node*, Value> values, Function* function) {
+absl::StatusOr<InterpreterResult<Value>> Interpret(NodeMap<Value> values,
+                                                   Function* function) {
   InterpreterEvents e;
   Node* return_val = function->return_value();
   InterpreterResult<Value> res;
@@ -17,6 +17,7 @@
 #include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -37,6 +38,7 @@
 #include "xls/ir/package.h"
 #include "xls/ir/ram_rewrite.pb.h"
 #include "xls/ir/topo_sort.h"
+#include "xls/ir/verifier.h"
 
 namespace xls {
 
@@ -152,6 +154,16 @@ std::vector<Node*> OptimizationContext::TopoSort(FunctionBase* f) {
   return result;
 }
 
+IncrementalVerifier& OptimizationContext::GetIncrementalVerifier(
+    Package* package) {
+  std::unique_ptr<IncrementalVerifier>& verifier =
+      incremental_verifiers_[package];
+  if (verifier == nullptr) {
+    verifier = std::make_unique<IncrementalVerifier>(package);
+  }
+  return *verifier;
+}
+
 absl::StatusOr<bool> OptimizationFunctionBasePass::TransformNodesToFixedPoint(
     FunctionBase* f,
     std::function<absl::StatusOr<bool>(Node*)> simplify_f) const {
@@ -46,6 +46,7 @@
 #include "xls/ir/proc.h"
 #include "xls/ir/ram_rewrite.pb.h"
 #include "xls/ir/value.h"
+#include "xls/ir/verifier.h"
 #include "xls/passes/pass_base.h"
 #include "xls/passes/pass_pipeline.pb.h"
 #include "xls/passes/pass_registry.h"
@@ -284,11 +285,19 @@ class OptimizationContext {
     shared_query_engines_.erase(f);
     shared_lazy_node_data_.erase(f);
     reverse_topo_sort_.erase(f);
+    if (auto it = incremental_verifiers_.find(f->package());
+        it != incremental_verifiers_.end()) {
+      it->second->Abandon(f);
+    }
   }
 
   std::vector<Node*> ReverseTopoSort(FunctionBase* f);
   std::vector<Node*> TopoSort(FunctionBase* f);
 
+  // Returns a verifier for `package` which only re-checks what changed since
+  // it last verified the package.
+  IncrementalVerifier& GetIncrementalVerifier(Package* package);
+
  private:
   const std::vector<Node*>& ReverseTopoSortReference(FunctionBase* f);
 
@@ -354,6 +363,8 @@ class OptimizationContext {
           std::shared_ptr<ChangeListener>,
           absl::Hash<std::pair<std::type_index, AnalysisOptions>>>>
       shared_lazy_node_data_;
+  absl::flat_hash_map<Package*, std::unique_ptr<IncrementalVerifier>>
+      incremental_verifiers_;
 };
 
 // Construct a query engine that forwards to the shared implementation from
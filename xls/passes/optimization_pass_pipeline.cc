@@ -50,11 +50,9 @@ TryCreateOptimizationPassPipeline(bool debug_optimizations,
   auto top = std::make_unique<OptimizationCompoundPass>(
       "ir", "Top level pass pipeline");
   top->AddOwned(std::move(pipeline));
+  AddVerifierCheckers(*top, debug_optimizations);
   if (debug_optimizations) {
-    top->AddInvariantChecker<VerifierChecker>();
     top->AddInvariantChecker<QueryEngineChecker>();
-  } else {
-    top->AddWeakInvariantChecker<VerifierChecker>();
   }
 
   return top;
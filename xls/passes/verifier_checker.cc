@@ -15,6 +15,7 @@
 #include "xls/passes/verifier_checker.h"
 
 #include "absl/status/status.h"
+#include "xls/common/status/status_macros.h"
 #include "xls/ir/verifier.h"
 #include "xls/passes/optimization_pass.h"
 #include "xls/passes/pass_base.h"
@@ -25,9 +26,25 @@ absl::Status VerifierChecker::Run(Package* p,
                                   const OptimizationPassOptions& options,
                                   PassResults* results,
                                   OptimizationContext& context) const {
-  return VerifyPackage(
-      p, /*codegen=*/false,
-      /*topo_sort=*/[&](FunctionBase* fb) { return context.TopoSort(fb); });
+  auto topo_sort = [&](FunctionBase* fb) { return context.TopoSort(fb); };
+  if (full_verification_interval_ <= 1) {
+    return VerifyPackage(p, /*codegen=*/false, topo_sort);
+  }
+  XLS_RETURN_IF_ERROR(
+      context.GetIncrementalVerifier(p).Verify(/*codegen=*/false, topo_sort));
+  if (++check_count_ % full_verification_interval_ == 0) {
+    return VerifyPackage(p, /*codegen=*/false, topo_sort);
+  }
+  return absl::OkStatus();
+}
+
+void AddVerifierCheckers(OptimizationCompoundPass& pipeline,
+                         bool debug_optimizations) {
+  if (debug_optimizations) {
+    pipeline.AddInvariantChecker<VerifierChecker>(
+        VerifierChecker::kDefaultFullVerificationInterval);
+  }
+  pipeline.AddWeakInvariantChecker<VerifierChecker>();
 }
 
 }  // namespace xls
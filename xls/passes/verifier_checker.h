@@ -15,6 +15,8 @@
 #ifndef XLS_PASSES_VERIFIER_CHECKER_H_
 #define XLS_PASSES_VERIFIER_CHECKER_H_
 
+#include <cstdint>
+
 #include "absl/status/status.h"
 #include "xls/ir/package.h"
 #include "xls/passes/optimization_pass.h"
@@ -22,14 +24,40 @@
 
 namespace xls {
 
-// Invariant checker which just runs xls::Verifier.
+// Invariant checker which runs the IR verifier.
+//
+// By default every check verifies the whole package, which suits a weak
+// invariant checker run only at the start and end of a pipeline. Given a
+// `full_verification_interval` greater than one, a check verifies only the
+// changes made to the package since the previous one (see
+// IncrementalVerifier), and every `full_verification_interval`-th check also
+// verifies the whole package, which catches changes the incremental verifier
+// cannot see. Pipelines which check every pass should also add a default
+// VerifierChecker as a weak invariant checker so the final IR is verified in
+// full (see AddVerifierCheckers).
 class VerifierChecker : public OptimizationInvariantChecker {
  public:
+  static constexpr int64_t kDefaultFullVerificationInterval = 64;
+
+  explicit VerifierChecker(int64_t full_verification_interval = 1)
+      : full_verification_interval_(full_verification_interval) {}
+
   absl::Status Run(Package* p, const OptimizationPassOptions& options,
                    PassResults* results,
                    OptimizationContext& context) const override;
+
+ private:
+  int64_t full_verification_interval_;
+  mutable int64_t check_count_ = 0;
 };
 
+// Adds the IR verifier to `pipeline`. With `debug_optimizations` the changes
+// made by every pass are verified, and the whole package periodically;
+// otherwise the package is verified at the start and end of the pipeline. In
+// both cases the final IR is verified in full.
+void AddVerifierCheckers(OptimizationCompoundPass& pipeline,
+                         bool debug_optimizations);
+
 }  // namespace xls
 
 #endif  // XLS_PASSES_VERIFIER_CHECKER_H_
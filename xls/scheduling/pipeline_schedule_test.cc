@@ -42,6 +42,8 @@
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/node.h"
 #include "xls/ir/op.h"
+#include "xls/ir/proc.h"
+#include "xls/ir/proc_elaboration.h"
 #include "xls/ir/source_location.h"
 #include "xls/ir/type.h"
 #include "xls/ir/value.h"
@@ -294,6 +296,95 @@ TEST_F(PipelineScheduleTest, MinimizeRegisterBitslices) {
       UnorderedElementsAre(m::BitSlice(m::Param("x")), m::Neg(), m::Concat()));
 }
 
+TEST_F(PipelineScheduleTest, AreaObjectiveDoesNotDelaySendsToOutputs) {
+  // Flops on a top-level output do not depend on when the send is scheduled,
+  // so the area objective must not hold the subproc's data in pipeline
+  // registers to avoid them.
+  auto p = CreatePackage();
+  Type* u32 = p->GetBitsType(32);
+  Proc* subproc;
+  Node* sub_receive;
+  Node* sub_send;
+  {
+    // The subproc narrows its input and sends it on a top-level channel.
+    TokenlessProcBuilder pb(NewStyleProc(), "subproc", "tkn", p.get());
+    XLS_ASSERT_OK_AND_ASSIGN(ReceiveChannelInterface * in,
+                             pb.AddInputChannel("sub_in", u32));
+    XLS_ASSERT_OK_AND_ASSIGN(
+        SendChannelInterface * out,
+        pb.AddOutputChannel("sub_out", p->GetBitsType(8)));
+    BValue received = pb.Receive(in);
+    BValue send = pb.Send(out, pb.BitSlice(received, /*start=*/0,
+                                           /*width=*/8));
+    XLS_ASSERT_OK_AND_ASSIGN(subproc, pb.Build());
+    sub_receive = received.node()->operand(0);
+    sub_send = send.node();
+  }
+
+  TokenlessProcBuilder pb(NewStyleProc(), "top", "tkn", p.get());
+  XLS_ASSERT_OK_AND_ASSIGN(ReceiveChannelInterface * in,
+                           pb.AddInputChannel("top_in", u32));
+  XLS_ASSERT_OK_AND_ASSIGN(SendChannelInterface * out,
+                           pb.AddOutputChannel("top_out", u32));
+  XLS_ASSERT_OK_AND_ASSIGN(SendChannelInterface * sub_out,
+                           pb.AddOutputChannel("sub_out", p->GetBitsType(8)));
+  XLS_ASSERT_OK_AND_ASSIGN(ChannelWithInterfaces ch,
+                           pb.AddChannel("ch", u32));
+  BValue x = pb.Receive(in);
+  pb.Send(ch.send_interface, x);
+  // A chain of negations makes the pipeline five stages long.
+  BValue negated = x;
+  for (int64_t i = 0; i < 5; ++i) {
+    negated = pb.Negate(negated);
+  }
+  pb.Send(out, negated);
+  XLS_ASSERT_OK(pb.InstantiateProc("inst", subproc,
+                                   {ch.receive_interface, sub_out}));
+  XLS_ASSERT_OK_AND_ASSIGN(Proc * top, pb.Build({}));
+  XLS_ASSERT_OK(p->SetTop(top));
+  XLS_ASSERT_OK_AND_ASSIGN(ProcElaboration elab,
+                           ProcElaboration::Elaborate(top));
+
+  // The bit-count objective sends the narrowed data as soon as it is received,
+  // since data in a channel FIFO costs nothing.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PackageSchedule bit_count_schedule,
+      RunSynchronousPipelineSchedule(p.get(), TestDelayEstimator(),
+                                     SchedulingOptions().clock_period_ps(1),
+                                     elab));
+  const PipelineSchedule& bit_count_subproc_schedule =
+      bit_count_schedule.GetSchedule(subproc);
+  EXPECT_EQ(bit_count_subproc_schedule.cycle(sub_send),
+            bit_count_subproc_schedule.cycle(sub_receive));
+
+  XLS_ASSERT_OK_AND_ASSIGN(
+      PackageSchedule area_schedule,
+      RunSynchronousPipelineSchedule(p.get(), TestDelayEstimator(),
+                                     SchedulingOptions()
+                                         .clock_period_ps(1)
+                                         .area_objective_model("asap7"),
+                                     elab));
+  const PipelineSchedule& area_subproc_schedule =
+      area_schedule.GetSchedule(subproc);
+  EXPECT_EQ(area_subproc_schedule.cycle(sub_send),
+            area_subproc_schedule.cycle(sub_receive));
+}
+
+TEST_F(PipelineScheduleTest, AreaObjectiveWithUnknownModel) {
+  auto p = CreatePackage();
+  FunctionBuilder fb(TestName(), p.get());
+  auto x = fb.Param("x", p->GetBitsType(32));
+  fb.Negate(fb.Negate(x));
+  XLS_ASSERT_OK_AND_ASSIGN(Function * f, fb.Build());
+
+  EXPECT_THAT(RunPipelineSchedule(f, TestDelayEstimator(),
+                                  SchedulingOptions()
+                                      .clock_period_ps(1)
+                                      .area_objective_model("not_a_model")),
+              StatusIs(absl::StatusCode::kNotFound,
+                       HasSubstr("No area estimator found")));
+}
+
 TEST_F(PipelineScheduleTest, AsapScheduleComplex) {
   auto p = CreatePackage();
   FunctionBuilder fb(TestName(), p.get());
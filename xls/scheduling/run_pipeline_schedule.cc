@@ -43,6 +43,8 @@
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/data_structures/binary_search.h"
+#include "xls/estimators/area_model/area_estimator.h"
+#include "xls/estimators/area_model/area_estimators.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/fdo/delay_manager.h"
 #include "xls/fdo/iterative_sdc_scheduler.h"
@@ -355,6 +357,19 @@ bool IsExternalIoNode(ChannelNode* node,
   return (*chan)->supported_ops() != ChannelOps::kSendReceive;
 }
 
+// Switches `scheduler` to the area-aware objective if `options` specifies an
+// area model for it.
+absl::Status MaybeSetAreaObjective(SDCScheduler& scheduler,
+                                   const SchedulingOptions& options) {
+  if (!options.area_objective_model().has_value()) {
+    return absl::OkStatus();
+  }
+  XLS_ASSIGN_OR_RETURN(AreaEstimator * area_estimator,
+                       GetAreaEstimator(*options.area_objective_model()));
+  return scheduler.SetAreaObjective(*area_estimator,
+                                    options.area_objective_weight());
+}
+
 absl::StatusOr<int64_t> ApplyClockMargin(const SchedulingOptions& options,
                                          int64_t clock_period_ps) {
   if (!options.clock_margin_percent().has_value()) {
@@ -458,6 +473,7 @@ absl::StatusOr<PipelineSchedule> RunPipelineScheduleInternal(
       XLS_ASSIGN_OR_RETURN(sdc_scheduler,
                            SDCScheduler::Create(f, io_delay_added));
       XLS_RETURN_IF_ERROR(sdc_scheduler->AddConstraints(options.constraints()));
+      XLS_RETURN_IF_ERROR(MaybeSetAreaObjective(*sdc_scheduler, options));
     }
     return absl::OkStatus();
   };
@@ -801,6 +817,7 @@ absl::StatusOr<PackageSchedule> RunSynchronousPipelineSchedule(
   XLS_ASSIGN_OR_RETURN(std::unique_ptr<SDCScheduler> sdc_scheduler,
                        SDCScheduler::Create(graph, delay_estimator));
   XLS_RETURN_IF_ERROR(sdc_scheduler->AddConstraints(options.constraints()));
+  XLS_RETURN_IF_ERROR(MaybeSetAreaObjective(*sdc_scheduler, options));
 
   XLS_ASSIGN_OR_RETURN(
       ScheduleCycleMap cycle_map,
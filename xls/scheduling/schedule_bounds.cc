@@ -21,7 +21,6 @@
 #include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
@@ -29,6 +28,7 @@
 #include "xls/common/status/status_macros.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 #include "xls/ir/nodes.h"
 #include "xls/ir/topo_sort.h"
 #include "xls/scheduling/schedule_util.h"
@@ -67,13 +67,9 @@ void ScheduleBounds::Reset() {
 
 std::string ScheduleBounds::ToString() const {
   std::string out = "Bounds:\n";
-  if (!bounds_.empty()) {
-    for (Node* node : TopoSort(bounds_.begin()->first->function_base())) {
-      if (bounds_.contains(node)) {
-        absl::StrAppendFormat(&out, "  %s : [%d, %d]\n", node->GetName(),
-                              lb(node), ub(node));
-      }
-    }
+  for (Node* node : topo_sort_) {
+    absl::StrAppendFormat(&out, "  %s : [%d, %d]\n", node->GetName(), lb(node),
+                          ub(node));
   }
   return out;
 }
@@ -90,7 +86,7 @@ absl::Status ScheduleBounds::PropagateLowerBounds() {
   VLOG(4) << "PropagateLowerBounds()";
   // The delay in picoseconds from the beginning of a cycle to the start of the
   // node.
-  absl::flat_hash_map<Node*, int64_t> in_cycle_delay;
+  NodeMap<int64_t> in_cycle_delay;
 
   // Compute the lower bound of each node based on the lower bounds of the
   // operands of the node.
@@ -144,7 +140,7 @@ absl::Status ScheduleBounds::PropagateLowerBounds() {
 absl::Status ScheduleBounds::PropagateUpperBounds() {
   VLOG(4) << "PropagateUpperBounds()";
   // The delay in picoseconds from the end of a cycle to the end of the node.
-  absl::flat_hash_map<Node*, int64_t> in_cycle_delay;
+  NodeMap<int64_t> in_cycle_delay;
 
   // Compute the upper bound of each node based on the upper bounds of the
   // users of the node.
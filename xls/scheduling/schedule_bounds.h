@@ -21,13 +21,13 @@
 #include <utility>
 #include <vector>
 
-#include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/node.h"
+#include "xls/ir/node_map.h"
 
 namespace xls {
 namespace sched {
@@ -130,7 +130,7 @@ class ScheduleBounds {
   const DelayEstimator* delay_estimator_;
 
   // The bounds of each node stored as a {lower, upper} pair.
-  absl::flat_hash_map<Node*, std::pair<int64_t, int64_t>> bounds_;
+  NodeMap<std::pair<int64_t, int64_t>> bounds_;
 
   int64_t max_lower_bound_;
   int64_t min_upper_bound_;
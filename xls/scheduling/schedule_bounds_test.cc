@@ -17,14 +17,18 @@
 #include <cstdint>
 #include <limits>
 
+#include "benchmark/benchmark.h"
 #include "gmock/gmock.h"
 #include "gtest/gtest.h"
 #include "absl/status/statusor.h"
 #include "xls/common/status/matchers.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
+#include "xls/ir/benchmark_support.h"
+#include "xls/ir/function.h"
 #include "xls/ir/function_builder.h"
 #include "xls/ir/ir_test_base.h"
 #include "xls/ir/op.h"
+#include "xls/ir/package.h"
 #include "xls/ir/value.h"
 
 namespace xls {
@@ -194,6 +198,24 @@ TEST_F(ScheduleBoundsTest, SimpleExpressionTightenBounds) {
   EXPECT_EQ(bounds.lb(result.node()), 23);
 }
 
+void BM_ComputeAsapAndAlapBounds(benchmark::State& state) {
+  Package p("benchmark");
+  Function* f = benchmark_support::GenerateBalancedTree(
+                    &p, /*depth=*/state.range(0), /*fan_out=*/2,
+                    benchmark_support::strategy::BinaryAdd(),
+                    benchmark_support::strategy::DistinctLiteral())
+                    .value();
+  TestDelayEstimator delay_estimator;
+  for (auto _ : state) {
+    absl::StatusOr<ScheduleBounds> bounds =
+        ScheduleBounds::ComputeAsapAndAlapBounds(f, /*clock_period_ps=*/4,
+                                                 delay_estimator);
+    benchmark::DoNotOptimize(bounds);
+  }
+}
+
+BENCHMARK(BM_ComputeAsapAndAlapBounds)->DenseRange(4, 16, 4);
+
 }  // namespace
 }  // namespace sched
 }  // namespace xls
@@ -71,6 +71,15 @@ absl::StatusOr<SchedulingOptions> OptionsFromFlagProto(
     scheduling_options.dynamic_throughput_objective_weight(
         proto.dynamic_throughput_objective_weight());
   }
+  if (!proto.area_objective_model().empty()) {
+    scheduling_options.area_objective_model(proto.area_objective_model());
+  }
+  if (proto.has_area_objective_weight()) {
+    if (proto.area_objective_weight() < 0.0) {
+      return absl::InvalidArgumentError("area_objective_weight must be >= 0.0");
+    }
+    scheduling_options.area_objective_weight(proto.area_objective_weight());
+  }
   if (proto.additional_input_delay_ps() != 0) {
     scheduling_options.additional_input_delay_ps(
         proto.additional_input_delay_ps());
@@ -254,6 +254,7 @@ class SchedulingOptions {
         minimize_clock_on_failure_(true),
         recover_after_minimizing_clock_(false),
         minimize_worst_case_throughput_(false),
+        area_objective_weight_(1.0),
         constraints_({
             BackedgeConstraint(),
             SendThenRecvConstraint(/*minimum_latency=*/1),
@@ -373,6 +374,28 @@ class SchedulingOptions {
     return dynamic_throughput_objective_weight_;
   }
 
+  // Sets/gets the name of the area model used by the area-aware scheduling
+  // objective. If set, the SDC scheduler weighs each pipeline register (and
+  // each stage of data held in flight on a channel) by its estimated area
+  // rather than by its bit count alone. std::nullopt disables the area-aware
+  // objective.
+  SchedulingOptions& area_objective_model(std::string_view value) {
+    area_objective_model_ = std::string(value);
+    return *this;
+  }
+  std::optional<std::string> area_objective_model() const {
+    return area_objective_model_;
+  }
+
+  // Sets/gets the weight of the area terms (in square microns) relative to the
+  // register bit-count terms in the area-aware scheduling objective. Only
+  // relevant if an area objective model is set.
+  SchedulingOptions& area_objective_weight(double value) {
+    area_objective_weight_ = value;
+    return *this;
+  }
+  double area_objective_weight() const { return area_objective_weight_; }
+
   // Sets/gets the additional delay added to each input.
   //
   // TODO(tedhong): 2022-02-11, Update so that this sets/gets the
@@ -600,6 +623,8 @@ class SchedulingOptions {
   bool minimize_worst_case_throughput_;
   std::optional<int64_t> worst_case_throughput_;
   std::optional<double> dynamic_throughput_objective_weight_;
+  std::optional<std::string> area_objective_model_;
+  double area_objective_weight_;
   std::optional<int64_t> additional_input_delay_ps_;
   std::optional<int64_t> additional_output_delay_ps_;
   absl::flat_hash_map<std::string, int64_t> additional_channel_delay_ps_;
@@ -26,6 +26,7 @@
 #include <variant>
 #include <vector>
 
+#include "absl/algorithm/container.h"
 #include "absl/container/btree_set.h"
 #include "absl/container/flat_hash_map.h"
 #include "absl/container/flat_hash_set.h"
@@ -40,6 +41,7 @@
 #include "absl/types/span.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
+#include "xls/estimators/area_model/area_estimator.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/channel.h"
 #include "xls/ir/function_base.h"
@@ -302,6 +304,7 @@ absl::Status SDCSchedulingModel::AddDefUseConstraints(
       graph_.GetScheduleNode(*user).is_dead_after_synthesis) {
     return absl::OkStatus();
   }
+
   return AddLifetimeConstraint(node, user);
 }
 
@@ -365,6 +368,56 @@ absl::Status SDCSchedulingModel::AddLifetimeConstraint(
   return absl::OkStatus();
 }
 
+absl::Status SDCSchedulingModel::AddAllChannelDataLifetimeConstraints() {
+  for (const ScheduleNode& schedule_node : graph_.nodes()) {
+    if (!schedule_node.node->Is<Send>()) {
+      continue;
+    }
+    Send* send = schedule_node.node->As<Send>();
+    // If a send reaches a user through a channel rather than as an operand,
+    // its data stays in flight until that user. Sends with no such user drive
+    // top-level outputs; whatever flops those get (see `--flop_outputs`) are
+    // the same wherever the send is scheduled, as are the flops on top-level
+    // inputs, so neither is costed.
+    for (Node* successor : schedule_node.successors) {
+      if (absl::c_linear_search(successor->operands(), send) ||
+          graph_.GetScheduleNode(successor).is_dead_after_synthesis) {
+        continue;
+      }
+      XLS_RETURN_IF_ERROR(AddChannelDataLifetimeConstraint(send, successor));
+    }
+  }
+  return absl::OkStatus();
+}
+
+absl::Status SDCSchedulingModel::AddChannelDataLifetimeConstraint(
+    Send* send, Node* user) {
+  math_opt::Variable cycle_at_send = cycle_var_.at(send);
+  math_opt::Variable cycle_at_user = cycle_var_.at(user);
+
+  auto it = channel_data_lifetime_var_.find(send);
+  if (it == channel_data_lifetime_var_.end()) {
+    it = channel_data_lifetime_var_
+             .emplace(send, model_.AddContinuousVariable(
+                                0.0, kInfinity,
+                                absl::StrFormat("channel_data_lifetime_%s",
+                                                send->GetName())))
+             .first;
+  }
+  math_opt::Variable channel_data_lifetime = it->second;
+
+  model_.AddLinearConstraint(
+      channel_data_lifetime + cycle_at_send - cycle_at_user >= 0,
+      absl::StrFormat("channel_data_lifetime_%s_%s", send->GetName(),
+                      user->GetName()));
+  VLOG(2) << "Setting channel data lifetime constraint: "
+          << absl::StrFormat(
+                 "channel_data_lifetime[%s] + cycle[%s] - cycle[%s] ≥ 0",
+                 send->GetName(), send->GetName(), user->GetName());
+
+  return absl::OkStatus();
+}
+
 absl::Status SDCSchedulingModel::AddThroughputConstraint(StateRead* state_read,
                                                          Next* next_value) {
   XLS_RET_CHECK(graph_.IncludesProc());
@@ -706,15 +759,64 @@ void SDCSchedulingModel::SetObjective(std::optional<double> throughput_weight) {
     // Minimize node lifetimes.
     // The scaling makes the tie-breaker small in comparison, and is a power
     // of two so that there's no imprecision (just add to exponent).
-    objective += kObjectiveScaling *
-                 static_cast<double>(node->GetType()->GetFlatBitCount()) *
-                 lifetime_var_.at(node);
+    double lifetime_cost;
+    if (auto it = lifetime_cost_.find(node); it != lifetime_cost_.end()) {
+      lifetime_cost = it->second;
+    } else {
+      lifetime_cost = static_cast<double>(node->GetType()->GetFlatBitCount());
+    }
+    objective += kObjectiveScaling * lifetime_cost * lifetime_var_.at(node);
+    // Minimize the data held in flight on channels, if we're costing it.
+    if (auto it = channel_data_lifetime_var_.find(node);
+        it != channel_data_lifetime_var_.end() &&
+        channel_data_lifetime_cost_.contains(node)) {
+      objective +=
+          kObjectiveScaling * channel_data_lifetime_cost_.at(node) * it->second;
+    }
   }
   model_.Minimize(objective);
 }
 
 void SDCSchedulingModel::RemoveObjective() { model_.Minimize(0.0); }
 
+absl::Status SDCSchedulingModel::SetAreaObjective(
+    const AreaEstimator& area_estimator, double area_weight) {
+  XLS_RET_CHECK_GE(area_weight, 0.0);
+  // Data in flight on channels is only costed by the area objective, so its
+  // lifetimes are only added to the model once the objective is enabled.
+  if (!channel_data_lifetimes_added_) {
+    XLS_RETURN_IF_ERROR(AddAllChannelDataLifetimeConstraints());
+    channel_data_lifetimes_added_ = true;
+  }
+  lifetime_cost_.clear();
+  channel_data_lifetime_cost_.clear();
+  for (const ScheduleNode& schedule_node : graph_.nodes()) {
+    Node* node = schedule_node.node;
+    if (IsUntimed(node)) {
+      continue;
+    }
+    int64_t bit_count = node->GetType()->GetFlatBitCount();
+    XLS_ASSIGN_OR_RETURN(double register_area,
+                         area_estimator.GetRegisterAreaInSquareMicrons(
+                             static_cast<uint64_t>(bit_count)));
+    lifetime_cost_[node] =
+        static_cast<double>(bit_count) + area_weight * register_area;
+
+    if (node->Is<Send>()) {
+      // Each cycle the data spends in flight occupies one FIFO entry holding
+      // the payload and its valid bit.
+      int64_t fifo_width =
+          node->As<Send>()->data()->GetType()->GetFlatBitCount() + 1;
+      XLS_ASSIGN_OR_RETURN(double fifo_entry_area,
+                           area_estimator.GetRegisterAreaInSquareMicrons(
+                               static_cast<uint64_t>(fifo_width)));
+      channel_data_lifetime_cost_[node] =
+          static_cast<double>(fifo_width) + area_weight * fifo_entry_area;
+    }
+  }
+  return absl::OkStatus();
+}
+
 absl::StatusOr<ScheduleCycleMap> SDCSchedulingModel::ExtractResult(
     const math_opt::VariableMap<double>& variable_values) const {
   ScheduleCycleMap cycle_map;
@@ -1168,6 +1270,11 @@ absl::Status SDCScheduler::AddConstraints(
   return absl::OkStatus();
 }
 
+absl::Status SDCScheduler::SetAreaObjective(
+    const AreaEstimator& area_estimator, double area_weight) {
+  return model_.SetAreaObjective(area_estimator, area_weight);
+}
+
 absl::Status SDCScheduler::BuildError(
     const math_opt::SolveResult& result,
     SchedulingFailureBehavior failure_behavior) {
@@ -27,6 +27,7 @@
 #include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "absl/types/span.h"
+#include "xls/estimators/area_model/area_estimator.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/function_base.h"
 #include "xls/ir/node.h"
@@ -82,6 +83,15 @@ class SDCSchedulingModel {
   void SetObjective(std::optional<double> throughput_weight);
   void RemoveObjective();
 
+  // Makes subsequent calls to `SetObjective` weigh each cycle of a value's
+  // lifetime by the estimated area of the registers holding it, in addition to
+  // its bit count. Data carried by a send (to its receive in a synchronous
+  // schedule, or to the end of the pipeline) is costed as one FIFO entry of
+  // the payload width plus a valid bit per cycle. `area_weight` scales the
+  // area terms (in square microns) relative to the bit-count terms.
+  absl::Status SetAreaObjective(const AreaEstimator& area_estimator,
+                                double area_weight);
+
   absl::StatusOr<int64_t> ExtractPipelineLength(
       const operations_research::math_opt::VariableMap<double>& variable_values)
       const;
@@ -133,6 +143,11 @@ class SDCSchedulingModel {
       Node* x, Node* y, int64_t diff, std::string_view name);
 
  private:
+  // Adds lifetime constraints for the data carried by sends to receives on the
+  // other end of their channels. Only used by the area objective.
+  absl::Status AddAllChannelDataLifetimeConstraints();
+  absl::Status AddChannelDataLifetimeConstraint(Send* send, Node* user);
+
   operations_research::math_opt::Variable AddUpperBoundSlack(
       operations_research::math_opt::LinearConstraint c,
       std::optional<operations_research::math_opt::Variable> slack =
@@ -184,6 +199,21 @@ class SDCSchedulingModel {
   absl::flat_hash_map<Node*, operations_research::math_opt::Variable>
       lifetime_var_;
 
+  // Lifetime of the data carried by a send, from the send until the data is
+  // consumed by a receive on the other end of the channel (in synchronous
+  // schedules). Sends to top-level outputs have none. Only added to the model
+  // by `SetAreaObjective`.
+  absl::flat_hash_map<Node*, operations_research::math_opt::Variable>
+      channel_data_lifetime_var_;
+
+  // Per-cycle objective costs of `lifetime_var_` and
+  // `channel_data_lifetime_var_`, set by `SetAreaObjective`. If empty, the
+  // objective weighs each lifetime by the node's flat bit count and ignores
+  // channel data lifetimes.
+  absl::flat_hash_map<Node*, double> lifetime_cost_;
+  absl::flat_hash_map<Node*, double> channel_data_lifetime_cost_;
+  bool channel_data_lifetimes_added_ = false;
+
   // Inverse throughput associated with node; the number of cycles between a
   // `next_value` node and its associated `param`.
   absl::flat_hash_map<Node*, operations_research::math_opt::Variable>
@@ -239,6 +269,12 @@ class SDCScheduler {
   absl::Status AddConstraints(
       absl::Span<const SchedulingConstraint> constraints);
 
+  // Schedule to minimize the estimated area of the pipeline registers (and of
+  // data in flight on synchronous channels) rather than just their bit count.
+  // See `SDCSchedulingModel::SetAreaObjective`.
+  absl::Status SetAreaObjective(const AreaEstimator& area_estimator,
+                                double area_weight);
+
   // Schedule to minimize the total pipeline registers using SDC scheduling
   // the constraint matrix is totally unimodular, this ILP problem can be solved
   // by LP.
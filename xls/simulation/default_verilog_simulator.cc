@@ -16,10 +16,13 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <utility>
 
 #include "absl/flags/flag.h"
 #include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
 #include "absl/status/statusor.h"
 #include "xls/simulation/verilog_simulator.h"
 #include "xls/simulation/verilog_simulators.h"
@@ -30,10 +33,24 @@ ABSL_FLAG(std::string, verilog_simulator, "iverilog",
 
 namespace xls {
 namespace verilog {
+namespace {
+
+// Simulator used when the requested simulator is not available on this
+// machine (e.g., a locally installed tool such as Verilator is missing).
+constexpr std::string_view kFallbackSimulatorName = "iverilog";
+
+}  // namespace
 
 std::unique_ptr<VerilogSimulator> GetDefaultVerilogSimulator() {
   const std::string simulator_name = absl::GetFlag(FLAGS_verilog_simulator);
   auto simulator = GetVerilogSimulator(simulator_name);
+  if (absl::IsUnavailable(simulator.status()) &&
+      simulator_name != kFallbackSimulatorName) {
+    LOG(WARNING) << "Simulator `" << simulator_name
+                 << "` is not available, falling back to `"
+                 << kFallbackSimulatorName << "`: " << simulator.status();
+    simulator = GetVerilogSimulator(kFallbackSimulatorName);
+  }
   QCHECK_OK(simulator) << "Unknown simulator --verilog_simulator="
                        << simulator_name;
   return std::move(simulator.value());
@@ -23,7 +23,8 @@ namespace xls {
 namespace verilog {
 
 // Returns a reference to a default verilog simulator named by
-// the --verilog_simulator flag.
+// the --verilog_simulator flag. If the named simulator is not available on
+// this machine (e.g., Verilator is not installed) iverilog is used instead.
 std::unique_ptr<VerilogSimulator> GetDefaultVerilogSimulator();
 
 }  // namespace verilog
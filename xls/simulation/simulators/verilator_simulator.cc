@@ -0,0 +1,459 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Verilog simulator backed by a locally installed Verilator (version 5 or
+// later, which supports `--binary` and `--timing`).
+//
+// Unlike an event-driven interpreter such as iverilog, Verilator compiles the
+// design and testbench to a native executable. Compilation is expensive but
+// simulation is fast, so compiled simulations are cached on disk keyed by a
+// hash of everything which affects compilation. Repeated runs of the same
+// testbench (e.g., the same regression across invocations, or syntax checks of
+// the same module) pay the compile cost once.
+//
+// Macros defined as string literals (such as the named pipe paths of
+// testbench streams, see `ModuleTestbench::RunWithStreamingIo`) are bound at
+// run time through plusargs rather than compiled in, and are not part of the
+// cache key. A testbench which feeds its stimulus through streams is thus
+// compiled once for the design and harness and reused for every batch of
+// vectors. Stimulus written into the testbench text is compiled in.
+//
+// Cache entries are executables, so the cache directory must be private to
+// the current user: it is created with mode 0700 and its ownership and mode,
+// and those of the cached binary, are checked before each run.
+//
+// Verilator is a two-state simulator: X and Z values are resolved to 0/1, so
+// testbenches which expect X values on outputs will fail under this simulator.
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "absl/flags/flag.h"
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "absl/status/status.h"
+#include "absl/status/statusor.h"
+#include "absl/strings/escaping.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_split.h"
+#include "absl/types/span.h"
+#include "xls/codegen/vast/vast.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/module_initializer.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/subprocess.h"
+#include "xls/simulation/verilog_include.h"
+#include "xls/simulation/verilog_simulator.h"
+#include "openssl/sha.h"
+
+ABSL_FLAG(std::string, verilator_cache_dir, "",
+          "Directory in which simulations compiled by Verilator are cached. "
+          "If empty, a per-user directory under the system temporary "
+          "directory is used. The directory must be owned by the current user "
+          "and inaccessible to others; it is created with mode 0700 if it "
+          "does not exist.");
+
+namespace xls {
+namespace verilog {
+namespace {
+
+// Name of the executable built by Verilator within the build directory.
+constexpr std::string_view kSimulationBinaryName = "simulation";
+
+// Returns the path of the `verilator` executable or std::nullopt if it cannot
+// be found. The `VERILATOR` environment variable takes precedence over PATH.
+std::optional<std::filesystem::path> FindVerilator() {
+  if (const char* verilator = std::getenv("VERILATOR");
+      verilator != nullptr && *verilator != '\0') {
+    return std::filesystem::path(verilator);
+  }
+  const char* path_env = std::getenv("PATH");
+  if (path_env == nullptr) {
+    return std::nullopt;
+  }
+  for (std::string_view dir : absl::StrSplit(path_env, ':')) {
+    if (dir.empty()) {
+      continue;
+    }
+    std::filesystem::path candidate = std::filesystem::path(dir) / "verilator";
+    absl::StatusOr<bool> is_executable = FileIsExecutable(candidate);
+    if (is_executable.ok() && *is_executable) {
+      return candidate;
+    }
+  }
+  return std::nullopt;
+}
+
+// Returns the output of `verilator --version`. The version is part of the cache
+// key so that upgrading Verilator invalidates previously compiled simulations.
+absl::StatusOr<std::string> GetVerilatorVersion(
+    const std::filesystem::path& verilator) {
+  XLS_ASSIGN_OR_RETURN(SubprocessResult result,
+                       SubprocessErrorAsStatus(InvokeSubprocess(
+                           {verilator.string(), "--version"})));
+  return result.stdout_content;
+}
+
+std::filesystem::path GetCacheDir() {
+  std::string flag = absl::GetFlag(FLAGS_verilator_cache_dir);
+  if (!flag.empty()) {
+    return flag;
+  }
+  return std::filesystem::temp_directory_path() /
+         absl::StrCat("xls_verilator_cache_", getuid());
+}
+
+// Returns an error unless `path` is a directory (or if `is_directory` is false,
+// a regular file) owned by the current user. Directories must not be
+// accessible to other users and files must not be writable by them. Symbolic
+// links are not followed.
+absl::Status CheckPrivate(const std::filesystem::path& path,
+                          bool is_directory) {
+  struct stat statbuf;
+  if (lstat(path.c_str(), &statbuf) != 0) {
+    return absl::NotFoundError(absl::StrFormat(
+        "Unable to stat %s: %s", path.string(), strerror(errno)));
+  }
+  bool right_type =
+      is_directory ? S_ISDIR(statbuf.st_mode) : S_ISREG(statbuf.st_mode);
+  mode_t disallowed = is_directory ? (S_IRWXG | S_IRWXO) : (S_IWGRP | S_IWOTH);
+  if (!right_type || statbuf.st_uid != getuid() ||
+      (statbuf.st_mode & disallowed) != 0) {
+    return absl::PermissionDeniedError(absl::StrFormat(
+        "Verilator cache path %s must be a %s owned by the current user "
+        "(uid %d) and not %s by other users (found uid %d, mode %o)",
+        path.string(), is_directory ? "directory" : "regular file", getuid(),
+        is_directory ? "accessible" : "writable", statbuf.st_uid,
+        statbuf.st_mode & 07777));
+  }
+  return absl::OkStatus();
+}
+
+// Creates the cache directory with mode 0700 if it does not exist and checks
+// that it is private to the current user.
+absl::Status CreatePrivateCacheDir(const std::filesystem::path& cache_dir) {
+  if (!FileExists(cache_dir).ok()) {
+    if (cache_dir.has_parent_path()) {
+      XLS_RETURN_IF_ERROR(RecursivelyCreateDir(cache_dir.parent_path()));
+    }
+    // Another process may create the directory concurrently.
+    if (mkdir(cache_dir.c_str(), S_IRWXU) != 0 && errno != EEXIST) {
+      return absl::InternalError(absl::StrFormat(
+          "Unable to create %s: %s", cache_dir.string(), strerror(errno)));
+    }
+  }
+  return CheckPrivate(cache_dir, /*is_directory=*/true);
+}
+
+// Returns true if the macro is defined as a plain string literal. Such macros
+// are bound at run time (see the comment at the top of the file).
+bool IsRunTimeMacro(const VerilogSimulator::MacroDefinition& macro) {
+  if (!macro.value.has_value()) {
+    return false;
+  }
+  std::string_view value = *macro.value;
+  return value.size() >= 2 && value.front() == '"' && value.back() == '"' &&
+         value.substr(1, value.size() - 2).find_first_of("\\\"") ==
+             std::string_view::npos;
+}
+
+// Name of the function which returns the run-time value of `macro_name`.
+std::string RunTimeMacroFunctionName(std::string_view macro_name) {
+  return absl::StrCat("__xls_plusarg_", macro_name);
+}
+
+// Returns SystemVerilog source defining, for each run-time macro, a function in
+// the compilation-unit scope which reads the macro's value from the plusarg of
+// the same name.
+std::string RunTimeMacroSource(
+    absl::Span<const VerilogSimulator::MacroDefinition> macro_definitions) {
+  std::string source;
+  for (const VerilogSimulator::MacroDefinition& macro : macro_definitions) {
+    if (!IsRunTimeMacro(macro)) {
+      continue;
+    }
+    absl::StrAppendFormat(&source, R"(function automatic string %s();
+  string value;
+  if (!$value$plusargs("%s=%%s", value)) begin
+    $display("FAILED: plusarg +%s is not set");
+    $finish;
+  end
+  return value;
+endfunction
+)",
+                          RunTimeMacroFunctionName(macro.name), macro.name,
+                          macro.name);
+  }
+  return source;
+}
+
+// Incrementally computes a hash identifying a compiled simulation. Each piece
+// of data is length-prefixed so that different sequences of strings cannot
+// produce the same hash.
+class CacheKeyBuilder {
+ public:
+  CacheKeyBuilder() { SHA256_Init(&ctx_); }
+
+  CacheKeyBuilder& Add(std::string_view data) {
+    uint64_t size = data.size();
+    SHA256_Update(&ctx_, &size, sizeof(size));
+    SHA256_Update(&ctx_, data.data(), data.size());
+    return *this;
+  }
+
+  std::string Finish() && {
+    std::array<char, SHA256_DIGEST_LENGTH> digest;
+    SHA256_Final(reinterpret_cast<uint8_t*>(digest.data()), &ctx_);
+    return absl::BytesToHexString({digest.data(), digest.size()});
+  }
+
+ private:
+  SHA256_CTX ctx_;
+};
+
+class VerilatorSimulator : public VerilogSimulator {
+ public:
+  VerilatorSimulator(std::filesystem::path verilator, std::string version)
+      : verilator_(std::move(verilator)), version_(std::move(version)) {}
+
+  absl::StatusOr<std::pair<std::string, std::string>> Run(
+      std::string_view text, FileType file_type,
+      absl::Span<const MacroDefinition> macro_definitions,
+      absl::Span<const VerilogInclude> includes) const override {
+    XLS_ASSIGN_OR_RETURN(
+        std::filesystem::path binary,
+        GetOrCompile(text, file_type, macro_definitions, includes));
+
+    std::vector<std::string> args = {binary.string()};
+    for (const MacroDefinition& macro : macro_definitions) {
+      if (IsRunTimeMacro(macro)) {
+        // Strip the quotes of the string literal.
+        args.push_back(absl::StrFormat(
+            "+%s=%s", macro.name,
+            std::string_view(*macro.value).substr(1, macro.value->size() - 2)));
+      }
+    }
+
+    // Run in a scratch directory as testbenches may write files relative to
+    // the working directory.
+    XLS_ASSIGN_OR_RETURN(TempDirectory run_dir, TempDirectory::Create());
+    return SubprocessResultToStrings(
+        SubprocessErrorAsStatus(InvokeSubprocess(args, run_dir.path())));
+  }
+
+  absl::Status RunSyntaxChecking(
+      std::string_view text, FileType file_type,
+      absl::Span<const MacroDefinition> macro_definitions,
+      absl::Span<const VerilogInclude> includes) const override {
+    XLS_ASSIGN_OR_RETURN(TempDirectory temp_dir, TempDirectory::Create());
+    XLS_ASSIGN_OR_RETURN(
+        std::filesystem::path top_path,
+        WriteSources(temp_dir.path(), text, file_type, includes));
+    std::vector<std::string> args = {verilator_.string(), "--lint-only",
+                                     "-Wno-fatal", "-Wno-lint", "-Wno-style"};
+    AppendCommonArgs(temp_dir.path(), macro_definitions, args);
+    args.push_back(top_path.string());
+    return SubprocessErrorAsStatus(InvokeSubprocess(args)).status();
+  }
+
+  bool DoesSupportSystemVerilog() const override { return true; }
+  bool DoesSupportAssertions() const override { return false; }
+
+ private:
+  // Writes the top-level source and includes into `dir`. Returns the path of
+  // the top-level source.
+  absl::StatusOr<std::filesystem::path> WriteSources(
+      const std::filesystem::path& dir, std::string_view text,
+      FileType file_type, absl::Span<const VerilogInclude> includes) const {
+    std::filesystem::path top_path = dir / GetTopFileName(file_type);
+    XLS_RETURN_IF_ERROR(SetFileContents(top_path, text));
+    for (const VerilogInclude& include : includes) {
+      std::filesystem::path path = dir / include.relative_path;
+      XLS_RETURN_IF_ERROR(RecursivelyCreateDir(path.parent_path()));
+      XLS_RETURN_IF_ERROR(SetFileContents(path, include.verilog_text));
+    }
+    return top_path;
+  }
+
+  static void AppendCommonArgs(
+      const std::filesystem::path& include_dir,
+      absl::Span<const MacroDefinition> macro_definitions,
+      std::vector<std::string>& args) {
+    args.push_back(absl::StrCat("-I", include_dir.string()));
+    args.push_back(absl::StrFormat("-D%s", kSimulationMacroName));
+    args.push_back(absl::StrFormat("-D%s", kAssertOnMacroName));
+    for (const MacroDefinition& macro : macro_definitions) {
+      if (macro.value.has_value()) {
+        args.push_back(absl::StrFormat("-D%s=%s", macro.name, *macro.value));
+      } else {
+        args.push_back(absl::StrFormat("-D%s", macro.name));
+      }
+    }
+  }
+
+  // Returns the path to the compiled simulation for the given sources,
+  // compiling it if it is not already in the cache.
+  absl::StatusOr<std::filesystem::path> GetOrCompile(
+      std::string_view text, FileType file_type,
+      absl::Span<const MacroDefinition> macro_definitions,
+      absl::Span<const VerilogInclude> includes) const {
+    CacheKeyBuilder key_builder;
+    key_builder.Add(verilator_.string())
+        .Add(version_)
+        .Add(GetTopFileName(file_type))
+        .Add(text);
+    // Run-time macros only contribute their names; the compiled simulation
+    // reads their values from plusargs.
+    std::vector<MacroDefinition> compiled_macros;
+    for (const MacroDefinition& macro : macro_definitions) {
+      if (IsRunTimeMacro(macro)) {
+        key_builder.Add(macro.name).Add("+").Add("");
+        compiled_macros.push_back(MacroDefinition{
+            .name = macro.name,
+            .value = absl::StrCat(RunTimeMacroFunctionName(macro.name), "()")});
+        continue;
+      }
+      key_builder.Add(macro.name)
+          .Add(macro.value.has_value() ? "=" : "")
+          .Add(macro.value.value_or(""));
+      compiled_macros.push_back(macro);
+    }
+    for (const VerilogInclude& include : includes) {
+      key_builder.Add(include.relative_path).Add(include.verilog_text);
+    }
+    std::string key = std::move(key_builder).Finish();
+
+    std::filesystem::path cache_dir = GetCacheDir();
+    XLS_RETURN_IF_ERROR(CreatePrivateCacheDir(cache_dir));
+    std::filesystem::path cached_dir = cache_dir / key;
+    std::filesystem::path cached_binary = cached_dir / kSimulationBinaryName;
+    // Never run a binary that another user could have placed or modified.
+    auto check_cached_binary = [&]() -> absl::Status {
+      XLS_RETURN_IF_ERROR(CheckPrivate(cached_dir, /*is_directory=*/true));
+      return CheckPrivate(cached_binary, /*is_directory=*/false);
+    };
+    if (FileExists(cached_binary).ok()) {
+      VLOG(1) << "Using cached Verilator simulation " << cached_binary;
+      XLS_RETURN_IF_ERROR(check_cached_binary());
+      return cached_binary;
+    }
+
+    // Build in a private directory and move it into place once complete so
+    // that concurrent users of the cache never observe a partial build.
+    XLS_ASSIGN_OR_RETURN(TempDirectory build_dir, TempDirectory::Create());
+    XLS_ASSIGN_OR_RETURN(
+        std::filesystem::path top_path,
+        WriteSources(build_dir.path(), text, file_type, includes));
+    std::string run_time_macro_source = RunTimeMacroSource(macro_definitions);
+    std::optional<std::filesystem::path> run_time_macro_path;
+    if (!run_time_macro_source.empty()) {
+      run_time_macro_path = build_dir.path() / "xls_run_time_macros.sv";
+      XLS_RETURN_IF_ERROR(
+          SetFileContents(*run_time_macro_path, run_time_macro_source));
+    }
+    std::vector<std::string> args = {
+        verilator_.string(),
+        "--binary",
+        "--timing",
+        "-j",
+        "0",
+        "-Wno-fatal",
+        "-Wno-lint",
+        "-Wno-style",
+        "--Mdir",
+        (build_dir.path() / "obj_dir").string(),
+        "-o",
+        std::string(kSimulationBinaryName)};
+    AppendCommonArgs(build_dir.path(), compiled_macros, args);
+    if (run_time_macro_path.has_value()) {
+      args.push_back(run_time_macro_path->string());
+    }
+    args.push_back(top_path.string());
+    VLOG(1) << "Compiling Verilator simulation into " << cached_dir;
+    XLS_RETURN_IF_ERROR(
+        SubprocessErrorAsStatus(InvokeSubprocess(args)).status());
+
+    // Verilator places the binary in the --Mdir directory. Only the binary is
+    // retained in the cache. The entry is staged within the cache directory so
+    // that it can be renamed into place atomically; a rename from the system
+    // temporary directory fails if the cache is on another filesystem.
+    XLS_ASSIGN_OR_RETURN(
+        TempDirectory staging_dir,
+        TempDirectory::CreateInDirectory(cache_dir, absl::StrCat(".", key)));
+    std::error_code ec;
+    std::filesystem::copy_file(
+        build_dir.path() / "obj_dir" / kSimulationBinaryName,
+        staging_dir.path() / kSimulationBinaryName, ec);
+    if (!ec) {
+      std::filesystem::permissions(staging_dir.path() / kSimulationBinaryName,
+                                   std::filesystem::perms::owner_all, ec);
+    }
+    if (ec) {
+      return absl::InternalError(absl::StrFormat(
+          "Unable to copy Verilator simulation binary: %s", ec.message()));
+    }
+    std::filesystem::rename(staging_dir.path(), cached_dir, ec);
+    if (ec && !FileExists(cached_binary).ok()) {
+      // The rename may fail because another process populated the cache first;
+      // that is only an error if the entry is still absent.
+      return absl::InternalError(absl::StrFormat(
+          "Unable to populate Verilator cache entry %s: %s",
+          cached_dir.string(), ec.message()));
+    }
+    if (!ec) {
+      std::move(staging_dir).Release();
+    }
+    XLS_RETURN_IF_ERROR(check_cached_binary());
+    return cached_binary;
+  }
+
+  std::filesystem::path verilator_;
+  std::string version_;
+};
+
+XLS_REGISTER_MODULE_INITIALIZER(verilator_simulator, {
+  CHECK_OK(GetVerilogSimulatorManagerSingleton().RegisterVerilogSimulator(
+      "verilator", []() -> absl::StatusOr<std::unique_ptr<VerilogSimulator>> {
+        std::optional<std::filesystem::path> verilator = FindVerilator();
+        if (!verilator.has_value()) {
+          return absl::UnavailableError(
+              "Verilator simulator requested but `verilator` was not found "
+              "in PATH (or the VERILATOR environment variable)");
+        }
+        XLS_ASSIGN_OR_RETURN(std::string version,
+                             GetVerilatorVersion(*verilator));
+        return std::make_unique<VerilatorSimulator>(*std::move(verilator),
+                                                    std::move(version));
+      }));
+});
+
+}  // namespace
+}  // namespace verilog
+}  // namespace xls
@@ -0,0 +1,295 @@
+// Copyright 2025 The XLS Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Tests of the caching of compiled simulations by the Verilator simulator.
+// Verilator itself is replaced by a fake script which records each compilation
+// and produces a trivial "simulation" binary.
+
+#include <stdlib.h>  // NOLINT (for setenv)
+
+#include <cstdint>
+#include <filesystem>  // NOLINT
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+#include "absl/algorithm/container.h"
+#include "absl/flags/declare.h"
+#include "absl/flags/flag.h"
+#include "absl/status/status.h"
+#include "absl/status/status_matchers.h"
+#include "absl/status/statusor.h"
+#include "xls/codegen/vast/vast.h"
+#include "xls/common/file/filesystem.h"
+#include "xls/common/file/temp_directory.h"
+#include "xls/common/status/matchers.h"
+#include "xls/common/status/status_macros.h"
+#include "xls/common/thread.h"
+#include "xls/simulation/verilog_simulator.h"
+
+ABSL_DECLARE_FLAG(std::string, verilator_cache_dir);
+
+namespace xls {
+namespace verilog {
+namespace {
+
+using ::absl_testing::IsOkAndHolds;
+using ::absl_testing::StatusIs;
+using ::testing::HasSubstr;
+using ::testing::IsEmpty;
+using ::testing::SizeIs;
+
+// A stand-in for `verilator`. `--version` prints the contents of the `version`
+// file next to the script. Otherwise it appends a line to `compile_log` and
+// writes a binary which prints "simulated" and its arguments to the requested
+// output path.
+constexpr std::string_view kFakeVerilator = R"(#!/bin/sh
+dir=$(dirname "$0")
+if [ "$1" = "--version" ]; then
+  cat "$dir/version"
+  exit 0
+fi
+while [ $# -gt 0 ]; do
+  case "$1" in
+    --Mdir) mdir="$2"; shift ;;
+    -o) out="$2"; shift ;;
+  esac
+  shift
+done
+echo compiled >> "$dir/compile_log"
+mkdir -p "$mdir"
+printf '#!/bin/sh\necho simulated "$@"\n' > "$mdir/$out"
+chmod +x "$mdir/$out"
+)";
+
+constexpr std::string_view kModule = "module top; endmodule\n";
+constexpr std::string_view kOtherModule = "module top; wire x; endmodule\n";
+
+class VerilatorSimulatorTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    XLS_ASSERT_OK_AND_ASSIGN(TempDirectory temp_dir, TempDirectory::Create());
+    temp_dir_.emplace(std::move(temp_dir));
+    std::filesystem::path verilator = temp_dir_->path() / "verilator";
+    XLS_ASSERT_OK(SetFileContents(verilator, kFakeVerilator));
+    std::filesystem::permissions(verilator, std::filesystem::perms::owner_all);
+    XLS_ASSERT_OK(SetVersion("Verilator 5.000"));
+    setenv("VERILATOR", verilator.c_str(), /*overwrite=*/1);
+    absl::SetFlag(&FLAGS_verilator_cache_dir, cache_dir().string());
+  }
+
+  void TearDown() override {
+    unsetenv("VERILATOR");
+    absl::SetFlag(&FLAGS_verilator_cache_dir, "");
+  }
+
+  std::filesystem::path cache_dir() const {
+    return temp_dir_->path() / "cache";
+  }
+
+  absl::Status SetVersion(std::string_view version) {
+    return SetFileContents(temp_dir_->path() / "version", version);
+  }
+
+  absl::StatusOr<std::unique_ptr<VerilogSimulator>> GetSimulator() const {
+    return GetVerilogSimulatorManagerSingleton().GetVerilogSimulator(
+        "verilator");
+  }
+
+  // Returns the number of times the fake Verilator compiled a simulation.
+  absl::StatusOr<int64_t> CompileCount() const {
+    std::filesystem::path log = temp_dir_->path() / "compile_log";
+    if (!FileExists(log).ok()) {
+      return 0;
+    }
+    XLS_ASSIGN_OR_RETURN(std::string contents, GetFileContents(log));
+    return absl::c_count(contents, '\n');
+  }
+
+  // Returns the names of the entries in the cache directory.
+  absl::StatusOr<std::vector<std::string>> CacheEntries() const {
+    XLS_ASSIGN_OR_RETURN(std::vector<std::filesystem::path> entries,
+                         GetDirectoryEntries(cache_dir()));
+    std::vector<std::string> names;
+    for (const std::filesystem::path& entry : entries) {
+      names.push_back(entry.filename().string());
+    }
+    return names;
+  }
+
+  std::optional<TempDirectory> temp_dir_;
+};
+
+TEST_F(VerilatorSimulatorTest, CacheMissCompilesAndCacheHitReusesBinary) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK_AND_ASSIGN(auto output,
+                           simulator->Run(kModule, FileType::kVerilog));
+  EXPECT_EQ(output.first, "simulated\n");
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(1));
+
+  XLS_ASSERT_OK_AND_ASSIGN(output, simulator->Run(kModule, FileType::kVerilog));
+  EXPECT_EQ(output.first, "simulated\n");
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(1));
+
+  // The cache is shared by simulator instances (and processes).
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> other_simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK_AND_ASSIGN(output,
+                           other_simulator->Run(kModule, FileType::kVerilog));
+  EXPECT_EQ(output.first, "simulated\n");
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(1));
+  EXPECT_THAT(CacheEntries(), IsOkAndHolds(SizeIs(1)));
+}
+
+TEST_F(VerilatorSimulatorTest, ChangedInputsAreCacheMisses) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK(simulator->Run(kModule, FileType::kVerilog).status());
+  XLS_ASSERT_OK(simulator->Run(kOtherModule, FileType::kVerilog).status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(2));
+
+  XLS_ASSERT_OK(simulator->Run(kModule, FileType::kSystemVerilog).status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(3));
+
+  XLS_ASSERT_OK(
+      simulator
+          ->Run(kModule, FileType::kVerilog,
+                {VerilogSimulator::MacroDefinition{.name = "FOO"}})
+          .status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(4));
+  EXPECT_THAT(CacheEntries(), IsOkAndHolds(SizeIs(4)));
+}
+
+TEST_F(VerilatorSimulatorTest, VerilatorVersionIsPartOfTheCacheKey) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK(simulator->Run(kModule, FileType::kVerilog).status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(1));
+
+  XLS_ASSERT_OK(SetVersion("Verilator 5.001"));
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> upgraded,
+                           GetSimulator());
+  XLS_ASSERT_OK(upgraded->Run(kModule, FileType::kVerilog).status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(2));
+}
+
+TEST_F(VerilatorSimulatorTest, ConcurrentPopulationOfTheSameEntry) {
+  constexpr int64_t kThreadCount = 8;
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  std::vector<absl::StatusOr<std::pair<std::string, std::string>>> outputs(
+      kThreadCount, absl::UnknownError("not run"));
+  std::vector<std::unique_ptr<Thread>> threads;
+  for (int64_t i = 0; i < kThreadCount; ++i) {
+    threads.push_back(std::make_unique<Thread>([&, i]() {
+      outputs[i] = simulator->Run(kModule, FileType::kVerilog);
+    }));
+  }
+  for (std::unique_ptr<Thread>& thread : threads) {
+    thread->Join();
+  }
+  for (const auto& output : outputs) {
+    XLS_ASSERT_OK(output.status());
+    EXPECT_EQ(output->first, "simulated\n");
+  }
+
+  // Every thread may have compiled the simulation but exactly one entry is
+  // left in the cache and no staging directories remain.
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<std::string> entries, CacheEntries());
+  ASSERT_THAT(entries, SizeIs(1));
+  EXPECT_NE(entries.front().front(), '.');
+  EXPECT_THAT(GetDirectoryEntries(cache_dir() / entries.front()),
+              IsOkAndHolds(SizeIs(1)));
+}
+
+TEST_F(VerilatorSimulatorTest, CacheIsNotPopulatedOnCompileFailure) {
+  std::filesystem::path verilator = temp_dir_->path() / "verilator";
+  XLS_ASSERT_OK(SetFileContents(
+      verilator, "#!/bin/sh\n[ \"$1\" = \"--version\" ] && exit 0\nexit 1\n"));
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  EXPECT_FALSE(simulator->Run(kModule, FileType::kVerilog).ok());
+  EXPECT_THAT(CacheEntries(), IsOkAndHolds(IsEmpty()));
+}
+
+TEST_F(VerilatorSimulatorTest, StringMacrosAreBoundAtRunTime) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  // Streaming testbenches differ between runs only in the paths of their
+  // named pipes, which must not force a recompile.
+  XLS_ASSERT_OK_AND_ASSIGN(
+      auto output,
+      simulator->Run(kModule, FileType::kVerilog,
+                     {VerilogSimulator::MacroDefinition{
+                         .name = "__IN_PIPE_PATH", .value = "\"/tmp/a/in\""}}));
+  EXPECT_EQ(output.first, "simulated +__IN_PIPE_PATH=/tmp/a/in\n");
+  XLS_ASSERT_OK_AND_ASSIGN(
+      output,
+      simulator->Run(kModule, FileType::kVerilog,
+                     {VerilogSimulator::MacroDefinition{
+                         .name = "__IN_PIPE_PATH", .value = "\"/tmp/b/in\""}}));
+  EXPECT_EQ(output.first, "simulated +__IN_PIPE_PATH=/tmp/b/in\n");
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(1));
+
+  // Other values are compiled in.
+  XLS_ASSERT_OK(simulator
+                    ->Run(kModule, FileType::kVerilog,
+                          {VerilogSimulator::MacroDefinition{
+                              .name = "__IN_PIPE_PATH", .value = "42"}})
+                    .status());
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(2));
+}
+
+TEST_F(VerilatorSimulatorTest, CacheDirectoryIsPrivate) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK(simulator->Run(kModule, FileType::kVerilog).status());
+  EXPECT_EQ(std::filesystem::status(cache_dir()).permissions(),
+            std::filesystem::perms::owner_all);
+}
+
+TEST_F(VerilatorSimulatorTest, CachedBinaryWritableByOthersIsNotRun) {
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  XLS_ASSERT_OK(simulator->Run(kModule, FileType::kVerilog).status());
+  XLS_ASSERT_OK_AND_ASSIGN(std::vector<std::string> entries, CacheEntries());
+  ASSERT_THAT(entries, SizeIs(1));
+  std::filesystem::path binary = cache_dir() / entries.front() / "simulation";
+  std::filesystem::permissions(binary, std::filesystem::perms::others_write,
+                               std::filesystem::perm_options::add);
+  EXPECT_THAT(simulator->Run(kModule, FileType::kVerilog),
+              StatusIs(absl::StatusCode::kPermissionDenied,
+                       HasSubstr("not writable by other users")));
+}
+
+TEST_F(VerilatorSimulatorTest, SharedCacheDirectoryIsRejected) {
+  XLS_ASSERT_OK(RecursivelyCreateDir(cache_dir()));
+  std::filesystem::permissions(cache_dir(), std::filesystem::perms::all);
+  XLS_ASSERT_OK_AND_ASSIGN(std::unique_ptr<VerilogSimulator> simulator,
+                           GetSimulator());
+  EXPECT_THAT(simulator->Run(kModule, FileType::kVerilog),
+              StatusIs(absl::StatusCode::kPermissionDenied,
+                       HasSubstr("not accessible by other users")));
+  EXPECT_THAT(CompileCount(), IsOkAndHolds(0));
+}
+
+}  // namespace
+}  // namespace verilog
+}  // namespace xls
@@ -13,7 +13,6 @@
 // limitations under the License.
 
 #include <cstdint>
-#include <iostream>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -25,6 +24,7 @@
 #include "absl/status/status.h"
 #include "absl/strings/str_format.h"
 #include "xls/codegen/codegen_result.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/common/exit_status.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
@@ -55,10 +55,18 @@ absl::Status RealMain(std::string_view ir_path) {
   XLS_ASSIGN_OR_RETURN(CodegenFlagsProto codegen_flags_proto,
                        GetCodegenFlags());
 
-  XLS_ASSIGN_OR_RETURN(verilog::CodegenResult codegen_result,
-                       BlockToVerilog(p.get(), codegen_flags_proto));
-
+  // The Verilog is written to its destination as it is generated rather than
+  // being held in memory in its entirety.
   std::string verilog_path = absl::GetFlag(FLAGS_output_verilog_path);
+  XLS_ASSIGN_OR_RETURN(
+      verilog::CodegenResult codegen_result,
+      GenerateVerilogToPath(verilog_path,
+                            [&](verilog::VastSink* verilog_sink) {
+                              return BlockToVerilog(p.get(),
+                                                    codegen_flags_proto,
+                                                    verilog_sink);
+                            }));
+
   if (!verilog_path.empty()) {
     for (int64_t i = 0; i < codegen_result.verilog_line_map.mapping_size();
          ++i) {
@@ -86,13 +94,6 @@ absl::Status RealMain(std::string_view ir_path) {
         SetTextProtoFile(absl::GetFlag(FLAGS_output_residual_data_path),
                          codegen_result.residual_data));
   }
-
-  if (verilog_path.empty()) {
-    std::cout << codegen_result.verilog_text;
-  } else {
-    XLS_RETURN_IF_ERROR(
-        SetFileContents(verilog_path, codegen_result.verilog_text));
-  }
   return absl::OkStatus();
 }
 
@@ -14,13 +14,19 @@
 
 #include "xls/tools/codegen.h"
 
+#include <filesystem>  // NOLINT
+#include <fstream>
+#include <ios>
+#include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <system_error>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "absl/functional/function_ref.h"
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
@@ -37,8 +43,10 @@
 #include "xls/codegen/pipeline_generator.h"
 #include "xls/codegen/ram_configuration.h"
 #include "xls/codegen/unified_generator.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/codegen/verilog_line_map.pb.h"
 #include "xls/codegen/xls_metrics.pb.h"
+#include "xls/common/file/temp_file.h"
 #include "xls/common/status/ret_check.h"
 #include "xls/common/status/status_macros.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
@@ -176,41 +184,43 @@ absl::StatusOr<PackageSchedule> DeterminePipelineSchedules(
 absl::StatusOr<verilog::CodegenResult> CodegenPipeline(
     Package* p, const PackageSchedule& package_schedule,
     const verilog::CodegenOptions& codegen_options,
-    const DelayEstimator* delay_estimator) {
+    const DelayEstimator* delay_estimator, verilog::VastSink* verilog_sink) {
   XLS_RETURN_IF_ERROR(VerifyPackage(p, /*codegen=*/true));
 
   if (package_schedule.GetSchedules().size() == 1) {
     const PipelineSchedule& schedule =
         package_schedule.GetSchedule(*p->GetTop());
     return verilog::ToPipelineModuleText(schedule, *p->GetTop(),
-                                         codegen_options, delay_estimator);
+                                         codegen_options, delay_estimator,
+                                         verilog_sink);
   }
   return verilog::ToPipelineModuleText(package_schedule, p, codegen_options,
-                                       delay_estimator);
+                                       delay_estimator, verilog_sink);
 }
 
 absl::StatusOr<verilog::CodegenResult> CodegenCombinational(
     Package* p, const verilog::CodegenOptions& codegen_options,
-    const DelayEstimator* delay_estimator) {
+    const DelayEstimator* delay_estimator, verilog::VastSink* verilog_sink) {
   return verilog::GenerateCombinationalModule(*p->GetTop(), codegen_options,
-                                              delay_estimator);
+                                              delay_estimator, verilog_sink);
 }
 
 absl::StatusOr<verilog::CodegenResult> CodegenFromMetadata(
     Package* p, GeneratorKind generator_kind, const CodegenMetadata& metadata,
-    const PackageSchedule* package_schedule) {
+    const PackageSchedule* package_schedule,
+    verilog::VastSink* verilog_sink = nullptr) {
   if (metadata.codegen_options.codegen_version() ==
           verilog::CodegenOptions::Version::kOneDotZero ||
       metadata.codegen_options.codegen_version() ==
           verilog::CodegenOptions::Version::kDefault) {
     if (generator_kind == GENERATOR_KIND_COMBINATIONAL) {
       return CodegenCombinational(p, metadata.codegen_options,
-                                  metadata.delay_estimator);
+                                  metadata.delay_estimator, verilog_sink);
     }
     XLS_RET_CHECK_EQ(generator_kind, GENERATOR_KIND_PIPELINE);
     XLS_RET_CHECK(package_schedule != nullptr);
     return CodegenPipeline(p, *package_schedule, metadata.codegen_options,
-                           metadata.delay_estimator);
+                           metadata.delay_estimator, verilog_sink);
   }
 
   // Codegen 2.0.
@@ -225,7 +235,7 @@ absl::StatusOr<verilog::CodegenResult> CodegenFromMetadata(
 
   return verilog::GenerateModuleText(package_schedule_2, p,
                                      metadata.codegen_options,
-                                     metadata.delay_estimator);
+                                     metadata.delay_estimator, verilog_sink);
 }
 
 verilog::CodegenOptions::IOKind ToIOKind(IOKindProto p) {
@@ -416,6 +426,10 @@ absl::StatusOr<verilog::CodegenOptions> CodegenOptionsFromProto(
       return absl::InvalidArgumentError(absl::StrFormat(
           "Unknown merge strategy: %v", p.register_merge_strategy()));
   }
+  options.retime_registers(p.retime_registers());
+  if (p.has_codegen_threads()) {
+    options.codegen_threads(p.codegen_threads());
+  }
 
   if (!p.randomize_order_seed().empty()) {
     options.randomize_order_seed(p.randomize_order_seed());
@@ -459,14 +473,14 @@ absl::StatusOr<verilog::CodegenResult> Codegen(
     Package* p,
     const SchedulingOptionsFlagsProto& scheduling_options_flags_proto,
     const CodegenFlagsProto& codegen_flags_proto, bool with_delay_model,
-    const PackageSchedule* package_schedule) {
+    const PackageSchedule* package_schedule, verilog::VastSink* verilog_sink) {
   XLS_RETURN_IF_ERROR(MaybeSetTop(p, codegen_flags_proto));
   XLS_ASSIGN_OR_RETURN(
       CodegenMetadata metadata,
       CodegenMetadata::Create(p, scheduling_options_flags_proto,
                               codegen_flags_proto, with_delay_model));
   return CodegenFromMetadata(p, codegen_flags_proto.generator(), metadata,
-                             package_schedule);
+                             package_schedule, verilog_sink);
 }
 
 absl::StatusOr<std::pair<SchedulingResult, verilog::CodegenResult>>
@@ -497,7 +511,8 @@ ScheduleAndCodegen(
 }
 
 absl::StatusOr<verilog::CodegenResult> BlockToVerilog(
-    Package* p, const CodegenFlagsProto& codegen_flags_proto) {
+    Package* p, const CodegenFlagsProto& codegen_flags_proto,
+    verilog::VastSink* verilog_sink) {
   XLS_RETURN_IF_ERROR(MaybeSetTop(p, codegen_flags_proto));
   XLS_ASSIGN_OR_RETURN(verilog::CodegenOptions options,
                        CodegenOptionsFromProto(codegen_flags_proto));
@@ -515,10 +530,10 @@ absl::StatusOr<verilog::CodegenResult> BlockToVerilog(
 
   verilog::VerilogLineMap verilog_line_map;
   verilog::CodegenResidualData residual_data;
-  XLS_ASSIGN_OR_RETURN(
-      std::string verilog,
-      verilog::GenerateVerilog(top_block, options, &verilog_line_map,
-                               &residual_data));
+  verilog::StringVastSink string_sink;
+  XLS_RETURN_IF_ERROR(verilog::GenerateVerilog(
+      top_block, options, verilog_sink != nullptr ? *verilog_sink : string_sink,
+      &verilog_line_map, &residual_data));
 
   verilog::ModuleSignature signature;
   if (top_block->GetSignature().has_value()) {
@@ -531,11 +546,64 @@ absl::StatusOr<verilog::CodegenResult> BlockToVerilog(
       *metrics.mutable_block_metrics(),
       verilog::GenerateBlockMetrics(top_block, /*delay_estimator=*/nullptr));
 
-  return verilog::CodegenResult{.verilog_text = std::move(verilog),
-                                .verilog_line_map = std::move(verilog_line_map),
-                                .signature = std::move(signature),
-                                .block_metrics = std::move(metrics),
-                                .residual_data = std::move(residual_data)};
+  return verilog::CodegenResult{
+      .verilog_text = std::move(string_sink).Release(),
+      .verilog_line_map = std::move(verilog_line_map),
+      .signature = std::move(signature),
+      .block_metrics = std::move(metrics),
+      .residual_data = std::move(residual_data)};
+}
+
+absl::StatusOr<verilog::CodegenResult> GenerateVerilogToPath(
+    std::string_view verilog_path,
+    absl::FunctionRef<absl::StatusOr<verilog::CodegenResult>(
+        verilog::VastSink*)>
+        generate) {
+  if (verilog_path.empty()) {
+    verilog::OstreamVastSink sink(std::cout);
+    return generate(&sink);
+  }
+  std::filesystem::path path(verilog_path);
+  std::error_code ec;
+  std::filesystem::file_status status = std::filesystem::status(path, ec);
+  if (std::filesystem::exists(status) &&
+      !std::filesystem::is_regular_file(status)) {
+    // Devices such as /dev/stdout cannot be replaced by a rename.
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open()) {
+      return absl::InternalError(
+          absl::StrFormat("Unable to open %s for writing", verilog_path));
+    }
+    verilog::OstreamVastSink sink(file);
+    return generate(&sink);
+  }
+
+  std::filesystem::path directory = path.parent_path();
+  XLS_ASSIGN_OR_RETURN(
+      TempFile temp_file,
+      TempFile::CreateInDirectory(directory.empty() ? "." : directory,
+                                  ".v.tmp"));
+  std::ofstream file(temp_file.path(), std::ios::out | std::ios::trunc);
+  if (!file.is_open()) {
+    return absl::InternalError(absl::StrFormat(
+        "Unable to open %s for writing", temp_file.path().string()));
+  }
+  verilog::OstreamVastSink sink(file);
+  // On error `temp_file` removes the partial output when it goes out of scope.
+  XLS_ASSIGN_OR_RETURN(verilog::CodegenResult result, generate(&sink));
+  file.close();
+  if (file.fail()) {
+    return absl::InternalError(
+        absl::StrFormat("Failed to write Verilog to %s", verilog_path));
+  }
+  std::filesystem::rename(temp_file.path(), path, ec);
+  if (ec) {
+    return absl::InternalError(absl::StrFormat(
+        "Unable to rename %s to %s: %s", temp_file.path().string(),
+        verilog_path, ec.message()));
+  }
+  std::move(temp_file).Release();
+  return result;
 }
 
 }  // namespace xls
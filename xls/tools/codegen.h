@@ -12,11 +12,14 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <string_view>
 #include <utility>
 
+#include "absl/functional/function_ref.h"
 #include "absl/status/statusor.h"
 #include "xls/codegen/codegen_options.h"
 #include "xls/codegen/codegen_result.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/estimators/delay_model/delay_estimator.h"
 #include "xls/ir/package.h"
 #include "xls/scheduling/pipeline_schedule.h"
@@ -49,7 +52,8 @@ absl::StatusOr<verilog::CodegenResult> Codegen(
     Package* p,
     const SchedulingOptionsFlagsProto& scheduling_options_flags_proto,
     const CodegenFlagsProto& codegen_flags_proto, bool with_delay_model,
-    const PackageSchedule* package_schedule);
+    const PackageSchedule* package_schedule,
+    verilog::VastSink* verilog_sink = nullptr);
 absl::StatusOr<std::pair<SchedulingResult, verilog::CodegenResult>>
 ScheduleAndCodegen(
     Package* p,
@@ -58,7 +62,19 @@ ScheduleAndCodegen(
 
 // Convert block IR to Verilog.
 absl::StatusOr<verilog::CodegenResult> BlockToVerilog(
-    Package* p, const CodegenFlagsProto& codegen_flags_proto);
+    Package* p, const CodegenFlagsProto& codegen_flags_proto,
+    verilog::VastSink* verilog_sink = nullptr);
+
+// Calls `generate` with a sink which streams the Verilog it emits to
+// `verilog_path`, or to stdout if `verilog_path` is empty. A regular file is
+// written through a temporary file in the same directory which only replaces
+// `verilog_path` once `generate` succeeds, so an error leaves any existing
+// file untouched.
+absl::StatusOr<verilog::CodegenResult> GenerateVerilogToPath(
+    std::string_view verilog_path,
+    absl::FunctionRef<absl::StatusOr<verilog::CodegenResult>(
+        verilog::VastSink*)>
+        generate);
 
 }  // namespace xls
 
@@ -181,6 +181,16 @@ ABSL_FLAG(std::optional<std::string>, codegen_options_used_textproto_file,
 ABSL_FLAG(std::string, register_merge_strategy, "IdentityOnly",
           "What strategy to use for merging registers. Options are "
           "'IdentityOnly' and, 'DontMerge'/'None'.");
+ABSL_FLAG(bool, retime_registers, false,
+          "If true, retime pipeline registers across logic to reduce the "
+          "number of register bits. Registers are only moved when the move "
+          "does not lengthen the critical path according to the delay model.");
+ABSL_FLAG(int64_t, codegen_threads, 1,
+          "Number of threads used to emit the Verilog of the blocks of the "
+          "design in parallel. Only emission is parallel; scheduling and the "
+          "codegen passes run serially. One emits the blocks serially and zero "
+          "uses one thread per available CPU. The output does not depend on "
+          "this value.");
 ABSL_FLAG(bool, emit_sv_types, true,
           "Should types annotated with #[sv_type(NAME)] be emitted into "
           "verilog as NAME.");
@@ -386,6 +396,8 @@ static absl::StatusOr<bool> SetOptionsFromFlags(CodegenFlagsProto& proto) {
       MergeStrategyFromString(absl::GetFlag(FLAGS_register_merge_strategy)));
   any_flags_set |= FLAGS_register_merge_strategy.IsSpecifiedOnCommandLine();
   proto.set_register_merge_strategy(merge_strategy);
+  POPULATE_FLAG(retime_registers);
+  POPULATE_FLAG(codegen_threads);
 
   // Misc
   if (FLAGS_randomize_order_seed.IsSpecifiedOnCommandLine()) {
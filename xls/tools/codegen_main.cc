@@ -13,7 +13,6 @@
 // limitations under the License.
 #include <cstdint>
 #include <filesystem>
-#include <iostream>
 #include <memory>
 #include <optional>
 #include <string>
@@ -24,9 +23,11 @@
 #include "absl/log/check.h"
 #include "absl/log/log.h"
 #include "absl/status/status.h"
+#include "absl/status/statusor.h"
 #include "absl/strings/str_format.h"
 #include "xls/codegen/codegen_result.h"
 #include "xls/codegen/module_signature.h"
+#include "xls/codegen/vast/vast.h"
 #include "xls/common/exit_status.h"
 #include "xls/common/file/filesystem.h"
 #include "xls/common/init_xls.h"
@@ -119,10 +120,19 @@ absl::Status RealMain(std::string_view ir_path) {
         scheduling_result.pass_pipeline_metrics));
   }
 
+  // The Verilog is written to its destination as it is generated rather than
+  // being held in memory in its entirety.
+  const std::string& verilog_path = absl::GetFlag(FLAGS_output_verilog_path);
   XLS_ASSIGN_OR_RETURN(
       verilog::CodegenResult codegen_result,
-      Codegen(p.get(), scheduling_options_flags_proto, codegen_flags_proto,
-              delay_model_flag_passed, &schedules));
+      GenerateVerilogToPath(
+          verilog_path,
+          [&](verilog::VastSink* verilog_sink)
+              -> absl::StatusOr<verilog::CodegenResult> {
+            return Codegen(p.get(), scheduling_options_flags_proto,
+                           codegen_flags_proto, delay_model_flag_passed,
+                           &schedules, verilog_sink);
+          }));
 
   if (!absl::GetFlag(FLAGS_output_block_ir_path).empty()) {
     QCHECK_GE(p->blocks().size(), 1)
@@ -155,7 +165,6 @@ absl::Status RealMain(std::string_view ir_path) {
                          codegen_result.residual_data));
   }
 
-  const std::string& verilog_path = absl::GetFlag(FLAGS_output_verilog_path);
   if (!verilog_path.empty()) {
     for (int64_t i = 0; i < codegen_result.verilog_line_map.mapping_size();
          ++i) {
@@ -170,13 +179,6 @@ absl::Status RealMain(std::string_view ir_path) {
     XLS_RETURN_IF_ERROR(SetTextProtoFile(verilog_line_map_path,
                                          codegen_result.verilog_line_map));
   }
-
-  if (verilog_path.empty()) {
-    std::cout << codegen_result.verilog_text;
-  } else {
-    XLS_RETURN_IF_ERROR(
-        SetFileContents(verilog_path, codegen_result.verilog_text));
-  }
   return absl::OkStatus();
 }
 
@@ -417,6 +417,30 @@ class CodeGenMainTest(parameterized.TestCase):
     ]).decode('utf-8')
     self._compare_to_golden(verilog)
 
+  def test_failed_codegen_leaves_existing_verilog(self):
+    ir_file = self.create_tempfile(content=GATE_IR)
+    output_dir = self.create_tempdir()
+    verilog_file = output_dir.create_file(
+        'out.v', content='// previous output\n'
+    )
+    result = subprocess.run(
+        [
+            CODEGEN_MAIN_PATH,
+            '--generator=combinational',
+            '--top=gate_example',
+            '--gate_format=assign {output} = {bogus}',
+            '--output_verilog_path=' + verilog_file.full_path,
+            ir_file.full_path,
+        ],
+        stderr=subprocess.PIPE,
+        check=False,
+    )
+    self.assertNotEqual(result.returncode, 0)
+    self.assertIn('Invalid placeholder {bogus}', result.stderr.decode('utf-8'))
+    self.assertEqual(verilog_file.read_text(), '// previous output\n')
+    # The partially written temporary file is cleaned up.
+    self.assertEqual(os.listdir(output_dir.full_path), ['out.v'])
+
   def test_flop_inputs(self):
     ir_file = self.create_tempfile(content=NOT_ADD_IR)
     verilog = subprocess.check_output([
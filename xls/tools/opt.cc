@@ -45,6 +45,14 @@
 
 namespace xls::tools {
 
+OptOptions OptMainDefaultOptions() {
+  return OptOptions{
+      .split_next_value_selects = kOptMainSplitNextValueSelects,
+      .area_model = std::string(kOptMainAreaModel),
+      .delay_model = std::string(kOptMainDelayModel),
+  };
+}
+
 absl::StatusOr<OptOptions> OptOptionsFromFlagsProto(
     const OptFlagsProto& proto) {
   OptOptions options;
@@ -136,11 +144,9 @@ absl::Status OptimizeIrForTop(Package* package, const OptOptions& options,
     XLS_ASSIGN_OR_RETURN(std::unique_ptr<OptimizationCompoundPass> res,
                          GetOptimizationPipelineGenerator(chosen_registry)
                              .GeneratePipeline(*options.pass_pipeline));
+    AddVerifierCheckers(*res, options.debug_optimizations);
     if (options.debug_optimizations) {
-      res->AddInvariantChecker<VerifierChecker>();
       res->AddInvariantChecker<QueryEngineChecker>();
-    } else {
-      res->AddWeakInvariantChecker<VerifierChecker>();
     }
     pipeline = std::move(res);
   } else {
@@ -60,6 +60,15 @@ struct OptOptions {
 
 absl::StatusOr<OptOptions> OptOptionsFromFlagsProto(const OptFlagsProto& proto);
 
+// Defaults of the `opt_main` flags which differ from those of OptOptions.
+inline constexpr int64_t kOptMainSplitNextValueSelects = 4;
+inline constexpr std::string_view kOptMainAreaModel = "asap7";
+inline constexpr std::string_view kOptMainDelayModel = "asap7";
+
+// Returns the options `opt_main` optimizes with when given no flags, for tools
+// which run the optimizer in-process in its place.
+OptOptions OptMainDefaultOptions();
+
 // Metadata which can be optionally returned from
 // the optimizer.
 struct OptMetadata {
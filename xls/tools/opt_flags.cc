@@ -37,6 +37,7 @@
 #include "xls/passes/pass_pipeline.pb.h"
 #include "xls/passes/query_engine_checker.h"
 #include "xls/passes/verifier_checker.h"
+#include "xls/tools/opt.h"
 #include "xls/tools/opt_flags.pb.h"
 
 // LINT.IfChange
@@ -52,7 +53,8 @@ ABSL_FLAG(std::optional<int64_t>, convert_array_index_to_select, std::nullopt,
           "into chains of selects. Otherwise, this optimization is skipped, "
           "since it can sometimes reduce output quality.");
 ABSL_FLAG(
-    std::optional<int64_t>, split_next_value_selects, 4,
+    std::optional<int64_t>, split_next_value_selects,
+    xls::tools::kOptMainSplitNextValueSelects,
     "If positive, split `next_value`s that assign `sel`s to state params if "
     "they have fewer than the given number of cases. This optimization is "
     "skipped for selects with more cases, since it can sometimes reduce output "
@@ -80,10 +82,10 @@ ABSL_FLAG(bool, force_resource_sharing, false,
           "it is legal to do so, overriding therefore the profitability "
           "heuristic of such pass. This option is only used when the resource "
           "sharing pass is enabled.");
-ABSL_FLAG(std::string, area_model, "asap7",
+ABSL_FLAG(std::string, area_model, std::string(xls::tools::kOptMainAreaModel),
           "Area model to use for optimizations.");
 ABSL_FLAG(
-    std::string, delay_model, "asap7",
+    std::string, delay_model, std::string(xls::tools::kOptMainDelayModel),
     "Delay model to use for optimizations benefiting from timing information.");
 ABSL_FLAG(
     std::optional<std::string>, passes, std::nullopt,
@@ -156,11 +158,9 @@ absl::Status PopulatePassPipelineProtoFromPassList(std::string_view list,
   XLS_ASSIGN_OR_RETURN(
       std::unique_ptr<OptimizationCompoundPass> res,
       GetOptimizationPipelineGenerator(chosen_registry).GeneratePipeline(list));
+  AddVerifierCheckers(*res, proto.debug_optimizations());
   if (proto.debug_optimizations()) {
-    res->AddInvariantChecker<VerifierChecker>();
     res->AddInvariantChecker<QueryEngineChecker>();
-  } else {
-    res->AddWeakInvariantChecker<VerifierChecker>();
   }
   PassPipelineProto::Element pipeline_proto;
 
@@ -129,6 +129,15 @@ ABSL_FLAG(
     "(assuming that all data-dependent feedback paths are equally likely) to "
     "be worth adding up to 1024 flops. Only relevant if using the SDC "
     "scheduler with --worst_case_throughput set to a value != 1.");
+ABSL_FLAG(std::string, area_objective_model, "",
+          "If set, the SDC scheduler minimizes the estimated area of the "
+          "pipeline registers (and of data held in flight on channels between "
+          "synchronous procs) using this area model, rather than only their "
+          "bit count. e.g., `asap7`.");
+ABSL_FLAG(double, area_objective_weight, 1.0,
+          "Weight of the area terms (in square microns) relative to the "
+          "register bit-count terms in the scheduling objective. Only relevant "
+          "if --area_objective_model is set. Must be >= 0.0.");
 ABSL_FLAG(int64_t, additional_input_delay_ps, 0,
           "The additional delay added to each input.");
 ABSL_FLAG(int64_t, additional_output_delay_ps, 0,
@@ -264,6 +273,8 @@ static absl::StatusOr<bool> SetOptionsFromFlags(
           *absl::GetFlag(FLAGS_dynamic_throughput_objective_weight));
     }
   }
+  POPULATE_FLAG(area_objective_model);
+  POPULATE_FLAG(area_objective_weight);
   POPULATE_FLAG(additional_input_delay_ps);
   POPULATE_FLAG(additional_output_delay_ps);
   {